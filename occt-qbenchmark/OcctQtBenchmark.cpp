@@ -0,0 +1,407 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifdef _WIN32
+  // should be included before other headers to avoid missing definitions
+  #include <windows.h>
+#endif
+#include <OpenGl_Context.hxx>
+
+#include "OcctQtBenchmark.h"
+
+#include "../occt-qopenglwidget/OcctQOpenGLWidgetViewer.h"
+#include "../occt-qwidget/OcctQWidgetViewer.h"
+#include "../occt-qt-tools/OcctGlTools.h"
+#include "../occt-qt-tools/OcctTessellator.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QWindow>
+#include <Standard_WarningsRestore.hxx>
+
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <OSD_MemInfo.hxx>
+#include <OSD_Timer.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace
+{
+  //! Scripted camera paths.
+  static const char* THE_CAMERA_PATHS[] = { "orbit", "tilt", "zoom", "pan" };
+
+  //! Generate grid of boxes or spheres.
+  static std::vector<TopoDS_Shape> generateScene(const OcctQtBenchmark::Options& theOpts)
+  {
+    std::vector<TopoDS_Shape> aParts;
+    aParts.reserve(size_t(Max(theOpts.NbObjects, 0)));
+    const int aGridSize = Max(1, int(std::ceil(std::cbrt(double(theOpts.NbObjects)))));
+    for (int anObjIter = 0; anObjIter < theOpts.NbObjects; ++anObjIter)
+    {
+      const gp_Pnt aCorner(2.0 * (anObjIter % aGridSize),
+                           2.0 * ((anObjIter / aGridSize) % aGridSize),
+                           2.0 * (anObjIter / (aGridSize * aGridSize)));
+      if (theOpts.Scene == "spheres")
+        aParts.push_back(BRepPrimAPI_MakeSphere(aCorner.Translated(gp_Vec(0.5, 0.5, 0.5)), 0.5).Shape());
+      else
+        aParts.push_back(BRepPrimAPI_MakeBox(aCorner, 1.0, 1.0, 1.0).Shape());
+    }
+    return aParts;
+  }
+
+  //! Setup camera for specified phase of the path.
+  //! @param[in] thePath   camera path name
+  //! @param[in] theInit   initial camera
+  //! @param[in] theCam    camera to modify
+  //! @param[in] thePhase  path phase within [0, 1) range
+  static void applyCameraPath(const QString& thePath,
+                              const Handle(Graphic3d_Camera)& theInit,
+                              const Handle(Graphic3d_Camera)& theCam,
+                              double thePhase)
+  {
+    theCam->Copy(theInit);
+    const gp_Dir aSide = theInit->Direction().Crossed(theInit->Up());
+    gp_Trsf aTrsf;
+    if (thePath == "orbit")
+    {
+      // full turn around vertical axis
+      aTrsf.SetRotation(gp_Ax1(theInit->Center(), theInit->Up()), 2.0 * M_PI * thePhase);
+      theCam->Transform(aTrsf);
+    }
+    else if (thePath == "tilt")
+    {
+      // swing up and down by 45 degrees
+      aTrsf.SetRotation(gp_Ax1(theInit->Center(), aSide), 0.25 * M_PI * Sin(2.0 * M_PI * thePhase));
+      theCam->Transform(aTrsf);
+    }
+    else if (thePath == "zoom")
+    {
+      // zoom in 10 times and back
+      theCam->SetScale(theInit->Scale() * Pow(0.1, Sin(M_PI * thePhase)));
+    }
+    else if (thePath == "pan")
+    {
+      // move sideways by half of view width and back
+      aTrsf.SetTranslation(gp_Vec(aSide) * (0.5 * theInit->ViewDimensions().X() * Sin(2.0 * M_PI * thePhase)));
+      theCam->Transform(aTrsf);
+    }
+  }
+
+  //! Wait until GPU finishes rendering, if OCCT OpenGL context is still bound.
+  static void finishGl(const Handle(V3d_View)& theView)
+  {
+    Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+    if (!aGlCtx.IsNull() && aGlCtx->IsCurrent())
+      aGlCtx->core11fwd->glFinish();
+  }
+
+  //! Return free GPU memory in bytes reported by driver (NVIDIA, AMD), or -1 if unknown.
+  static qint64 availableGpuMemory(const Handle(V3d_View)& theView)
+  {
+    Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+    if (aGlCtx.IsNull()
+     || (!aGlCtx->IsCurrent() && !aGlCtx->MakeCurrent()))
+    {
+      return -1;
+    }
+
+    const Standard_Size aFreeBytes = aGlCtx->AvailableMemory();
+    return aFreeBytes != 0 ? qint64(aFreeBytes) : -1;
+  }
+
+  //! Return number of frames rendered by the viewer.
+  static uint64_t nbRenderedFrames(const OcctFrameTimings& theTimings)
+  {
+    OcctFrameTimings::Record aRecord;
+    return theTimings.LastRecord(aRecord) ? aRecord.FrameIndex + 1 : 0;
+  }
+
+  //! Process GUI events until the viewer rendering on OCCT thread presents a new frame.
+  //! @param[in] theViewer        viewer
+  //! @param[in] theNbFramesOld  number of frames rendered before request
+  //! @return time spent by GUI thread processing events in seconds
+  template<class Viewer_t>
+  static double waitThreadedFrame(Viewer_t& theViewer, uint64_t theNbFramesOld)
+  {
+    double aGuiTime = 0.0;
+    QElapsedTimer aWaitTimer;
+    aWaitTimer.start();
+    while (aWaitTimer.elapsed() < 10000)
+    {
+      OSD_Timer aGuiTimer;
+      aGuiTimer.Start();
+      QCoreApplication::processEvents();
+      aGuiTimer.Stop();
+      aGuiTime += aGuiTimer.ElapsedTime();
+      if (nbRenderedFrames(theViewer.FrameTimings()) > theNbFramesOld
+      && !theViewer.FrameScheduler().IsFrameInFlight())
+      {
+        break;
+      }
+
+      // GUI thread is idle - don't count waiting for OCCT thread
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return aGuiTime;
+  }
+
+  //! Return current resident memory of the process in bytes.
+  static qint64 residentMemory()
+  {
+    OSD_MemInfo aMemInfo;
+    return qint64(aMemInfo.Value(OSD_MemInfo::MemWorkingSet));
+  }
+}
+
+// ================================================================
+// Function : Percentile
+// ================================================================
+double OcctQtBenchmark::Percentile(const std::vector<double>& theSorted, double thePercent)
+{
+  if (theSorted.empty())
+    return 0.0;
+
+  // nearest-rank method
+  const int aRank = int(std::ceil(thePercent / 100.0 * double(theSorted.size())));
+  return theSorted[size_t(Max(1, Min(aRank, int(theSorted.size()))) - 1)];
+}
+
+// ================================================================
+// Function : PathStats::ToJson
+// ================================================================
+QJsonObject OcctQtBenchmark::PathStats::ToJson(size_t theNbTriangles) const
+{
+  std::vector<double> aSorted = FrameTimes;
+  std::sort(aSorted.begin(), aSorted.end());
+
+  double aTotalTime = 0.0;
+  for (double aTimeIter : aSorted)
+    aTotalTime += aTimeIter;
+
+  const double aNbFrames = double(aSorted.size());
+  QJsonObject aJson;
+  aJson["name"]     = Name;
+  aJson["frames"]   = int(aSorted.size());
+  aJson["minMs"]    = !aSorted.empty() ? aSorted.front() * 1000.0 : 0.0;
+  aJson["medianMs"] = Percentile(aSorted, 50.0) * 1000.0;
+  aJson["p99Ms"]    = Percentile(aSorted, 99.0) * 1000.0;
+  aJson["maxMs"]    = !aSorted.empty() ? aSorted.back() * 1000.0 : 0.0;
+  aJson["meanMs"]   = aNbFrames > 0.0 ? aTotalTime / aNbFrames * 1000.0 : 0.0;
+  aJson["trianglesPerSecond"] = aTotalTime > 0.0 ? double(theNbTriangles) * aNbFrames / aTotalTime : 0.0;
+
+  std::vector<double> aGuiSorted = GuiTimes;
+  std::sort(aGuiSorted.begin(), aGuiSorted.end());
+  aJson["guiMedianMs"] = Percentile(aGuiSorted, 50.0) * 1000.0;
+  aJson["guiP99Ms"]    = Percentile(aGuiSorted, 99.0) * 1000.0;
+  aJson["guiMaxMs"]    = !aGuiSorted.empty() ? aGuiSorted.back() * 1000.0 : 0.0;
+  return aJson;
+}
+
+// ================================================================
+// Function : Perform
+// ================================================================
+bool OcctQtBenchmark::Perform()
+{
+  myReport = QJsonObject();
+  myError.clear();
+  if (myOptions.Scene != "boxes"
+   && myOptions.Scene != "spheres")
+  {
+    myError = QString("Unknown scene '%1'").arg(myOptions.Scene);
+    return false;
+  }
+
+  if (myOptions.Viewer == "qopenglwidget")
+    return performViewer<OcctQOpenGLWidgetViewer>();
+  else if (myOptions.Viewer == "qwidget")
+    return performViewer<OcctQWidgetViewer>();
+
+  myError = QString("Unknown viewer '%1'").arg(myOptions.Viewer);
+  return false;
+}
+
+// ================================================================
+// Function : performViewer
+// ================================================================
+template<class Viewer_t>
+bool OcctQtBenchmark::performViewer()
+{
+  // generate and mesh scene (shapes and triangulations are shared by all views)
+  std::vector<TopoDS_Shape> aParts = generateScene(myOptions);
+  OcctTessellator aTessellator;
+  aTessellator.ChangeMeshPolicy().RelDeflection = myOptions.Deflection;
+  aTessellator.Perform(aParts);
+  const size_t aNbTriangles = aTessellator.LastStats().NbTriangles;
+
+  // create views - either independent viewers or views of one shared viewer
+  const qint64 aRssBase = residentMemory();
+  const Handle(OcctSharedViewer) aSharedViewer = myOptions.ToShare ? Viewer_t::CreateSharedViewer() : Handle(OcctSharedViewer)();
+  std::vector<std::unique_ptr<Viewer_t>> aViewers;
+  for (int aViewIter = 0; aViewIter < myOptions.NbViews; ++aViewIter)
+  {
+    Viewer_t* aViewer = !aSharedViewer.IsNull() ? new Viewer_t(aSharedViewer) : new Viewer_t();
+    aViewers.push_back(std::unique_ptr<Viewer_t>(aViewer));
+    aViewer->InteractionLod().SetEnabled(myOptions.ToUseLod);
+    aViewer->ResolutionScaler().SetEnabled(myOptions.ToUseLod);
+    if (!aViewer->SetThreadedRendering(myOptions.ToUseThread))
+    {
+      myError = "Threaded rendering is not supported by this configuration";
+      return false;
+    }
+    aViewer->resize(myOptions.Width, myOptions.Height);
+    aViewer->show();
+  }
+
+  // wait for windows to be exposed and OpenGL contexts to be initialized
+  QElapsedTimer aWaitTimer;
+  aWaitTimer.start();
+  for (const std::unique_ptr<Viewer_t>& aViewerIter : aViewers)
+  {
+    while (aWaitTimer.elapsed() < 10000
+        && (aViewerIter->windowHandle() == nullptr || !aViewerIter->windowHandle()->isExposed()))
+    {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    }
+    aViewerIter->repaint();
+    if (myOptions.ToUseThread)
+      waitThreadedFrame(*aViewerIter, 0);
+
+    if (nbRenderedFrames(aViewerIter->FrameTimings()) == 0)
+    {
+      myError = "OpenGL initialization failed";
+      return false;
+    }
+  }
+
+  Viewer_t& aViewer = *aViewers.front();
+  const Handle(V3d_View)& aView = aViewer.View();
+  const qint64 aRssViews   = residentMemory();
+  const qint64 aGpuFreeOld = !myOptions.ToUseThread ? availableGpuMemory(aView) : -1; // context is bound to OCCT thread
+
+  // modify the view and render the frame showing modification;
+  // in threaded mode the view is modified by OCCT thread right before redraw
+  const auto aRenderCommand = [&](Viewer_t& theViewer, const OcctViewCommandQueue::Command& theCommand, double& theGuiTime) -> double
+  {
+    OSD_Timer aFrameTimer;
+    if (myOptions.ToUseThread)
+    {
+      const uint64_t aNbFramesOld = nbRenderedFrames(theViewer.FrameTimings());
+      aFrameTimer.Start();
+      theViewer.PushViewCommand(theCommand);
+      aFrameTimer.Stop();
+      theGuiTime = aFrameTimer.ElapsedTime();
+      aFrameTimer.Start();
+      theGuiTime += waitThreadedFrame(theViewer, aNbFramesOld);
+      aFrameTimer.Stop();
+      return aFrameTimer.ElapsedTime();
+    }
+
+    // frame is rendered synchronously, blocking GUI thread; pending events are processed outside of measurement
+    theCommand();
+    aFrameTimer.Start();
+    theViewer.repaint();
+    finishGl(theViewer.View());
+    aFrameTimer.Stop();
+    QCoreApplication::processEvents();
+    theGuiTime = aFrameTimer.ElapsedTime();
+    return theGuiTime;
+  };
+
+  // display scene once in shared viewer or within every independent viewer
+  OSD_Timer aDisplayTimer;
+  aDisplayTimer.Start();
+  for (size_t aViewIter = 0; aViewIter < aViewers.size(); ++aViewIter)
+  {
+    Viewer_t* aViewerIter = aViewers[aViewIter].get();
+    const bool toDisplay = aViewIter == 0 || aSharedViewer.IsNull();
+    double aGuiTime = 0.0;
+    aRenderCommand(*aViewerIter, [aViewerIter, toDisplay, &aParts]()
+    {
+      if (toDisplay)
+      {
+        aViewerIter->SharedViewer()->RemoveModel();
+        for (const TopoDS_Shape& aPartIter : aParts)
+        {
+          Handle(AIS_Shape) aPrs = new AIS_Shape(aPartIter);
+          aViewerIter->Context()->Display(aPrs, AIS_Shaded, 0, false);
+        }
+      }
+      aViewerIter->View()->FitAll(0.01, false);
+      aViewerIter->View()->Invalidate();
+    }, aGuiTime);
+  }
+  aDisplayTimer.Stop();
+
+  // memory consumed by presentations of the scene in all views
+  const qint64 aRssScene   = residentMemory();
+  const qint64 aGpuFreeNew = !myOptions.ToUseThread ? availableGpuMemory(aView) : -1;
+
+  double aGuiTime = 0.0;
+  for (int aFrameIter = 0; aFrameIter < myOptions.NbWarmup; ++aFrameIter)
+    aRenderCommand(aViewer, [&aView]() { aView->Invalidate(); }, aGuiTime);
+
+  Handle(Graphic3d_Camera) anInitCam = new Graphic3d_Camera();
+  aRenderCommand(aViewer, [&aView, &anInitCam]() { anInitCam->Copy(aView->Camera()); }, aGuiTime);
+
+  QJsonArray aPathsJson;
+  PathStats  aTotalStats;
+  aTotalStats.Name = "total";
+  for (const char* aPathIter : THE_CAMERA_PATHS)
+  {
+    PathStats aPathStats;
+    aPathStats.Name = aPathIter;
+    aPathStats.FrameTimes.reserve(size_t(Max(myOptions.NbFrames, 0)));
+    aPathStats.GuiTimes  .reserve(size_t(Max(myOptions.NbFrames, 0)));
+    for (int aFrameIter = 0; aFrameIter < myOptions.NbFrames; ++aFrameIter)
+    {
+      const double aPhase = double(aFrameIter) / double(myOptions.NbFrames);
+      aPathStats.FrameTimes.push_back(aRenderCommand(aViewer, [&aView, &anInitCam, &aPathStats, aPhase]()
+      {
+        applyCameraPath(aPathStats.Name, anInitCam, aView->Camera(), aPhase);
+        aView->Invalidate();
+      }, aGuiTime));
+      aPathStats.GuiTimes.push_back(aGuiTime);
+    }
+    aRenderCommand(aViewer, [&aView, &anInitCam]() { aView->Camera()->Copy(anInitCam); }, aGuiTime);
+
+    aTotalStats.FrameTimes.insert(aTotalStats.FrameTimes.end(), aPathStats.FrameTimes.begin(), aPathStats.FrameTimes.end());
+    aTotalStats.GuiTimes  .insert(aTotalStats.GuiTimes.end(),   aPathStats.GuiTimes.begin(),   aPathStats.GuiTimes.end());
+    aPathsJson.append(aPathStats.ToJson(aNbTriangles));
+  }
+
+  OSD_MemInfo aMemInfo;
+  const qint64 aPeakRss = qint64(aMemInfo.Value(OSD_MemInfo::MemWorkingSetPeak));
+
+  myReport["viewer"]        = myOptions.Viewer;
+  myReport["scene"]         = myOptions.Scene;
+  myReport["objects"]       = myOptions.NbObjects;
+  myReport["triangles"]     = qint64(aNbTriangles);
+  myReport["width"]         = myOptions.Width;
+  myReport["height"]        = myOptions.Height;
+  myReport["lod"]           = myOptions.ToUseLod;
+  myReport["threaded"]      = myOptions.ToUseThread;
+  myReport["meshTimeMs"]    = aTessellator.LastStats().ElapsedTime * 1000.0;
+  myReport["displayTimeMs"] = aDisplayTimer.ElapsedTime() * 1000.0;
+  myReport["paths"]         = aPathsJson;
+  myReport["total"]         = aTotalStats.ToJson(aNbTriangles);
+  myReport["peakRssBytes"]  = aPeakRss;
+  {
+    QJsonObject aMemJson;
+    aMemJson["views"]          = myOptions.NbViews;
+    aMemJson["shared"]         = myOptions.ToShare;
+    aMemJson["viewsRssBytes"]  = aRssViews - aRssBase;
+    aMemJson["sceneRssBytes"]  = aRssScene - aRssViews;
+    aMemJson["sceneGpuBytes"]  = aGpuFreeOld != -1 && aGpuFreeNew != -1 ? aGpuFreeOld - aGpuFreeNew : qint64(-1);
+    myReport["memory"]         = aMemJson;
+  }
+  myReport["glInfo"]        = aViewer.getGlInfo();
+  return true;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtBenchmark_HeaderFile
+#define _OcctQtBenchmark_HeaderFile
+
+#include <Standard_WarningsDisable.hxx>
+#include <QJsonObject>
+#include <QString>
+#include <Standard_WarningsRestore.hxx>
+
+#include <vector>
+
+//! Rendering benchmark driving OCCT 3D Viewer widget through scripted camera paths
+//! over generated scene and measuring frame times.
+//!
+//! Frames are rendered synchronously by QWidget::repaint() with glFinish() afterwards (when possible),
+//! so that measured time includes OCCT rendering, Qt-OCCT glue and Qt composition.
+//!
+//! In threaded mode, view is modified through commands executed by OCCT rendering thread;
+//! frame time is then measured from pushing the command till presentation of the frame,
+//! while GUI time sums only the work done by GUI thread (pushing commands and processing events).
+//!
+//! With several views, memory consumed by the scene (RSS and GPU memory, when reported by driver)
+//! is measured to compare independent viewers with a viewer shared by all views.
+class OcctQtBenchmark
+{
+public:
+  //! Benchmark options.
+  struct Options
+  {
+    QString Viewer     = "qopenglwidget"; //!< viewer integration: "qopenglwidget" or "qwidget"
+    QString Scene      = "boxes";         //!< generated scene: "boxes" or "spheres"
+    int     NbObjects  = 1000;            //!< number of generated objects
+    int     NbFrames   = 120;             //!< number of frames per camera path
+    int     NbWarmup   = 10;              //!< number of warm-up frames (not measured)
+    int     Width      = 800;             //!< view width in logical pixels
+    int     Height     = 600;             //!< view height in logical pixels
+    double  Deflection = 0.001;           //!< relative linear deflection for meshing
+    bool    ToUseLod   = false;           //!< keep interaction level-of-detail and dynamic resolution enabled
+    int     NbViews    = 1;               //!< number of viewer windows showing the scene (frames are measured in the first one)
+    bool    ToShare    = false;           //!< share one driver and viewer across views instead of displaying scene in each
+    bool    ToUseThread = false;          //!< render on a dedicated OCCT thread
+  };
+
+  //! Frame statistics of single camera path.
+  struct PathStats
+  {
+    QString Name;
+    std::vector<double> FrameTimes; //!< measured frame times in seconds
+    std::vector<double> GuiTimes;   //!< time spent by GUI thread per frame in seconds
+
+    //! Convert statistics into JSON object (times in milliseconds).
+    QJsonObject ToJson(size_t theNbTriangles) const;
+  };
+
+public:
+  //! Main constructor.
+  OcctQtBenchmark(const Options& theOptions) : myOptions(theOptions) {}
+
+  //! Run benchmark.
+  //! @return FALSE on failure
+  bool Perform();
+
+  //! Return report as JSON object.
+  const QJsonObject& Report() const { return myReport; }
+
+  //! Return error message of failed run.
+  const QString& ErrorMessage() const { return myError; }
+
+  //! Return percentile of sorted values.
+  static double Percentile(const std::vector<double>& theSorted, double thePercent);
+
+private:
+  //! Run benchmark on specific viewer widget.
+  template<class Viewer_t> bool performViewer();
+
+private:
+  Options     myOptions;
+  QJsonObject myReport;
+  QString     myError;
+};
+
+#endif // _OcctQtBenchmark_HeaderFile
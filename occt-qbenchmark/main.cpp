@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctQtBenchmark.h"
+
+#include "../occt-qt-tools/OcctQtTools.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <Standard_WarningsRestore.hxx>
+
+#include <Standard_Version.hxx>
+
+int main(int theNbArgs, char** theArgVec)
+{
+  // before creating QApplication: define platform plugin to load (e.g. xcb on Linux)
+  // and graphic driver (e.g. desktop OpenGL with desired profile/surface)
+  OcctQtTools::qtGlPlatformSetup();
+  QApplication aQApp(theNbArgs, theArgVec);
+
+  QCoreApplication::setApplicationName("OCCT Qt Viewer benchmark");
+  QCoreApplication::setOrganizationName("OpenCASCADE");
+  QCoreApplication::setApplicationVersion(OCC_VERSION_STRING_EXT);
+
+  OcctQtBenchmark::Options anOpts;
+  QCommandLineParser aParser;
+  aParser.setApplicationDescription("Renders generated scene along scripted camera paths and reports frame times as JSON.");
+  aParser.addHelpOption();
+  aParser.addVersionOption();
+  const QCommandLineOption anOptViewer("viewer", "Viewer integration: qopenglwidget or qwidget.", "name", anOpts.Viewer);
+  const QCommandLineOption anOptScene("scene", "Generated scene: boxes or spheres.", "name", anOpts.Scene);
+  const QCommandLineOption anOptCount("count", "Number of generated objects.", "number", QString::number(anOpts.NbObjects));
+  const QCommandLineOption anOptFrames("frames", "Number of frames per camera path.", "number", QString::number(anOpts.NbFrames));
+  const QCommandLineOption anOptWarmup("warmup", "Number of warm-up frames.", "number", QString::number(anOpts.NbWarmup));
+  const QCommandLineOption anOptWidth("width", "View width.", "pixels", QString::number(anOpts.Width));
+  const QCommandLineOption anOptHeight("height", "View height.", "pixels", QString::number(anOpts.Height));
+  const QCommandLineOption anOptDefl("deflection", "Relative linear deflection for meshing.", "value", QString::number(anOpts.Deflection));
+  const QCommandLineOption anOptLod("lod", "Keep interaction level-of-detail and dynamic resolution enabled.");
+  const QCommandLineOption anOptViews("views", "Number of viewer windows showing the scene.", "number", QString::number(anOpts.NbViews));
+  const QCommandLineOption anOptShared("shared", "Share one graphic driver and viewer across views.");
+  const QCommandLineOption anOptThreaded("threaded", "Render on a dedicated OCCT thread (incompatible with --shared).");
+  const QCommandLineOption anOptOutput("output", "Output JSON file (standard output by default).", "file");
+  aParser.addOptions({ anOptViewer, anOptScene, anOptCount, anOptFrames, anOptWarmup,
+                       anOptWidth, anOptHeight, anOptDefl, anOptLod, anOptViews, anOptShared, anOptThreaded, anOptOutput });
+  aParser.process(aQApp);
+
+  anOpts.Viewer     = aParser.value(anOptViewer);
+  anOpts.Scene      = aParser.value(anOptScene);
+  anOpts.NbObjects  = aParser.value(anOptCount).toInt();
+  anOpts.NbFrames   = aParser.value(anOptFrames).toInt();
+  anOpts.NbWarmup   = aParser.value(anOptWarmup).toInt();
+  anOpts.Width      = aParser.value(anOptWidth).toInt();
+  anOpts.Height     = aParser.value(anOptHeight).toInt();
+  anOpts.Deflection = aParser.value(anOptDefl).toDouble();
+  anOpts.ToUseLod   = aParser.isSet(anOptLod);
+  anOpts.NbViews    = aParser.value(anOptViews).toInt();
+  anOpts.ToShare    = aParser.isSet(anOptShared);
+  anOpts.ToUseThread = aParser.isSet(anOptThreaded);
+  if (anOpts.NbObjects < 1 || anOpts.NbFrames < 1 || anOpts.Width < 1 || anOpts.Height < 1 || anOpts.Deflection <= 0.0
+   || anOpts.NbViews < 1
+   || (anOpts.ToUseThread && anOpts.ToShare))
+  {
+    QTextStream(stderr) << "Error: invalid arguments\n";
+    return 1;
+  }
+
+  OcctQtBenchmark aBenchmark(anOpts);
+  if (!aBenchmark.Perform())
+  {
+    QTextStream(stderr) << "Error: " << aBenchmark.ErrorMessage() << "\n";
+    return 1;
+  }
+
+  const QByteArray aJson = QJsonDocument(aBenchmark.Report()).toJson(QJsonDocument::Indented);
+  if (!aParser.isSet(anOptOutput))
+  {
+    QTextStream(stdout) << aJson;
+    return 0;
+  }
+
+  QFile aFile(aParser.value(anOptOutput));
+  if (!aFile.open(QIODevice::WriteOnly)
+   || aFile.write(aJson) != aJson.size())
+  {
+    QTextStream(stderr) << "Error: unable to write '" << aFile.fileName() << "'\n";
+    return 1;
+  }
+  return 0;
+}
@@ -9,12 +9,17 @@
 #include "OcctQOpenGLWidgetViewer.h"
 
 #include "../occt-qt-tools/OcctGlTools.h"
+#include "../occt-qt-tools/OcctTessellator.h"
 #include "../occt-qt-tools/OcctQtTools.h"
 
 #include <Standard_WarningsDisable.hxx>
 #include <QApplication>
 #include <QMessageBox>
 #include <QMouseEvent>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QMatrix4x4>
+#include <QThread>
 #include <Standard_WarningsRestore.hxx>
 
 #include <AIS_Shape.hxx>
@@ -38,7 +43,15 @@ typedef Aspect_DisplayConnection Xw_DisplayConnection;
 // Function : OcctQOpenGLWidgetViewer
 // ================================================================
 OcctQOpenGLWidgetViewer::OcctQOpenGLWidgetViewer(QWidget* theParent)
-    : QOpenGLWidget(theParent)
+    : OcctQOpenGLWidgetViewer(CreateSharedViewer(), theParent)
+{
+  //
+}
+
+// ================================================================
+// Function : CreateSharedViewer
+// ================================================================
+Handle(OcctSharedViewer) OcctQOpenGLWidgetViewer::CreateSharedViewer()
 {
   Handle(Aspect_DisplayConnection) aDisp   = new Xw_DisplayConnection();
   Handle(OpenGl_GraphicDriver)     aDriver = new OpenGl_GraphicDriver(aDisp, false);
@@ -48,16 +61,20 @@ OcctQOpenGLWidgetViewer::OcctQOpenGLWidgetViewer(QWidget* theParent)
   aDriver->ChangeOptions().buffersOpaqueAlpha = true;
   // offscreen FBOs should be always used
   aDriver->ChangeOptions().useSystemBuffer = false;
+  return new OcctSharedViewer(aDriver);
+}
 
-  // create viewer
-  myViewer = new V3d_Viewer(aDriver);
-  myViewer->SetDefaultBackgroundColor(Quantity_NOC_BLACK);
-  myViewer->SetDefaultLights();
-  myViewer->SetLightOn();
-  myViewer->ActivateGrid(Aspect_GT_Rectangular, Aspect_GDM_Lines);
-
-  // create AIS context
-  myContext = new AIS_InteractiveContext(myViewer);
+// ================================================================
+// Function : OcctQOpenGLWidgetViewer
+// ================================================================
+OcctQOpenGLWidgetViewer::OcctQOpenGLWidgetViewer(const Handle(OcctSharedViewer)& theSharedViewer, QWidget* theParent)
+    : QOpenGLWidget(theParent),
+      mySharedViewer(theSharedViewer)
+{
+  // viewer and context are shared with other widgets (if any);
+  // OpenGL contexts of widgets share resources thanks to Qt::AA_ShareOpenGLContexts
+  myViewer  = mySharedViewer->Viewer();
+  myContext = mySharedViewer->Context();
 
   myViewCube = new AIS_ViewCube();
   myViewCube->SetViewAnimation(myViewAnimation);
@@ -69,12 +86,18 @@ OcctQOpenGLWidgetViewer::OcctQOpenGLWidgetViewer(QWidget* theParent)
   myView = myViewer->CreateView();
   myView->SetImmediateUpdate(false);
 #ifndef __APPLE__
-  myView->ChangeRenderingParams().NbMsaaSamples = 4; // warning - affects performance
+  myView->ChangeRenderingParams().NbMsaaSamples = 4; // warning - affects performance (disabled during interaction)
 #endif
   myView->ChangeRenderingParams().ToShowStats = true;
   // NOLINTNEXTLINE
   myView->ChangeRenderingParams().CollectedStats = (Graphic3d_RenderingParams::PerfCounters)(
     Graphic3d_RenderingParams::PerfCounters_FrameRate | Graphic3d_RenderingParams::PerfCounters_Triangles);
+  mySharedViewer->AddView(myView, myViewCube, [this]() { updateView(); });
+
+  // input events are stamped to measure input-to-photon latency,
+  // while dragged pointers are extrapolated to expected presentation time
+  myInputAccum.SetInputLatency(&myInputLatency);
+  myInputAccum.SetInputPredictor(&myInputPredictor);
 
   // Qt widget setup
   setAttribute(Qt::WA_AcceptTouchEvents); // necessary to receive QTouchEvent events
@@ -82,7 +105,40 @@ OcctQOpenGLWidgetViewer::OcctQOpenGLWidgetViewer(QWidget* theParent)
   setBackgroundRole(QPalette::NoRole); // or NoBackground
   setFocusPolicy(Qt::StrongFocus);     // set focus policy to threat QContextMenuEvent from keyboard
   setUpdatesEnabled(true);
-  setUpdateBehavior(QOpenGLWidget::NoPartialUpdate);
+  setUpdateBehavior(QOpenGLWidget::PartialUpdate); // keep the last frame for repaints unrelated to the scene
+
+  // redraw requests are throttled by presentation of previous frame
+  // (in threaded mode - by publishing of previous OCCT frame)
+  connect(this, &QOpenGLWidget::frameSwapped, this, [this]()
+  {
+    if (myIsThreaded)
+    {
+      // input events are reflected by OCCT frame once its texture has been blitted
+      myInputLatency.FramePresented(myShownBatch);
+      return;
+    }
+
+    myFrameScheduler.FramePresented();
+    myFrameTimings.FramePresented();
+    myInputLatency.FramePresented();
+  });
+  connect(&myFrameScheduler, &OcctQtFrameScheduler::frameRequested, this, [this]()
+  {
+    if (myIsThreaded)
+      requestOcctFrame();
+    else
+      update();
+  });
+
+  // full quality is restored by redrawing idle view
+  myLodTimer.setSingleShot(true);
+  connect(&myLodTimer, &QTimer::timeout, this, [this]() { updateView(); });
+
+  // loaded parts are displayed by paintGL()
+  connect(&myModelLoader, &OcctQtModelLoader::partsLoaded, this, [this]() { updateView(); });
+
+  // frames are captured by paintGL() or by OCCT thread
+  myFrameCapture.SetFrameRequester([this]() { updateView(); });
 
   // OpenGL setup managed by Qt - it is better to do this globally
   // via QSurfaceFormat::setDefaultFormat() - see main() function
@@ -95,16 +151,31 @@ OcctQOpenGLWidgetViewer::OcctQOpenGLWidgetViewer(QWidget* theParent)
 // ================================================================
 OcctQOpenGLWidgetViewer::~OcctQOpenGLWidgetViewer()
 {
+  // stop background loading
+  myModelLoader.Cancel();
+
+  // stop OCCT thread, which releases OCCT view within its OpenGL context
+  myRenderThread.Stop();
+  if (myTextureBlitter.isCreated())
+  {
+    makeCurrent();
+    myTextureBlitter.destroy();
+  }
+  if (myView.IsNull())
+    return;
+
   // hold on X11 display connection till making another connection active by glXMakeCurrent()
   // to workaround sudden crash in QOpenGLWidget destructor
   Handle(Aspect_DisplayConnection) aDisp = myViewer->Driver()->GetDisplayConnection();
 
-  // release OCCT viewer
-  myContext->RemoveAll(false);
+  // release OCCT view; shared viewer is released with the last view
+  myFrameCapture.Release(OcctGlTools::GetGlContext(myView));
+  myResolutionScaler.Release(myView);
+  mySharedViewer->RemoveView(myView);
   myContext.Nullify();
-  myView->Remove();
   myView.Nullify();
   myViewer.Nullify();
+  mySharedViewer.Nullify();
 
   // make active OpenGL context created by Qt
   makeCurrent();
@@ -119,13 +190,21 @@ bool OcctQOpenGLWidgetViewer::event(QEvent* theEvent)
   if (myView.IsNull())
     return QOpenGLWidget::event(theEvent);
 
+  if (theEvent->type() == QEvent::UpdateLater)
+  {
+    updateView();
+    theEvent->accept();
+    return true;
+  }
+
   if (theEvent->type() == QEvent::TouchBegin
    || theEvent->type() == QEvent::TouchUpdate
    || theEvent->type() == QEvent::TouchEnd)
   {
     theEvent->accept();
     myHasTouchInput = true;
-    if (OcctQtTools::qtHandleTouchEvent(*this, myView, static_cast<QTouchEvent*>(theEvent)))
+    std::lock_guard<std::mutex> anInputLock(myInputMutex);
+    if (OcctQtTools::qtHandleTouchEvent(*this, devicePixelRatioF(), static_cast<QTouchEvent*>(theEvent), &myInputLatency, &myInputPredictor))
       updateView();
 
     return true;
@@ -158,8 +237,7 @@ void OcctQOpenGLWidgetViewer::keyPressEvent(QKeyEvent* theEvent)
       return;
     }
     case Aspect_VKey_F: {
-      myView->FitAll(0.01, false);
-      update();
+      PushViewCommand([this]() { myView->FitAll(0.01, false); });
       theEvent->accept();
       return;
     }
@@ -180,7 +258,7 @@ void OcctQOpenGLWidgetViewer::mousePressEvent(QMouseEvent* theEvent)
     return; // skip mouse events emulated by system from screen touches
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
@@ -194,7 +272,7 @@ void OcctQOpenGLWidgetViewer::mouseReleaseEvent(QMouseEvent* theEvent)
     return;
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
@@ -211,7 +289,7 @@ void OcctQOpenGLWidgetViewer::mouseMoveEvent(QMouseEvent* theEvent)
     return; // skip mouse events emulated by system from screen touches
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
@@ -232,9 +310,21 @@ void OcctQOpenGLWidgetViewer::wheelEvent(QWheelEvent* theEvent)
 #else
   const Graphic3d_Vec2d aPnt2d(theEvent->pos().x(), theEvent->pos().y());
 #endif
-  const Graphic3d_Vec2i aPnt2i(myView->Window()->ConvertPointToBacking(aPnt2d) + Graphic3d_Vec2d(0.5));
-  if (!myView->Subviews().IsEmpty())
+  if (myIsThreaded)
+  {
+    // subviews are owned by OCCT thread - switch input focus right before the wheel event is handled
+    const Graphic3d_Vec2i aPnt2i(aPnt2d * devicePixelRatioF() + Graphic3d_Vec2d(0.5));
+    PushViewCommand([this, aPnt2i]()
+    {
+      Handle(V3d_View) aPickedView = !myView->Subviews().IsEmpty() ? myView->PickSubview(aPnt2i) : Handle(V3d_View)();
+      if (!aPickedView.IsNull() && aPickedView != myFocusView)
+        OnSubviewChanged(myContext, myFocusView, aPickedView);
+    });
+  }
+  else if (!myView->Window().IsNull()
+        && !myView->Subviews().IsEmpty())
   {
+    const Graphic3d_Vec2i aPnt2i(myView->Window()->ConvertPointToBacking(aPnt2d) + Graphic3d_Vec2d(0.5));
     Handle(V3d_View) aPickedView = myView->PickSubview(aPnt2i);
     if (!aPickedView.IsNull() && aPickedView != myFocusView)
     {
@@ -246,17 +336,199 @@ void OcctQOpenGLWidgetViewer::wheelEvent(QWheelEvent* theEvent)
   }
 #endif
 
-  if (OcctQtTools::qtHandleWheelEvent(*this, myView, theEvent))
+  if (myInputAccum.AddWheelEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
+// ================================================================
+// Function : OpenModel
+// ================================================================
+bool OcctQOpenGLWidgetViewer::OpenModel(const QString& theFilePath)
+{
+  myModelLoader.Cancel();
+  PushViewCommand([this]() { mySharedViewer->RemoveModel(); });
+  return myModelLoader.Load(theFilePath);
+}
+
+// ================================================================
+// Function : SetThreadedRendering
+// ================================================================
+bool OcctQOpenGLWidgetViewer::SetThreadedRendering(bool theToEnable)
+{
+  if (myIsThreaded == theToEnable)
+    return true;
+
+  if (isValid())
+  {
+    Message::SendWarning() << "Warning: threaded rendering should be set before showing the widget";
+    return false;
+  }
+  else if (theToEnable
+        && mySharedViewer->NbViews() > 1)
+  {
+    Message::SendWarning() << "Warning: threaded rendering is not supported for a viewer shared with other widgets";
+    return false;
+  }
+
+  myIsThreaded = theToEnable;
+  return true;
+}
+
+// ================================================================
+// Function : PushViewCommand
+// ================================================================
+void OcctQOpenGLWidgetViewer::PushViewCommand(const OcctViewCommandQueue::Command& theCommand)
+{
+  myViewCommands.Push(theCommand);
+  updateView();
+}
+
+// ================================================================
+// Function : PickAt
+// ================================================================
+int OcctQOpenGLWidgetViewer::PickAt(const Graphic3d_Vec2i& thePnt, const OcctAsyncPicker::Callback& theCallback)
+{
+  return mySharedViewer->Picker().PickPoint(myView, thePnt, theCallback);
+}
+
+// ================================================================
+// Function : PickRect
+// ================================================================
+int OcctQOpenGLWidgetViewer::PickRect(const Graphic3d_Vec2i& thePnt1,
+                                      const Graphic3d_Vec2i& thePnt2,
+                                      const OcctAsyncPicker::Callback& theCallback)
+{
+  return mySharedViewer->Picker().PickRect(myView, thePnt1, thePnt2, theCallback);
+}
+
+// ================================================================
+// Function : StartRecording
+// ================================================================
+bool OcctQOpenGLWidgetViewer::StartRecording(const OcctQtFrameRecorder::Params& theParams)
+{
+  myFrameCapture.SetFrameListener(OcctQtFrameCapture::FrameCallback());
+  if (!myFrameRecorder.Start(theParams))
+    return false;
+
+  myFrameCapture.SetFrameListener([this](const uint8_t* theData, int theSizeX, int theSizeY, int theRowBytes, double theTime)
+  {
+    myFrameRecorder.PushFrame(theData, theSizeX, theSizeY, theRowBytes, theTime);
+  }, 1.0 / double(theParams.Fps));
+  return true;
+}
+
+// ================================================================
+// Function : StopRecording
+// ================================================================
+void OcctQOpenGLWidgetViewer::StopRecording()
+{
+  myFrameCapture.SetFrameListener(OcctQtFrameCapture::FrameCallback());
+  myFrameRecorder.Stop();
+}
+
 // =======================================================================
 // function : updateView
 // =======================================================================
 void OcctQOpenGLWidgetViewer::updateView()
 {
-  update();
-  // if (window() != NULL) { window()->update(); }
+  if (QThread::currentThread() != thread())
+  {
+    // frame scheduler lives in GUI thread
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
+    return;
+  }
+  myToRedrawFrame = true;
+  myFrameScheduler.RequestFrame();
+}
+
+// ================================================================
+// Function : contextLazyMoveTo
+// ================================================================
+void OcctQOpenGLWidgetViewer::contextLazyMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                                                const Handle(V3d_View)& theView,
+                                                const Graphic3d_Vec2i& thePnt)
+{
+  // selection structures are shared with asynchronous picking - postpone hover detection instead of waiting;
+  // click selects detected owner right after this call, so that its detection cannot be postponed or skipped
+  const bool isClickPending = myGL.Selection.Tool == AIS_ViewSelectionTool_Picking
+                          && !myGL.Selection.Points.IsEmpty();
+  std::unique_lock<std::mutex> aSelLock(mySharedViewer->Picker().SelectionMutex(), std::defer_lock);
+  if (isClickPending)
+  {
+    aSelLock.lock();
+  }
+  else if (!aSelLock.try_lock())
+  {
+    myHoverThrottle.Postpone(thePnt);
+    return;
+  }
+
+  if (!myHoverThrottle.ToDetect(thePnt, theView, mySharedViewer->SceneRevision(), isClickPending))
+    return;
+
+  // base implementation skips the same point, while detection is also needed on camera change
+  myPrevMoveTo.SetValues(-1, -1);
+  AIS_ViewController::contextLazyMoveTo(theCtx, theView, thePnt);
+}
+
+// ================================================================
+// Function : handleSelectionPoly
+// ================================================================
+void OcctQOpenGLWidgetViewer::handleSelectionPoly(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)
+{
+  if (!myGL.Selection.ToApplyTool)
+  {
+    AIS_ViewController::handleSelectionPoly(theCtx, theView);
+    return;
+  }
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (myGL.Selection.Tool == AIS_ViewSelectionTool_RubberBand
+   && myGL.Selection.Points.Size() == 2)
+  {
+    // heavy rectangle traversal is performed by working thread and applied once it is done;
+    // base implementation only removes rubber band without points
+    const Graphic3d_Vec2i aPnt1 = myGL.Selection.Points.First();
+    const Graphic3d_Vec2i aPnt2 = myGL.Selection.Points.Last();
+    const AIS_SelectionScheme aScheme = myGL.Selection.Scheme;
+    myGL.Selection.Points.Clear();
+    AIS_ViewController::handleSelectionPoly(theCtx, theView);
+    mySharedViewer->Picker().PickRect(myView, aPnt1, aPnt2, [this, aScheme](const OcctAsyncPicker::Result& theResult)
+    {
+      OcctAsyncPicker::ApplySelection(myContext, theResult, aScheme);
+      myView->Invalidate();
+      mySharedViewer->InvalidateViews(myView);
+    });
+    return;
+  }
+#endif
+
+  // other tools traverse the main selector within this thread
+  std::lock_guard<std::mutex> aSelLock(mySharedViewer->Picker().SelectionMutex());
+  AIS_ViewController::handleSelectionPoly(theCtx, theView);
+}
+
+// ================================================================
+// Function : PickPoint
+// ================================================================
+bool OcctQOpenGLWidgetViewer::PickPoint(gp_Pnt& thePnt,
+                                        const Handle(AIS_InteractiveContext)& theCtx,
+                                        const Handle(V3d_View)& theView,
+                                        const Graphic3d_Vec2i& theCursor,
+                                        bool theToStickToPickRay)
+{
+  std::lock_guard<std::mutex> aSelLock(mySharedViewer->Picker().SelectionMutex());
+  return AIS_ViewController::PickPoint(thePnt, theCtx, theView, theCursor, theToStickToPickRay);
+}
+
+// ================================================================
+// Function : OnSelectionChanged
+// ================================================================
+void OcctQOpenGLWidgetViewer::OnSelectionChanged(const Handle(AIS_InteractiveContext)& ,
+                                                 const Handle(V3d_View)& )
+{
+  // selection is highlighted within all views of shared viewer
+  mySharedViewer->InvalidateViews(myView);
 }
 
 // ================================================================
@@ -265,9 +537,43 @@ void OcctQOpenGLWidgetViewer::updateView()
 void OcctQOpenGLWidgetViewer::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
                                                const Handle(V3d_View)&               theView)
 {
+  // animate camera for expected presentation time of this frame
+  myFrameScheduler.SyncAnimationTimer(myViewAnimation,
+                                      myIsThreaded ? myFramePresentTime : myFrameScheduler.NextPresentationTime());
+
+  // degrade quality while camera moves; viewer-level settings are kept for views of shared viewer
+  myInteractionLod.SetViewerShared(mySharedViewer->NbViews() > 1);
+  const bool wasDegraded = myInteractionLod.IsDegraded();
+  double aRedrawDelay = myInteractionLod.Update(*this, theCtx, theView);
+  if (myInteractionLod.IsDegraded() != wasDegraded)
+    mySharedViewer->InvalidateScene(); // display modes might have been switched
+
+  // deliver asynchronous picking results and dispatch the next pick
+  mySharedViewer->Picker().Perform(theCtx, theView);
+
+  // perform dynamic highlighting postponed by rate cap or invalidated by scene modification
+  myHoverThrottle.CheckSceneRevision(mySharedViewer->SceneRevision());
+  const double aHoverDelay = myHoverThrottle.PendingDelay();
+  if (aHoverDelay == 0.0)
+    contextLazyMoveTo(theCtx, theView, myHoverThrottle.PendingPoint());
+  else if (aHoverDelay > 0.0)
+    aRedrawDelay = aRedrawDelay >= 0.0 ? std::min(aRedrawDelay, aHoverDelay) : aHoverDelay;
+
+  // reduce resolution during interaction to hold frame time budget
+  const double aScaleDelay = myResolutionScaler.Update(theView);
+  if (aScaleDelay >= 0.0)
+    aRedrawDelay = aRedrawDelay >= 0.0 ? std::min(aRedrawDelay, aScaleDelay) : aScaleDelay;
+  myResolutionScaler.BeginFrame(theView);
   AIS_ViewController::handleViewRedraw(theCtx, theView);
+  myResolutionScaler.EndFrame(theView);
   if (myToAskNextFrame)
     updateView(); // ask more frames for animation
+
+  if (aRedrawDelay >= 0.0)
+  {
+    // timer lives in GUI thread
+    QMetaObject::invokeMethod(&myLodTimer, "start", Qt::AutoConnection, Q_ARG(int, int(aRedrawDelay * 1000.0) + 1));
+  }
 }
 
 #if (OCC_VERSION_HEX >= 0x070700)
@@ -285,27 +591,38 @@ void OcctQOpenGLWidgetViewer::OnSubviewChanged(const Handle(AIS_InteractiveConte
 // ================================================================
 // Function : dumpGlInfo
 // ================================================================
-void OcctQOpenGLWidgetViewer::dumpGlInfo(bool theIsBasic, bool theToPrint)
+void OcctQOpenGLWidgetViewer::dumpGlInfo()
 {
-  TColStd_IndexedDataMapOfStringString aGlCapsDict;
-  myView->DiagnosticInformation(aGlCapsDict,
-                                theIsBasic ? Graphic3d_DiagnosticInfo_Basic : Graphic3d_DiagnosticInfo_Complete);
-  TCollection_AsciiString anInfo;
-  for (TColStd_IndexedDataMapOfStringString::Iterator aValueIter(aGlCapsDict); aValueIter.More(); aValueIter.Next())
+  // basic info is fetched once per OpenGL context, while complete one - on demand
+  myGlInfo.Invalidate();
+  myGlInfo.UpdateBasic(myView);
+  myGlInfo.UpdateSize(myView);
+  Message::SendInfo(myGlInfo.Text());
+}
+
+// ================================================================
+// Function : getGlInfo
+// ================================================================
+QString OcctQOpenGLWidgetViewer::getGlInfo()
+{
+  if (myIsThreaded)
   {
-    if (!aValueIter.Value().IsEmpty())
+    // extensions list is queried within OCCT thread, so that it is shown by the next request
+    if (!myGlInfo.HasComplete() && myGlInfo.HasBasic())
     {
-      if (!anInfo.IsEmpty())
-        anInfo += "\n";
-
-      anInfo += aValueIter.Key() + ": " + aValueIter.Value();
+      myToFetchGlInfo = true;
+      updateView();
     }
+    return QString::fromUtf8(myGlInfo.Text().ToCString());
   }
 
-  if (theToPrint)
-    Message::SendInfo(anInfo);
-
-  myGlInfo = QString::fromUtf8(anInfo.ToCString());
+  if (!myGlInfo.HasComplete() && !myView->Window().IsNull())
+  {
+    // extensions list is queried only when info is actually requested
+    makeCurrent();
+    myGlInfo.UpdateComplete(myView);
+  }
+  return QString::fromUtf8(myGlInfo.Text().ToCString());
 }
 
 // ================================================================
@@ -313,6 +630,28 @@ void OcctQOpenGLWidgetViewer::dumpGlInfo(bool theIsBasic, bool theToPrint)
 // ================================================================
 void OcctQOpenGLWidgetViewer::initializeGL()
 {
+  // framebuffer might be recreated (e.g. widget has been moved to another window)
+  myHasLastFrame = false;
+  if (myIsThreaded)
+  {
+    // OCCT context shares resources with widget's context
+    if (!myTextureBlitter.isCreated())
+      myTextureBlitter.create();
+
+    if (myRenderThread.Context() == nullptr
+     && !myView.IsNull())
+    {
+      if (!myRenderThread.CreateContext(context())
+       || !myRenderThread.Start(this))
+      {
+        handleCriticalError("Unable to start OCCT thread");
+        return;
+      }
+      updateView();
+    }
+    return;
+  }
+
   Handle(OpenGl_GraphicDriver) aDriver = Handle(OpenGl_GraphicDriver)::DownCast(myViewer->Driver());
   OcctQtTools::qtGlCapsFromSurfaceFormat(aDriver->ChangeOptions(), format());
 
@@ -328,13 +667,19 @@ void OcctQOpenGLWidgetViewer::initializeGL()
   }
 
   makeCurrent(); // restore Qt framebuffer
-  dumpGlInfo(true, true);
+  OcctGlTools::InvalidateGlState(myView);
+  dumpGlInfo();
+  myFrameCapture.InvalidateGl();
+  myResolutionScaler.SetDevicePixelRatio(devicePixelRatioF());
   if (isFirstInit)
   {
-    myContext->Display(myViewCube, 0, 0, false);
+    mySharedViewer->DisplayViewCube(myView);
+    if (!mySharedViewer->ToDisplaySampleModel())
+      return;
 
     // dummy shape for testing
     TopoDS_Shape      aBox   = BRepPrimAPI_MakeBox(100.0, 50.0, 90.0).Shape();
+    OcctTessellator().MeshPart(aBox);
     Handle(AIS_Shape) aShape = new AIS_Shape(aBox);
     myContext->Display(aShape, AIS_Shaded, 0, false);
   }
@@ -345,9 +690,17 @@ void OcctQOpenGLWidgetViewer::initializeGL()
 // ================================================================
 void OcctQOpenGLWidgetViewer::paintGL()
 {
+  if (myIsThreaded)
+  {
+    paintTexture();
+    return;
+  }
+
   if (myView.IsNull() || myView->Window().IsNull())
     return;
 
+  myFrameScheduler.FrameStarted();
+
   const double aDevPixelRatioOld = myView->Window()->DevicePixelRatio();
   if (myView->Window()->NativeHandle() != OcctGlTools::GetGlNativeWindow((Aspect_Drawable)effectiveWinId()))
   {
@@ -360,10 +713,24 @@ void OcctQOpenGLWidgetViewer::paintGL()
     initializeGL();
   }
 
+  // overlay widget has been repainted or window has been exposed - keep the previous frame without redrawing
+  const Graphic3d_Vec2i aFboSize(Graphic3d_Vec2d(width(), height()) * devicePixelRatioF());
+  if (isLastFrameValid(aFboSize))
+  {
+    ++myNbReusedFrames;
+    return;
+  }
+
+  OcctFrameTimings::FrameSentry aFrameSentry(myFrameTimings);
   Graphic3d_Vec2i aViewSizeOld; myView->Window()->Size(aViewSizeOld.x(), aViewSizeOld.y());
 
-  // wrap FBO created by QOpenGLFramebufferObject
-  if (!OcctGlTools::InitializeGlFbo(myView))
+  // wrap FBO created by QOpenGLFramebufferObject (skipped when Qt FBO is unchanged)
+  bool isFboWrapped = false;
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_InitFbo);
+    isFboWrapped = OcctGlTools::InitializeGlFbo(myView, defaultFramebufferObject(), aFboSize, int(textureFormat()));
+  }
+  if (!isFboWrapped)
   {
     QMessageBox::critical(0, "Failure", "Default FBO wrapper creation failed");
     QApplication::exit(1);
@@ -372,16 +739,310 @@ void OcctQOpenGLWidgetViewer::paintGL()
 
   Graphic3d_Vec2i aViewSizeNew; myView->Window()->Size(aViewSizeNew.x(), aViewSizeNew.y());
   if (aViewSizeNew != aViewSizeOld || myView->Window()->DevicePixelRatio() != aDevPixelRatioOld)
-    dumpGlInfo(true, false);
+  {
+    myGlInfo.UpdateSize(myView); // cheap, without GL queries
+
+    // widget's FBO has been recreated by Qt within the same OpenGL context
+    OcctGlTools::InvalidateGlState(myView);
+  }
 
   // reset global GL state from Qt before redrawing OCCT
-  OcctGlTools::ResetGlStateBeforeOcct(myView);
+  // (no-op unless something has been rendered into widget's context since the previous frame)
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_ResetGlBefore);
+    OcctGlTools::ResetGlStateBeforeOcct(myView);
+  }
 
-  // flush pending input events and redraw the viewer
-  Handle(V3d_View) aView = !myFocusView.IsNull() ? myFocusView : myView;
-  aView->InvalidateImmediate();
-  AIS_ViewController::FlushViewEvents(myContext, aView, true);
+  redrawView();
 
   // reset global GL state after OCCT before redrawing Qt
-  OcctGlTools::ResetGlStateAfterOcct(myView);
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_ResetGlAfter);
+    OcctGlTools::ResetGlStateAfterOcct(myView);
+  }
+  myLastFrameCamState = myView->Camera()->WorldViewProjState();
+  myLastFrameSize     = aFboSize;
+  myHasLastFrame      = true;
+}
+
+// ================================================================
+// Function : isLastFrameValid
+// ================================================================
+bool OcctQOpenGLWidgetViewer::isLastFrameValid(const Graphic3d_Vec2i& theFboSize)
+{
+  // frames requested after this point are redrawn by the next paintGL()
+  const bool toRedraw = myToRedrawFrame;
+  myToRedrawFrame = false;
+  if (toRedraw
+   || !myToReuseFrame
+   || !myHasLastFrame
+   || myLastFrameSize != theFboSize)
+  {
+    return false;
+  }
+
+  // view might be modified without requesting a frame (e.g. followed by direct QWidget::update() call)
+  return !myView->IsInvalidated()
+      && !myView->IsInvalidatedImmediate()
+      && !myView->Camera()->WorldViewProjState().IsChanged(myLastFrameCamState);
+}
+
+// ================================================================
+// Function : redrawView
+// ================================================================
+void OcctQOpenGLWidgetViewer::redrawView()
+{
+  // execute commands passed from GUI thread
+  if (myViewCommands.Swap())
+  {
+    myViewCommands.Execute();
+    mySharedViewer->InvalidateScene(); // commands might display or remove objects
+  }
+
+  // display parts loaded in background within a few milliseconds per frame
+  const size_t aNbDisplayedOld = myModelLoader.NbDisplayed();
+  if (myModelLoader.DisplayLoadedParts(myContext, myView, 0.005))
+    updateView();
+  if (myModelLoader.NbDisplayed() != aNbDisplayedOld)
+    mySharedViewer->InvalidateViews(myView);
+
+  // flush pending input events and redraw the viewer
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_FlushView);
+    Handle(V3d_View) aView = !myFocusView.IsNull() ? myFocusView : myView;
+    if (myIsThreaded)
+    {
+      // each texture of the ring keeps an older frame - the whole view is redrawn;
+      // input events are passed by GUI thread within requestOcctFrame()
+      myView->Invalidate();
+    }
+    else
+    {
+      aView->InvalidateImmediate();
+      myInputAccum.Flush(*this);
+      if (myInputPredictor.Apply(*this, myFrameScheduler.NextPresentationTime() - myFrameScheduler.CurrentTime()))
+        updateView(); // settle extrapolated pointer by the next frame
+    }
+    AIS_ViewController::FlushViewEvents(myContext, aView, true);
+
+    // read back the frame for capture requests (asynchronously through PBO ring)
+    myFrameCapture.Perform(myView);
+  }
+
+  // keep rendering frames till captured frames are delivered
+  if (myFrameCapture.HasPending())
+    updateView();
+}
+
+// ================================================================
+// Function : paintTexture
+// ================================================================
+void OcctQOpenGLWidgetViewer::paintTexture()
+{
+  OcctGlTextureRing::Frame aFrame;
+  if (myRenderThread.TextureRing().AcquireLatest(aFrame))
+  {
+    myShownFrame = aFrame;
+    myShownBatch = myPublishedBatch;
+  }
+
+  QOpenGLFunctions* aGlFuncs = context()->functions();
+  if (myShownFrame.TextureId == 0)
+  {
+    // the first OCCT frame is not yet ready
+    aGlFuncs->glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    aGlFuncs->glClear(GL_COLOR_BUFFER_BIT);
+    return;
+  }
+
+  // stretch the last frame over the widget till the frame of a new size is ready
+  aGlFuncs->glDisable(GL_BLEND);
+  aGlFuncs->glDisable(GL_DEPTH_TEST);
+  myTextureBlitter.bind();
+  myTextureBlitter.blit(myShownFrame.TextureId, QMatrix4x4(), QOpenGLTextureBlitter::OriginBottomLeft);
+  myTextureBlitter.release();
+
+  // OCCT thread might reuse the texture only after GPU has finished this blit
+  myRenderThread.FenceShownFrame();
+}
+
+// ================================================================
+// Function : requestOcctFrame
+// ================================================================
+void OcctQOpenGLWidgetViewer::requestOcctFrame()
+{
+  if (!myRenderThread.isRunning())
+    return;
+
+  myFrameScheduler.FrameStarted();
+  {
+    // pass input events accumulated by GUI thread to AIS_ViewController;
+    // OCCT thread takes them within flushBuffers()
+    std::lock_guard<std::mutex> anInputLock(myInputMutex);
+    myInputAccum.Flush(*this);
+    if (myInputPredictor.Apply(*this, myFrameScheduler.NextPresentationTime() - myFrameScheduler.CurrentTime()))
+      updateView(); // settle extrapolated pointer by the next frame
+  }
+  myRequestedBatch = myInputLatency.LastBatch();
+
+  OcctQtRenderThread::FrameRequest aRequest;
+  aRequest.DevicePixelRatio = devicePixelRatioF();
+  aRequest.Size = Graphic3d_Vec2i(Graphic3d_Vec2d(width(), height()) * aRequest.DevicePixelRatio);
+  aRequest.PresentTime = myFrameScheduler.NextPresentationTime();
+  myRenderThread.RequestFrame(aRequest);
+}
+
+// ================================================================
+// Function : handleFramePublished
+// ================================================================
+void OcctQOpenGLWidgetViewer::handleFramePublished()
+{
+  // frame scheduler might request the next frame right away
+  myPublishedBatch = myRequestedBatch;
+  myFrameScheduler.FramePresented();
+  update(); // blit the new texture within next paintGL()
+}
+
+// ================================================================
+// Function : handleCriticalError
+// ================================================================
+void OcctQOpenGLWidgetViewer::handleCriticalError(const QString& theMsg)
+{
+  QMessageBox::critical(0, "Failure", theMsg);
+  QApplication::exit(1);
+}
+
+// ================================================================
+// Function : initializeThreadedGL
+// ================================================================
+bool OcctQOpenGLWidgetViewer::initializeThreadedGL(const Graphic3d_Vec2i& theSize, double theDevPixelRatio)
+{
+  Handle(OpenGl_GraphicDriver) aDriver = Handle(OpenGl_GraphicDriver)::DownCast(myViewer->Driver());
+  OcctQtTools::qtGlCapsFromSurfaceFormat(aDriver->ChangeOptions(), myRenderThread.Context()->format());
+
+  const bool isFirstInit = myView->Window().IsNull();
+  if (!OcctGlTools::InitializeGlWindow(myView, 0, theSize, theDevPixelRatio))
+  {
+    QMetaObject::invokeMethod(this, "handleCriticalError", Qt::QueuedConnection,
+                              Q_ARG(QString, "OpenGl_Context is unable to wrap OpenGL context"));
+    return false;
+  }
+
+  dumpGlInfo();
+  myFrameCapture.InvalidateGl();
+  myResolutionScaler.SetDevicePixelRatio(theDevPixelRatio);
+  if (isFirstInit)
+  {
+    mySharedViewer->DisplayViewCube(myView);
+    if (!mySharedViewer->ToDisplaySampleModel())
+      return true;
+
+    // dummy shape for testing
+    TopoDS_Shape      aBox   = BRepPrimAPI_MakeBox(100.0, 50.0, 90.0).Shape();
+    OcctTessellator().MeshPart(aBox);
+    Handle(AIS_Shape) aShape = new AIS_Shape(aBox);
+    myContext->Display(aShape, AIS_Shaded, 0, false);
+  }
+  return true;
+}
+
+// ================================================================
+// Function : RenderFrame
+// ================================================================
+void OcctQOpenGLWidgetViewer::RenderFrame(const OcctQtRenderThread::FrameRequest& theRequest)
+{
+  if (theRequest.Size.x() <= 0
+   || theRequest.Size.y() <= 0)
+  {
+    return;
+  }
+
+  if (myView->Window().IsNull()
+   || myView->Window()->DevicePixelRatio() != theRequest.DevicePixelRatio)
+  {
+    if (!initializeThreadedGL(theRequest.Size, theRequest.DevicePixelRatio))
+      return;
+  }
+
+  myFramePresentTime = theRequest.PresentTime;
+  myFrameTimings.BeginFrame();
+
+  bool isTargetReady = false;
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_InitFbo);
+    isTargetReady = myRenderThread.TextureRing().BeginFrame(myView, theRequest.Size);
+  }
+  if (!isTargetReady)
+  {
+    myFrameTimings.EndFrame();
+    QMetaObject::invokeMethod(this, "handleCriticalError", Qt::QueuedConnection,
+                              Q_ARG(QString, "OCCT is unable to allocate texture ring"));
+    return;
+  }
+
+  myGlInfo.UpdateSize(myView); // cheap, without GL queries
+  if (myToFetchGlInfo.exchange(false))
+    myGlInfo.UpdateComplete(myView);
+
+  // OpenGL context is not shared with Qt, so that GL state reset is unnecessary
+  redrawView();
+
+  const bool isPublished = myRenderThread.TextureRing().EndFrame(myView);
+  myFrameTimings.EndFrame();
+  if (isPublished)
+    framePublished();
+}
+
+// ================================================================
+// Function : PollFrames
+// ================================================================
+bool OcctQOpenGLWidgetViewer::PollFrames()
+{
+  if (myView->Window().IsNull())
+    return false;
+
+  if (myRenderThread.TextureRing().Poll(myView))
+    framePublished();
+
+  return myRenderThread.TextureRing().HasPending();
+}
+
+// ================================================================
+// Function : framePublished
+// ================================================================
+void OcctQOpenGLWidgetViewer::framePublished()
+{
+  myFrameTimings.FramePresented();
+  QMetaObject::invokeMethod(this, "handleFramePublished", Qt::QueuedConnection);
+}
+
+// ================================================================
+// Function : ReleaseGl
+// ================================================================
+void OcctQOpenGLWidgetViewer::ReleaseGl()
+{
+  myRenderThread.TextureRing().Release(myView);
+
+  // hold on X11 display connection till making another connection active by glXMakeCurrent()
+  Handle(Aspect_DisplayConnection) aDisp = myViewer->Driver()->GetDisplayConnection();
+
+  // release OCCT view while its OpenGL context is current
+  myFrameCapture.Release(OcctGlTools::GetGlContext(myView));
+  myResolutionScaler.Release(myView);
+  mySharedViewer->RemoveView(myView);
+  myContext.Nullify();
+  myView.Nullify();
+  myViewer.Nullify();
+  mySharedViewer.Nullify();
+  aDisp.Nullify();
+}
+
+// ================================================================
+// Function : flushBuffers
+// ================================================================
+void OcctQOpenGLWidgetViewer::flushBuffers(const Handle(AIS_InteractiveContext)& theCtx,
+                                           const Handle(V3d_View)&               theView)
+{
+  std::lock_guard<std::mutex> anInputLock(myInputMutex);
+  AIS_ViewController::flushBuffers(theCtx, theView);
 }
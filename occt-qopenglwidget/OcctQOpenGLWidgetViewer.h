@@ -3,8 +3,27 @@
 #ifndef _OcctQOpenGLWidgetViewer_HeaderFile
 #define _OcctQOpenGLWidgetViewer_HeaderFile
 
+#include "../occt-qt-tools/OcctAsyncPicker.h"
+#include "../occt-qt-tools/OcctFrameTimings.h"
+#include "../occt-qt-tools/OcctGlInfo.h"
+#include "../occt-qt-tools/OcctHoverThrottle.h"
+#include "../occt-qt-tools/OcctInputLatency.h"
+#include "../occt-qt-tools/OcctInputPredictor.h"
+#include "../occt-qt-tools/OcctInteractionLod.h"
+#include "../occt-qt-tools/OcctQtFrameCapture.h"
+#include "../occt-qt-tools/OcctQtFrameRecorder.h"
+#include "../occt-qt-tools/OcctQtFrameScheduler.h"
+#include "../occt-qt-tools/OcctQtInputAccumulator.h"
+#include "../occt-qt-tools/OcctQtModelLoader.h"
+#include "../occt-qt-tools/OcctQtRenderThread.h"
+#include "../occt-qt-tools/OcctResolutionScaler.h"
+#include "../occt-qt-tools/OcctSharedViewer.h"
+#include "../occt-qt-tools/OcctViewCommandQueue.h"
+
 #include <Standard_WarningsDisable.hxx>
+#include <QOpenGLTextureBlitter>
 #include <QOpenGLWidget>
+#include <QTimer>
 #include <Standard_WarningsRestore.hxx>
 
 #include <AIS_InteractiveContext.hxx>
@@ -12,6 +31,9 @@
 #include <V3d_View.hxx>
 #include <Standard_Version.hxx>
 
+#include <atomic>
+#include <mutex>
+
 class AIS_ViewCube;
 
 //! OpenGL Qt widget holding OCCT 3D View.
@@ -22,13 +44,31 @@ class AIS_ViewCube;
 //! Inheritance from AIS_ViewController is used to translate
 //! user input events (mouse, keyboard, window resize, etc.)
 //! to 3D Viewer (panning, rotation, zooming, etc.).
-class OcctQOpenGLWidgetViewer : public QOpenGLWidget, public AIS_ViewController
+//!
+//! Optionally (SetThreadedRendering()), OCCT renders on a dedicated thread (OcctQtRenderThread)
+//! within its own OpenGL context sharing resources with widget's context, and paintGL() only blits
+//! the newest completed texture - so that GUI thread is not blocked by a heavy frame.
+//! View and scene should be then modified only through PushViewCommand().
+//!
+//! QOpenGLWidget calls paintGL() also for reasons unrelated to the 3D scene (repainting of overlay widgets, expose events).
+//! Unless the frame has been requested by the viewer itself (updateView()) or the camera or the view
+//! have been modified since, paintGL() returns early leaving the previous OCCT frame
+//! preserved by QOpenGLWidget::PartialUpdate in widget's framebuffer (SetFrameReuse()).
+class OcctQOpenGLWidgetViewer : public QOpenGLWidget, public AIS_ViewController, private OcctQtRenderThread::Renderer
 {
   Q_OBJECT
 public:
-  //! Main constructor.
+  //! Main constructor creating own viewer.
   OcctQOpenGLWidgetViewer(QWidget* theParent = nullptr);
 
+  //! Constructor creating a new view of the viewer shared with other widgets.
+  //! @param[in] theSharedViewer  viewer created by CreateSharedViewer() or taken from another widget
+  //! @param[in] theParent        parent widget
+  OcctQOpenGLWidgetViewer(const Handle(OcctSharedViewer)& theSharedViewer, QWidget* theParent = nullptr);
+
+  //! Create graphic driver and viewer to be shared by several widgets.
+  static Handle(OcctSharedViewer) CreateSharedViewer();
+
   //! Destructor.
   virtual ~OcctQOpenGLWidgetViewer();
 
@@ -41,8 +81,94 @@ public:
   //! Return AIS context.
   const Handle(AIS_InteractiveContext)& Context() const { return myContext; }
 
-  //! Return OpenGL info.
-  const QString& getGlInfo() const { return myGlInfo; }
+  //! Return viewer shared with other widgets.
+  const Handle(OcctSharedViewer)& SharedViewer() const { return mySharedViewer; }
+
+  //! Return TRUE if OCCT renders on a dedicated thread.
+  bool IsThreadedRendering() const { return myIsThreaded; }
+
+  //! Enable rendering of OCCT on a dedicated thread; should be called before showing the widget.
+  //! Not supported for a viewer shared with other widgets.
+  //! @return FALSE if option cannot be changed
+  bool SetThreadedRendering(bool theToEnable);
+
+  //! Queue command modifying the view or the scene, to be executed right before the next redraw
+  //! (by OCCT thread in threaded mode, or within paintGL() otherwise).
+  void PushViewCommand(const OcctViewCommandQueue::Command& theCommand);
+
+  //! Return TRUE if paintGL() keeps the previous frame in widget's framebuffer when nothing has changed; TRUE by default.
+  bool IsFrameReuse() const { return myToReuseFrame; }
+
+  //! Enable/disable reusing of the previous frame (not applicable to threaded mode, which always blits the last texture).
+  void SetFrameReuse(bool theToReuse)
+  {
+    myToReuseFrame = theToReuse;
+    myHasLastFrame = false;
+  }
+
+  //! Return number of paintGL() calls keeping the previous frame instead of redrawing.
+  uint64_t NbReusedFrames() const { return myNbReusedFrames; }
+
+  //! Return statistics of texture ring (rendered, displayed and dropped OCCT frames) in threaded mode.
+  OcctGlTextureRing::Stats TextureRingStats() const { return myRenderThread.TextureRing().Statistics(); }
+
+  //! Return OpenGL info; complete info (including extensions) is fetched on first request.
+  QString getGlInfo();
+
+  //! Return frame scheduler.
+  OcctQtFrameScheduler& FrameScheduler() { return myFrameScheduler; }
+
+  //! Return model loader.
+  OcctQtModelLoader& ModelLoader() { return myModelLoader; }
+
+  //! Return interaction level-of-detail controller.
+  OcctInteractionLod& InteractionLod() { return myInteractionLod; }
+
+  //! Return dynamic highlighting throttle.
+  OcctHoverThrottle& HoverThrottle() { return myHoverThrottle; }
+
+  //! Return dynamic resolution controller.
+  OcctResolutionScaler& ResolutionScaler() { return myResolutionScaler; }
+
+  //! Return per-phase frame timings.
+  const OcctFrameTimings& FrameTimings() const { return myFrameTimings; }
+
+  //! Return input-to-photon latency histogram of mouse and touch events.
+  OcctInputLatency& InputLatency() { return myInputLatency; }
+
+  //! Return predictor extrapolating dragged pointers to expected presentation time.
+  OcctInputPredictor& InputPredictor() { return myInputPredictor; }
+
+  //! Return asynchronous frame capture; requests should be pushed from GUI thread
+  //! and are fulfilled one or two frames later.
+  OcctQtFrameCapture& FrameCapture() { return myFrameCapture; }
+
+  //! Return video recorder.
+  const OcctQtFrameRecorder& FrameRecorder() const { return myFrameRecorder; }
+
+  //! Start recording of rendered frames into video file;
+  //! frames are read back asynchronously and encoded on a dedicated thread.
+  bool StartRecording(const OcctQtFrameRecorder::Params& theParams);
+
+  //! Stop video recording, waiting for queued frames to be encoded.
+  void StopRecording();
+
+  //! Return asynchronous picker.
+  OcctAsyncPicker& Picker() { return mySharedViewer->Picker(); }
+
+  //! Pick objects under the point asynchronously; callback is called from paintGL() (or OCCT thread) once traversal is done.
+  //! @param[in] thePnt       point in view pixels (device pixels)
+  //! @param[in] theCallback  result callback
+  //! @return request identifier
+  int PickAt(const Graphic3d_Vec2i& thePnt, const OcctAsyncPicker::Callback& theCallback);
+
+  //! Pick objects within rectangle asynchronously; callback is called from paintGL() (or OCCT thread) once traversal is done.
+  //! @return request identifier
+  int PickRect(const Graphic3d_Vec2i& thePnt1, const Graphic3d_Vec2i& thePnt2, const OcctAsyncPicker::Callback& theCallback);
+
+  //! Start asynchronous loading of STEP/BREP file replacing displayed shapes;
+  //! parts are displayed progressively as soon as they are meshed.
+  bool OpenModel(const QString& theFilePath);
 
   //! Minimal widget size.
   virtual QSize minimumSizeHint() const override { return QSize(200, 200); }
@@ -57,6 +183,11 @@ public:
                                 const Handle(V3d_View)&,
                                 const Handle(V3d_View)& theNewView) override;
 #endif
+
+  //! Propagate selection change to other views of shared viewer.
+  virtual void OnSelectionChanged(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView) override;
+
 protected: // OpenGL events
   virtual void initializeGL() override;
   virtual void paintGL() override;
@@ -71,17 +202,75 @@ protected: // user input events
   virtual void mouseMoveEvent(QMouseEvent* theEvent) override;
   virtual void wheelEvent(QWheelEvent* theEvent) override;
 
+private slots:
+  //! Request the new frame from OCCT thread (GUI thread).
+  void requestOcctFrame();
+
+  //! Show the newest published frame (GUI thread).
+  void handleFramePublished();
+
+  //! Show error message and exit (GUI thread).
+  void handleCriticalError(const QString& theMsg);
+
+private: //! @name OcctQtRenderThread::Renderer interface (OCCT thread)
+  //! Redraw the view into the next texture of the ring.
+  virtual void RenderFrame(const OcctQtRenderThread::FrameRequest& theRequest) override;
+
+  //! Publish frames completed by GPU.
+  virtual bool PollFrames() override;
+
+  //! Release OCCT view.
+  virtual void ReleaseGl() override;
+
 private:
-  //! Dump OpenGL info.
-  void dumpGlInfo(bool theIsBasic, bool theToPrint);
+  //! Fetch and print basic OpenGL info of new OpenGL context.
+  void dumpGlInfo();
 
-  //! Request widget paintGL() event.
+  //! Request widget paintGL() event (or OCCT frame) through frame scheduler;
+  //! might be called from OCCT thread.
   void updateView();
 
+  //! Execute queued commands, display loaded parts, flush input events and redraw the view;
+  //! common part of paintGL() and OCCT thread frame.
+  void redrawView();
+
+  //! Blit the newest OCCT frame into widget's framebuffer (threaded mode).
+  void paintTexture();
+
+  //! Return TRUE if widget's framebuffer still holds the previous frame and nothing has changed since.
+  //! @param[in] theFboSize  widget's framebuffer size
+  bool isLastFrameValid(const Graphic3d_Vec2i& theFboSize);
+
+  //! Initialize OCCT view for OCCT thread OpenGL context (OCCT thread).
+  bool initializeThreadedGL(const Graphic3d_Vec2i& theSize, double theDevPixelRatio);
+
+  //! Notify GUI thread about new published frame (OCCT thread).
+  void framePublished();
+
+  //! Lock input buffers while they are flushed by OCCT thread.
+  virtual void flushBuffers(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
+
   //! Handle view redraw.
   virtual void handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
 
+  //! Perform dynamic highlighting unless skipped or postponed by hover throttle.
+  virtual void contextLazyMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theView,
+                                 const Graphic3d_Vec2i& thePnt) override;
+
+  //! Handle selection tools; rubber-band selection is picked asynchronously.
+  virtual void handleSelectionPoly(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
+
+  //! Pick point for zooming at cursor or rotation around picked point,
+  //! traversing the main selector under the same lock as asynchronous picking.
+  virtual bool PickPoint(gp_Pnt& thePnt,
+                         const Handle(AIS_InteractiveContext)& theCtx,
+                         const Handle(V3d_View)& theView,
+                         const Graphic3d_Vec2i& theCursor,
+                         bool theToStickToPickRay) override;
+
 private:
+  Handle(OcctSharedViewer)       mySharedViewer;
   Handle(V3d_Viewer)             myViewer;
   Handle(V3d_View)               myView;
   Handle(AIS_InteractiveContext) myContext;
@@ -89,8 +278,40 @@ private:
 
   Handle(V3d_View) myFocusView;
 
-  QString myGlInfo;
-  bool    myHasTouchInput = false;
+  OcctQtInputAccumulator myInputAccum;
+  OcctQtFrameScheduler   myFrameScheduler;
+  OcctQtModelLoader      myModelLoader;
+  OcctInteractionLod     myInteractionLod;
+  OcctHoverThrottle      myHoverThrottle;
+  OcctResolutionScaler   myResolutionScaler;
+  OcctFrameTimings       myFrameTimings;
+  OcctInputLatency       myInputLatency;
+  OcctInputPredictor     myInputPredictor;
+  OcctQtFrameRecorder    myFrameRecorder; //!< video recorder fed by frame capture (should outlive it)
+  OcctQtFrameCapture     myFrameCapture;
+  QTimer                 myLodTimer; //!< timer redrawing the view to restore full quality or to perform postponed highlighting
+  OcctViewCommandQueue   myViewCommands; //!< commands passed from GUI thread to redraw
+  std::mutex             myInputMutex;   //!< lock for AIS_ViewController input buffers
+
+  OcctQtRenderThread       myRenderThread;   //!< OCCT thread and its context (threaded mode)
+  QOpenGLTextureBlitter    myTextureBlitter; //!< blitter of OCCT frames into widget's framebuffer (threaded mode)
+  OcctGlTextureRing::Frame myShownFrame;     //!< the last acquired OCCT frame (threaded mode)
+  uint64_t                 myRequestedBatch = 0; //!< input latency batch passed with the last frame request (threaded mode)
+  uint64_t                 myPublishedBatch = 0; //!< input latency batch reflected by the last published frame (threaded mode)
+  uint64_t                 myShownBatch     = 0; //!< input latency batch reflected by the last acquired frame (threaded mode)
+  double                   myFramePresentTime = 0.0; //!< expected presentation time of frame being rendered (OCCT thread)
+  bool                     myIsThreaded       = false;
+
+  Graphic3d_WorldViewProjState myLastFrameCamState;       //!< camera state of the last OCCT frame (non-threaded mode)
+  Graphic3d_Vec2i              myLastFrameSize;           //!< widget's framebuffer size of the last OCCT frame
+  uint64_t                     myNbReusedFrames = 0;
+  bool                         myToReuseFrame   = true;
+  bool                         myHasLastFrame   = false;  //!< widget's framebuffer holds the last OCCT frame
+  bool                         myToRedrawFrame  = true;   //!< frame has been requested by updateView() since the last redraw
+
+  OcctGlInfo        myGlInfo;
+  std::atomic<bool> myToFetchGlInfo { false }; //!< complete OpenGL info has been requested by GUI thread (threaded mode)
+  bool              myHasTouchInput = false;
 };
 
 #endif // _OcctQOpenGLWidgetViewer_HeaderFile
@@ -10,18 +10,29 @@
 
 #include <Standard_Version.hxx>
 
+#include <cstring>
+
 int main(int theNbArgs, char** theArgVec)
 {
   // before creating QApplication: define platform plugin to load (e.g. xcb on Linux)
   // and graphic driver (e.g. desktop OpenGL with desired profile/surface)
   OcctQtTools::qtGlPlatformSetup();
+
+  // --threaded renders OCCT 3D Viewer on a dedicated thread into a ring of textures
+  bool isThreaded = false;
+  for (int anArgIter = 1; anArgIter < theNbArgs; ++anArgIter)
+  {
+    if (strcmp(theArgVec[anArgIter], "--threaded") == 0)
+      isThreaded = true;
+  }
+
   QApplication aQApp(theNbArgs, theArgVec);
 
   QCoreApplication::setApplicationName("OCCT Qt/QOpenGLWidget Viewer sample");
   QCoreApplication::setOrganizationName("OpenCASCADE");
   QCoreApplication::setApplicationVersion(OCC_VERSION_STRING_EXT);
 
-  OcctQMainWindowSample aMainWindow;
+  OcctQMainWindowSample aMainWindow(isThreaded);
   aMainWindow.resize(aMainWindow.sizeHint());
   aMainWindow.show();
   return aQApp.exec();
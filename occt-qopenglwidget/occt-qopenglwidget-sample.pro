@@ -6,12 +6,50 @@ CONFIG += console
 # source code of the sample
 HEADERS = OcctQMainWindowSample.h \
   OcctQOpenGLWidgetViewer.h \
-  ../occt-qt-tools/OcctQtTools.h
+  ../occt-qt-tools/OcctQtTools.h \
+  ../occt-qt-tools/OcctQtInputAccumulator.h \
+  ../occt-qt-tools/OcctQtFrameScheduler.h \
+  ../occt-qt-tools/OcctQtModelLoader.h \
+  ../occt-qt-tools/OcctTessellator.h \
+  ../occt-qt-tools/OcctQtMeshCache.h \
+  ../occt-qt-tools/OcctInteractionLod.h \
+  ../occt-qt-tools/OcctHoverThrottle.h \
+  ../occt-qt-tools/OcctAsyncPicker.h \
+  ../occt-qt-tools/OcctResolutionScaler.h \
+  ../occt-qt-tools/OcctSharedViewer.h \
+  ../occt-qt-tools/OcctFrameTimings.h \
+  ../occt-qt-tools/OcctInputLatency.h \
+  ../occt-qt-tools/OcctInputPredictor.h \
+  ../occt-qt-tools/OcctGlInfo.h \
+  ../occt-qt-tools/OcctQtFrameCapture.h \
+  ../occt-qt-tools/OcctQtFrameRecorder.h \
+  ../occt-qt-tools/OcctViewCommandQueue.h \
+  ../occt-qt-tools/OcctGlTextureRing.h \
+  ../occt-qt-tools/OcctQtRenderThread.h \
   ../occt-qt-tools/OcctGlTools.h
 SOURCES = main.cpp \
   OcctQMainWindowSample.cpp \
   OcctQOpenGLWidgetViewer.cpp \
   ../occt-qt-tools/OcctQtTools.cpp \
+  ../occt-qt-tools/OcctQtInputAccumulator.cpp \
+  ../occt-qt-tools/OcctQtFrameScheduler.cpp \
+  ../occt-qt-tools/OcctQtModelLoader.cpp \
+  ../occt-qt-tools/OcctTessellator.cpp \
+  ../occt-qt-tools/OcctQtMeshCache.cpp \
+  ../occt-qt-tools/OcctInteractionLod.cpp \
+  ../occt-qt-tools/OcctHoverThrottle.cpp \
+  ../occt-qt-tools/OcctAsyncPicker.cpp \
+  ../occt-qt-tools/OcctResolutionScaler.cpp \
+  ../occt-qt-tools/OcctSharedViewer.cpp \
+  ../occt-qt-tools/OcctFrameTimings.cpp \
+  ../occt-qt-tools/OcctInputLatency.cpp \
+  ../occt-qt-tools/OcctInputPredictor.cpp \
+  ../occt-qt-tools/OcctGlInfo.cpp \
+  ../occt-qt-tools/OcctQtFrameCapture.cpp \
+  ../occt-qt-tools/OcctQtFrameRecorder.cpp \
+  ../occt-qt-tools/OcctViewCommandQueue.cpp \
+  ../occt-qt-tools/OcctGlTextureRing.cpp \
+  ../occt-qt-tools/OcctQtRenderThread.cpp \
   ../occt-qt-tools/OcctGlTools.cpp
 OTHER_FILES = ../LICENSE.md\
   ../ReadMe.md \
@@ -46,4 +84,4 @@ win32:LIBS += -lopengl32 -luser32
 exists($$PWD/custom.pri) { include($$PWD/custom.pri) }
 
 # OCCT libraries to link
-LIBS += -lTKernel -lTKGeomBase -lTKGeomAlgo -lTKG2d -lTKV3d -lTKG3d  -lTKHLR -lTKService -lTKMath -lTKBRep -lTKTopAlgo -lTKOpenGl -lTKPrim -lTKShHealing -lTKMesh
+LIBS += -lTKernel -lTKGeomBase -lTKGeomAlgo -lTKG2d -lTKV3d -lTKG3d  -lTKHLR -lTKService -lTKMath -lTKBRep -lTKTopAlgo -lTKOpenGl -lTKPrim -lTKShHealing -lTKMesh -lTKXSBase -lTKSTEPBase -lTKSTEPAttr -lTKSTEP209 -lTKSTEP
@@ -0,0 +1,513 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctAsyncPicker.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <OSD_Timer.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <SelectMgr_ViewerSelector.hxx>
+#include <Standard_Version.hxx>
+#include <V3d_View.hxx>
+
+#if (OCC_VERSION_HEX < 0x070600)
+  #include <StdSelect_ViewerSelector3d.hxx>
+#endif
+
+#include <algorithm>
+
+#if (OCC_VERSION_HEX >= 0x070600)
+//! Selector performing traversal for snapshot of camera instead of V3d_View.
+class OcctAsyncPickSelector : public SelectMgr_ViewerSelector
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctAsyncPickSelector, SelectMgr_ViewerSelector)
+public:
+  //! Fetch Z-layers order of the viewer (rendering thread).
+  void UpdateZLayers(const Handle(V3d_View)& theView) { updateZLayers(theView); }
+
+  //! Traverse sensitives for specified selecting volume (working thread).
+  void PickSnapshot(const Graphic3d_Vec2i& thePnt1,
+                    const Graphic3d_Vec2i& thePnt2,
+                    bool theIsRect,
+                    const Handle(Graphic3d_Camera)& theCamera,
+                    const Handle(Graphic3d_SequenceOfHClipPlane)& theClipPlanes,
+                    const Graphic3d_Vec2i& theWinSize,
+                    int theViewId,
+                    int theTolerance)
+  {
+    if (theIsRect)
+    {
+      const Graphic3d_Vec2i aMin = thePnt1.cwiseMin(thePnt2), aMax = thePnt1.cwiseMax(thePnt2);
+      mySelectingVolumeMgr.InitBoxSelectingVolume(gp_Pnt2d(aMin.x(), aMin.y()), gp_Pnt2d(aMax.x(), aMax.y()));
+    }
+    else
+    {
+      mySelectingVolumeMgr.InitPointSelectingVolume(gp_Pnt2d(thePnt1.x(), thePnt1.y()));
+      mySelectingVolumeMgr.SetPixelTolerance(theTolerance);
+    }
+    mySelectingVolumeMgr.SetCamera(theCamera);
+    mySelectingVolumeMgr.SetWindowSize(theWinSize.x(), theWinSize.y());
+    mySelectingVolumeMgr.BuildSelectingVolume();
+    mySelectingVolumeMgr.SetViewClipping(theClipPlanes, Handle(Graphic3d_SequenceOfHClipPlane)(), nullptr);
+    TraverseSensitives(theViewId);
+  }
+};
+#else
+//! Dummy placeholder - asynchronous traversal is unavailable.
+class OcctAsyncPickSelector : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctAsyncPickSelector, Standard_Transient)
+};
+#endif
+
+namespace
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  //! Copy clipping planes (including chained ones), so that GUI thread might modify originals during picking.
+  static Handle(Graphic3d_SequenceOfHClipPlane) copyClipPlanes(const Handle(Graphic3d_SequenceOfHClipPlane)& thePlanes)
+  {
+    if (thePlanes.IsNull()
+     || thePlanes->IsEmpty())
+    {
+      return Handle(Graphic3d_SequenceOfHClipPlane)();
+    }
+
+    Handle(Graphic3d_SequenceOfHClipPlane) aCopy = new Graphic3d_SequenceOfHClipPlane();
+    aCopy->SetToDisableAll(thePlanes->ToDisableAll());
+    for (Graphic3d_SequenceOfHClipPlane::Iterator aPlaneIter(*thePlanes); aPlaneIter.More(); aPlaneIter.Next())
+    {
+      Handle(Graphic3d_ClipPlane) aPlane = aPlaneIter.Value()->Clone();
+      Handle(Graphic3d_ClipPlane) aLast  = aPlane;
+      for (Handle(Graphic3d_ClipPlane) aNext = aPlaneIter.Value()->ChainNextPlane(); !aNext.IsNull(); aNext = aNext->ChainNextPlane())
+      {
+        Handle(Graphic3d_ClipPlane) aNextCopy = aNext->Clone();
+        aLast->SetChainNextPlane(aNextCopy);
+        aLast = aNextCopy;
+      }
+      aCopy->Append(aPlane);
+    }
+    return aCopy;
+  }
+#endif
+
+  //! Fill result from picked owners of selector.
+  static void fillPickResult(SelectMgr_ViewerSelector& theSelector, OcctAsyncPicker::Result& theResult)
+  {
+    const int aNbPicked = theSelector.NbPicked();
+    theResult.Owners.reserve(aNbPicked);
+    theResult.Points.reserve(aNbPicked);
+    theResult.Depths.reserve(aNbPicked);
+    for (int aPickIter = 1; aPickIter <= aNbPicked; ++aPickIter)
+    {
+      theResult.Owners.push_back(theSelector.Picked(aPickIter));
+      theResult.Points.push_back(theSelector.PickedPoint(aPickIter));
+      theResult.Depths.push_back(theSelector.PickedData(aPickIter).Depth);
+    }
+    // release references to picked owners
+    theSelector.ClearPicked();
+  }
+}
+
+// ================================================================
+// Function : OcctAsyncPicker
+// ================================================================
+OcctAsyncPicker::OcctAsyncPicker()
+: myIsBusy(false)
+{
+  mySelector = new OcctAsyncPickSelector();
+}
+
+// ================================================================
+// Function : ~OcctAsyncPicker
+// ================================================================
+OcctAsyncPicker::~OcctAsyncPicker()
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myToStop = true;
+  }
+  myCondition.notify_all();
+  if (myThread.joinable())
+    myThread.join();
+}
+
+// ================================================================
+// Function : AddView
+// ================================================================
+void OcctAsyncPicker::AddView(const Handle(V3d_View)& theView, const std::function<void()>& theFrameRequester)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myFrameRequesters[theView.get()] = theFrameRequester;
+}
+
+// ================================================================
+// Function : RemoveView
+// ================================================================
+void OcctAsyncPicker::RemoveView(const Handle(V3d_View)& theView)
+{
+  // requesters are called under the lock, so that the view owner might be destroyed right after this call
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myFrameRequesters.erase(theView.get());
+  myPending.erase(std::remove_if(myPending.begin(), myPending.end(),
+                                 [&theView](const Request& theReq) { return theReq.View == theView.get(); }),
+                  myPending.end());
+  myFinished.erase(std::remove_if(myFinished.begin(), myFinished.end(),
+                                  [&theView](const std::pair<Request, Result>& theRes) { return theRes.first.View == theView.get(); }),
+                   myFinished.end());
+}
+
+// ================================================================
+// Function : PickPoint
+// ================================================================
+int OcctAsyncPicker::PickPoint(const Handle(V3d_View)& theView, const Graphic3d_Vec2i& thePoint, const Callback& theCallback)
+{
+  Request aRequest;
+  aRequest.Func = theCallback;
+  aRequest.View = theView.get();
+  aRequest.Pnt1 = thePoint;
+  aRequest.Pnt2 = thePoint;
+  return pushRequest(aRequest);
+}
+
+// ================================================================
+// Function : PickRect
+// ================================================================
+int OcctAsyncPicker::PickRect(const Handle(V3d_View)& theView,
+                              const Graphic3d_Vec2i& thePnt1,
+                              const Graphic3d_Vec2i& thePnt2,
+                              const Callback& theCallback)
+{
+  Request aRequest;
+  aRequest.Func   = theCallback;
+  aRequest.View   = theView.get();
+  aRequest.Pnt1   = thePnt1;
+  aRequest.Pnt2   = thePnt2;
+  aRequest.IsRect = true;
+  return pushRequest(aRequest);
+}
+
+// ================================================================
+// Function : pushRequest
+// ================================================================
+int OcctAsyncPicker::pushRequest(Request& theRequest)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  theRequest.Id = ++myLastId;
+  if (myFrameRequesters.find(theRequest.View) == myFrameRequesters.end())
+    return theRequest.Id; // unknown view - request is never dispatched
+
+  ++myStats.NbRequests;
+  myPending.push_back(theRequest);
+  requestFrames(theRequest.View);
+  return theRequest.Id;
+}
+
+// ================================================================
+// Function : requestFrames
+// ================================================================
+void OcctAsyncPicker::requestFrames(const V3d_View* theView)
+{
+  for (const auto& aViewIter : myFrameRequesters)
+  {
+    bool toRequest = theView == aViewIter.first;
+    if (theView == nullptr)
+    {
+      for (const Request& aReqIter : myPending)
+        toRequest = toRequest || aReqIter.View == aViewIter.first;
+      for (const std::pair<Request, Result>& aResIter : myFinished)
+        toRequest = toRequest || aResIter.first.View == aViewIter.first;
+    }
+    if (toRequest && aViewIter.second)
+      aViewIter.second();
+  }
+}
+
+// ================================================================
+// Function : HasPending
+// ================================================================
+bool OcctAsyncPicker::HasPending() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return !myPending.empty() || !myFinished.empty() || myIsBusy.load();
+}
+
+// ================================================================
+// Function : Statistics
+// ================================================================
+OcctAsyncPicker::Stats OcctAsyncPicker::Statistics() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return myStats;
+}
+
+// ================================================================
+// Function : Perform
+// ================================================================
+void OcctAsyncPicker::Perform(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)
+{
+  // deliver results of this view within rendering thread
+  std::vector<std::pair<Request, Result>> aFinished;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    for (auto aResIter = myFinished.begin(); aResIter != myFinished.end();)
+    {
+      if (aResIter->first.View != theView.get())
+      {
+        ++aResIter;
+        continue;
+      }
+
+      aFinished.push_back(*aResIter);
+      aResIter = myFinished.erase(aResIter);
+    }
+  }
+  for (const std::pair<Request, Result>& aResIter : aFinished)
+  {
+    if (aResIter.first.Func)
+      aResIter.first.Func(aResIter.second);
+  }
+
+  if (myIsBusy.load()
+   || theCtx.IsNull()
+   || theView.IsNull()
+   || theView->Window().IsNull())
+  {
+    return;
+  }
+
+  Request aRequest;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    auto aReqIter = std::find_if(myPending.begin(), myPending.end(),
+                                 [&theView](const Request& theReq) { return theReq.View == theView.get(); });
+    if (aReqIter == myPending.end())
+      return;
+
+    aRequest = *aReqIter;
+    myPending.erase(aReqIter);
+  }
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  syncSelector(theCtx, theView);
+
+  Job aJob;
+  aJob.Req        = aRequest;
+  aJob.Camera     = new Graphic3d_Camera(theView->Camera());
+  aJob.ClipPlanes = copyClipPlanes(theView->ClipPlanes());
+  aJob.ViewId     = theView->View()->Identification();
+  aJob.Tolerance  = theCtx->PixelTolerance();
+  theView->Window()->Size(aJob.WinSize.x(), aJob.WinSize.y());
+
+  myIsBusy = true;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myJob    = aJob;
+    myHasJob = true;
+  }
+  if (!myThread.joinable())
+    myThread = std::thread([this]() { pickLoop(); });
+
+  myCondition.notify_one();
+#else
+  pickSync(aRequest, theCtx, theView);
+#endif
+}
+
+#if (OCC_VERSION_HEX >= 0x070600)
+// ================================================================
+// Function : ApplySelection
+// ================================================================
+void OcctAsyncPicker::ApplySelection(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Result& theResult,
+                                     AIS_SelectionScheme theScheme)
+{
+  if (theResult.Owners.empty())
+  {
+    if (theScheme == AIS_SelectionScheme_Replace
+     || theScheme == AIS_SelectionScheme_ReplaceExtra
+     || theScheme == AIS_SelectionScheme_Clear)
+    {
+      theCtx->ClearSelected(false);
+    }
+    return;
+  }
+
+  AIS_NArray1OfEntityOwner anOwners(1, int(theResult.Owners.size()));
+  int anOwnerIndex = 1;
+  for (const Handle(SelectMgr_EntityOwner)& anOwnerIter : theResult.Owners)
+    anOwners.SetValue(anOwnerIndex++, anOwnerIter);
+
+  theCtx->Select(anOwners, theScheme);
+}
+#endif
+
+// ================================================================
+// Function : pickSync
+// ================================================================
+void OcctAsyncPicker::pickSync(const Request& theRequest,
+                               const Handle(AIS_InteractiveContext)& theCtx,
+                               const Handle(V3d_View)& theView)
+{
+  const auto& aSelector = theCtx->MainSelector();
+  Result aResult;
+  aResult.RequestId = theRequest.Id;
+  aResult.IsRect    = theRequest.IsRect;
+
+  OSD_Timer aTimer;
+  aTimer.Start();
+  {
+    std::lock_guard<std::mutex> aSelLock(mySelectionMutex);
+    if (theRequest.IsRect)
+    {
+      const Graphic3d_Vec2i aMin = theRequest.Pnt1.cwiseMin(theRequest.Pnt2), aMax = theRequest.Pnt1.cwiseMax(theRequest.Pnt2);
+      aSelector->Pick(aMin.x(), aMin.y(), aMax.x(), aMax.y(), theView);
+    }
+    else
+    {
+      aSelector->Pick(theRequest.Pnt1.x(), theRequest.Pnt1.y(), theView);
+    }
+    fillPickResult(*aSelector, aResult);
+  }
+  aResult.PickTime = aTimer.ElapsedTime();
+
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    ++myStats.NbSyncPicks;
+  }
+  pushResult(theRequest, aResult); // result is delivered by the next frame
+}
+
+// ================================================================
+// Function : syncSelector
+// ================================================================
+void OcctAsyncPicker::syncSelector(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  mySelector->UpdateZLayers(theView);
+  mySelector->SetPixelTolerance(theCtx->PixelTolerance());
+
+  // mirror only objects, which activated selections have been changed
+  ++mySyncStamp;
+  uint64_t aNbSyncs = 0;
+  AIS_ListOfInteractive anObjects;
+  theCtx->DisplayedObjects(anObjects);
+  std::vector<SelectionKey> aKeys;
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = anObjIter.Value();
+    aKeys.clear();
+    for (SelectMgr_SequenceOfSelection::Iterator aSelIter(anObj->Selections()); aSelIter.More(); aSelIter.Next())
+    {
+      const Handle(SelectMgr_Selection)& aSel = aSelIter.Value();
+      if (aSel->GetSelectionState() != SelectMgr_SOS_Activated)
+        continue;
+
+      SelectionKey aKey;
+      aKey.Selection   = aSel.get();
+      aKey.NbEntities  = aSel->Entities().Size();
+      aKey.FirstEntity = !aSel->Entities().IsEmpty() ? aSel->Entities().First().get() : nullptr;
+      aKeys.push_back(aKey);
+    }
+
+    MirroredObject& aMirror = myMirrored[anObj.get()];
+    aMirror.Stamp = mySyncStamp;
+    if (!aMirror.Object.IsNull())
+    {
+      if (aMirror.Selections == aKeys)
+        continue;
+
+      mySelector->RemoveSelectableObject(anObj);
+    }
+
+    ++aNbSyncs;
+    aMirror.Object     = anObj;
+    aMirror.Selections = aKeys;
+    if (aKeys.empty())
+      continue;
+
+    mySelector->AddSelectableObject(anObj);
+    for (SelectMgr_SequenceOfSelection::Iterator aSelIter(anObj->Selections()); aSelIter.More(); aSelIter.Next())
+    {
+      if (aSelIter.Value()->GetSelectionState() == SelectMgr_SOS_Activated)
+        mySelector->AddSelectionToObject(anObj, aSelIter.Value());
+    }
+  }
+
+  // forget erased objects
+  for (auto anObjIter = myMirrored.begin(); anObjIter != myMirrored.end();)
+  {
+    if (anObjIter->second.Stamp == mySyncStamp)
+    {
+      ++anObjIter;
+      continue;
+    }
+
+    ++aNbSyncs;
+    mySelector->RemoveSelectableObject(anObjIter->second.Object);
+    anObjIter = myMirrored.erase(anObjIter);
+  }
+
+  // objects might be moved since the last pick
+  mySelector->RebuildObjectsTree();
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myStats.NbSyncs += aNbSyncs;
+#else
+  (void )theCtx;
+  (void )theView;
+#endif
+}
+
+// ================================================================
+// Function : pickLoop
+// ================================================================
+void OcctAsyncPicker::pickLoop()
+{
+  for (;;)
+  {
+    Job aJob;
+    {
+      std::unique_lock<std::mutex> aLock(myMutex);
+      myCondition.wait(aLock, [this]() { return myToStop || myHasJob; });
+      if (myToStop)
+        break;
+
+      aJob = myJob;
+      myJob = Job();
+      myHasJob = false;
+    }
+
+    Result aResult;
+    aResult.RequestId = aJob.Req.Id;
+    aResult.IsRect    = aJob.Req.IsRect;
+#if (OCC_VERSION_HEX >= 0x070600)
+    OSD_Timer aTimer;
+    aTimer.Start();
+    {
+      std::lock_guard<std::mutex> aSelLock(mySelectionMutex);
+      mySelector->PickSnapshot(aJob.Req.Pnt1, aJob.Req.Pnt2, aJob.Req.IsRect,
+                               aJob.Camera, aJob.ClipPlanes, aJob.WinSize, aJob.ViewId, aJob.Tolerance);
+      fillPickResult(*mySelector, aResult);
+    }
+    aResult.PickTime = aTimer.ElapsedTime();
+#endif
+    myIsBusy = false;
+    pushResult(aJob.Req, aResult); // deliver result and dispatch the next request
+  }
+}
+
+// ================================================================
+// Function : pushResult
+// ================================================================
+void OcctAsyncPicker::pushResult(const Request& theRequest, const Result& theResult)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  ++myStats.NbPicks;
+  myStats.LastPickTime = theResult.PickTime;
+  myStats.MaxPickTime  = std::max(myStats.MaxPickTime, theResult.PickTime);
+  if (myFrameRequesters.find(theRequest.View) != myFrameRequesters.end())
+    myFinished.push_back(std::make_pair(theRequest, theResult));
+
+  // wake up the view of this result and views waiting for the working thread
+  requestFrames(nullptr);
+}
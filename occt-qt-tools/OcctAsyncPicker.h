@@ -0,0 +1,222 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctAsyncPicker_HeaderFile
+#define _OcctAsyncPicker_HeaderFile
+
+#include <Graphic3d_SequenceOfHClipPlane.hxx>
+#include <Graphic3d_Vec2.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <Standard_Handle.hxx>
+#include <Standard_Version.hxx>
+#include <gp_Pnt.hxx>
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  #include <AIS_SelectionScheme.hxx>
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class AIS_InteractiveContext;
+class Graphic3d_Camera;
+class OcctAsyncPickSelector;
+class SelectMgr_SelectableObject;
+class SelectMgr_Selection;
+class V3d_View;
+
+//! Asynchronous picking performing selector BVH traversal on a working thread.
+//!
+//! Requests might be pushed from any thread. Perform() should be called from the rendering thread at every frame
+//! of each registered view: it delivers finished results of this view and dispatches the next request of this view
+//! to the working thread together with a snapshot of camera and viewport size, so that rendering never waits for traversal.
+//!
+//! One picker should be used for all views of the same interactive context (see OcctSharedViewer),
+//! as their traversals share the same sensitive entities.
+//!
+//! Working thread traverses its own selector mirroring objects activated in the main selector of interactive context.
+//! Sensitive entities are shared with the main selector, hence any traversal of the main selector on rendering thread
+//! (dynamic highlighting, click selection, picking of point for zoom or rotation) should be serialized through SelectionMutex();
+//! hover detection might try-lock it to be postponed instead of waiting.
+//! Objects should not be moved or recomputed while traversal is in flight - changes are mirrored before the next pick.
+//!
+//! Asynchronous traversal requires OCCT 7.6.0+; picking is performed synchronously within Perform() for older versions.
+class OcctAsyncPicker
+{
+public:
+  //! Picking result.
+  struct Result
+  {
+    int                                        RequestId = 0;
+    bool                                       IsRect    = false;
+    std::vector<Handle(SelectMgr_EntityOwner)> Owners;   //!< picked owners sorted by depth
+    std::vector<gp_Pnt>                        Points;   //!< picked points (for point picking)
+    std::vector<double>                        Depths;   //!< depths of picked owners
+    double                                     PickTime = 0.0; //!< traversal time in seconds
+  };
+
+  //! Callback receiving picking result (rendering thread, so that it might modify interactive context).
+  typedef std::function<void(const Result& theResult)> Callback;
+
+  //! Picking statistics.
+  struct Stats
+  {
+    uint64_t NbRequests   = 0;   //!< number of requests
+    uint64_t NbPicks      = 0;   //!< number of finished picks
+    uint64_t NbSyncPicks  = 0;   //!< number of picks performed on rendering thread (old OCCT)
+    uint64_t NbSyncs      = 0;   //!< number of objects (re)mirrored into picking selector
+    double   LastPickTime = 0.0; //!< traversal time of the last pick in seconds
+    double   MaxPickTime  = 0.0; //!< maximum traversal time in seconds
+  };
+
+public:
+  //! Empty constructor.
+  OcctAsyncPicker();
+
+  //! Destructor, waiting for the working thread.
+  ~OcctAsyncPicker();
+
+  //! Register the view.
+  //! @param[in] theView            view to pick
+  //! @param[in] theFrameRequester  function requesting a new frame of the view to be rendered;
+  //!                               called on new requests and from the working thread once traversal is done
+  void AddView(const Handle(V3d_View)& theView, const std::function<void()>& theFrameRequester);
+
+  //! Unregister the view; its pending requests and undelivered results are discarded.
+  void RemoveView(const Handle(V3d_View)& theView);
+
+  //! Request picking of the point.
+  //! @param[in] theView      registered view to pick
+  //! @param[in] thePoint     point in view pixels
+  //! @param[in] theCallback  result callback
+  //! @return request identifier
+  int PickPoint(const Handle(V3d_View)& theView, const Graphic3d_Vec2i& thePoint, const Callback& theCallback);
+
+  //! Request picking of the rectangle.
+  //! @param[in] theView      registered view to pick
+  //! @param[in] thePnt1      first rectangle corner in view pixels
+  //! @param[in] thePnt2      second rectangle corner in view pixels
+  //! @param[in] theCallback  result callback
+  //! @return request identifier
+  int PickRect(const Handle(V3d_View)& theView,
+               const Graphic3d_Vec2i& thePnt1,
+               const Graphic3d_Vec2i& thePnt2,
+               const Callback& theCallback);
+
+  //! Return TRUE if there are requests waiting for traversal, traversal in flight or undelivered results.
+  bool HasPending() const;
+
+  //! Return TRUE if traversal is in flight.
+  bool IsBusy() const { return myIsBusy.load(); }
+
+  //! Return mutex guarding traversal of selection structures.
+  std::mutex& SelectionMutex() { return mySelectionMutex; }
+
+  //! Return picking statistics.
+  Stats Statistics() const;
+
+  //! Deliver finished results of the view and dispatch its next request (rendering thread).
+  void Perform(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView);
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  //! Apply picked owners to selection of interactive context (rendering thread).
+  static void ApplySelection(const Handle(AIS_InteractiveContext)& theCtx,
+                             const Result& theResult,
+                             AIS_SelectionScheme theScheme);
+#endif
+
+private:
+  //! Picking request.
+  struct Request
+  {
+    Callback        Func;
+    const V3d_View* View = nullptr;
+    Graphic3d_Vec2i Pnt1;
+    Graphic3d_Vec2i Pnt2;
+    int             Id     = 0;
+    bool            IsRect = false;
+  };
+
+  //! Request with snapshot of view parameters passed to the working thread.
+  struct Job
+  {
+    Request                  Req;
+    Handle(Graphic3d_Camera) Camera;
+    Handle(Graphic3d_SequenceOfHClipPlane) ClipPlanes; //!< copy of view clipping planes
+    Graphic3d_Vec2i          WinSize;
+    int                      ViewId    = -1;
+    int                      Tolerance = 2;
+  };
+
+  //! Activated selection of mirrored object.
+  struct SelectionKey
+  {
+    const SelectMgr_Selection* Selection   = nullptr;
+    const void*                FirstEntity = nullptr;
+    int                        NbEntities  = 0;
+
+    bool operator==(const SelectionKey& theOther) const
+    {
+      return Selection   == theOther.Selection
+          && FirstEntity == theOther.FirstEntity
+          && NbEntities  == theOther.NbEntities;
+    }
+  };
+
+  //! Object mirrored into picking selector.
+  struct MirroredObject
+  {
+    Handle(SelectMgr_SelectableObject) Object;
+    std::vector<SelectionKey>          Selections;
+    uint64_t                           Stamp = 0;
+  };
+
+private:
+  //! Push new request.
+  int pushRequest(Request& theRequest);
+
+  //! Mirror activated objects of the main selector into picking selector (rendering thread, working thread is idle).
+  void syncSelector(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView);
+
+  //! Working thread procedure.
+  void pickLoop();
+
+  //! Perform picking synchronously with the main selector (rendering thread).
+  void pickSync(const Request& theRequest,
+                const Handle(AIS_InteractiveContext)& theCtx,
+                const Handle(V3d_View)& theView);
+
+  //! Put result into the list of finished ones.
+  void pushResult(const Request& theRequest, const Result& theResult);
+
+  //! Request frames of the view, or of all views having pending requests or results for NULL (myMutex should be locked).
+  void requestFrames(const V3d_View* theView);
+
+private:
+  mutable std::mutex      myMutex;          //!< guards requests, job and results
+  std::condition_variable myCondition;
+  std::thread             myThread;
+  std::mutex              mySelectionMutex; //!< guards traversal of shared sensitive entities
+  std::deque<Request>     myPending;        //!< requests waiting for dispatch
+  std::vector<std::pair<Request, Result>> myFinished; //!< results waiting for delivery
+  std::unordered_map<const V3d_View*, std::function<void()>> myFrameRequesters; //!< registered views
+  Job                     myJob;
+  bool                    myHasJob = false;
+  bool                    myToStop = false;
+  std::atomic<bool>       myIsBusy;
+  Stats                   myStats;
+  int                     myLastId = 0;
+
+  // rendering thread state
+  Handle(OcctAsyncPickSelector) mySelector;
+  std::unordered_map<const SelectMgr_SelectableObject*, MirroredObject> myMirrored;
+  uint64_t                      mySyncStamp = 0;
+};
+
+#endif // _OcctAsyncPicker_HeaderFile
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctFrameTimings.h"
+
+#include <algorithm>
+
+// ================================================================
+// Function : PhaseName
+// ================================================================
+const char* OcctFrameTimings::PhaseName(OcctFramePhase thePhase)
+{
+  switch (thePhase)
+  {
+    case OcctFramePhase_InitFbo:       return "initFbo";
+    case OcctFramePhase_ResetGlBefore: return "resetGlBefore";
+    case OcctFramePhase_FlushView:     return "flushView";
+    case OcctFramePhase_ResetGlAfter:  return "resetGlAfter";
+    case OcctFramePhase_Composition:   return "composition";
+  }
+  return "";
+}
+
+// ================================================================
+// Function : OcctFrameTimings
+// ================================================================
+OcctFrameTimings::OcctFrameTimings(size_t theCapacity)
+: myCapacity(std::max(theCapacity, size_t(1)))
+{
+  myRing.resize(myCapacity);
+  myClock.Start();
+}
+
+// ================================================================
+// Function : BeginFrame
+// ================================================================
+void OcctFrameTimings::BeginFrame()
+{
+  myCurrent = Record();
+  myCurrent.FrameIndex = myNbFrames;
+  myCurrent.StartTime  = CurrentTime();
+}
+
+// ================================================================
+// Function : AddPhaseTime
+// ================================================================
+void OcctFrameTimings::AddPhaseTime(OcctFramePhase thePhase, double theTime)
+{
+  myCurrent.Phases[thePhase] += theTime;
+}
+
+// ================================================================
+// Function : EndFrame
+// ================================================================
+void OcctFrameTimings::EndFrame()
+{
+  const double anEndTime = CurrentTime();
+  myCurrent.TotalTime = anEndTime - myCurrent.StartTime;
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  myRing[myNextIndex] = myCurrent;
+  myNextIndex = (myNextIndex + 1) % myCapacity;
+  myNbRecords = std::min(myNbRecords + 1, myCapacity);
+  myLastEndTime = anEndTime;
+  ++myNbFrames;
+}
+
+// ================================================================
+// Function : FramePresented
+// ================================================================
+void OcctFrameTimings::FramePresented()
+{
+  const double aTime = CurrentTime();
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  if (myLastEndTime < 0.0 || myNbRecords == 0)
+    return; // presented frame has not been measured (e.g. other Qt content has been redrawn)
+
+  Record& aLast = myRing[(myNextIndex + myCapacity - 1) % myCapacity];
+  aLast.Phases[OcctFramePhase_Composition] = aTime - myLastEndTime;
+  myLastEndTime = -1.0;
+}
+
+// ================================================================
+// Function : LastRecord
+// ================================================================
+bool OcctFrameTimings::LastRecord(Record& theRecord) const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  if (myNbRecords == 0)
+    return false;
+
+  theRecord = myRing[(myNextIndex + myCapacity - 1) % myCapacity];
+  return true;
+}
+
+// ================================================================
+// Function : Records
+// ================================================================
+std::vector<OcctFrameTimings::Record> OcctFrameTimings::Records(size_t theMaxFrames) const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  const size_t aNbFrames = std::min(theMaxFrames, myNbRecords);
+  std::vector<Record> aRecords;
+  aRecords.reserve(aNbFrames);
+  for (size_t aFrameIter = aNbFrames; aFrameIter > 0; --aFrameIter)
+    aRecords.push_back(myRing[(myNextIndex + myCapacity - aFrameIter) % myCapacity]);
+
+  return aRecords;
+}
+
+// ================================================================
+// Function : Average
+// ================================================================
+OcctFrameTimings::Record OcctFrameTimings::Average(size_t theNbFrames) const
+{
+  const std::vector<Record> aRecords = Records(theNbFrames);
+  Record anAverage;
+  if (aRecords.empty())
+    return anAverage;
+
+  for (const Record& aRecIter : aRecords)
+  {
+    anAverage.TotalTime += aRecIter.TotalTime;
+    for (int aPhaseIter = 0; aPhaseIter < OcctFramePhase_NB; ++aPhaseIter)
+      anAverage.Phases[aPhaseIter] += aRecIter.Phases[aPhaseIter];
+  }
+
+  const double aScale = 1.0 / double(aRecords.size());
+  anAverage.FrameIndex = aRecords.back().FrameIndex;
+  anAverage.StartTime  = aRecords.front().StartTime;
+  anAverage.TotalTime *= aScale;
+  for (int aPhaseIter = 0; aPhaseIter < OcctFramePhase_NB; ++aPhaseIter)
+    anAverage.Phases[aPhaseIter] *= aScale;
+
+  return anAverage;
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctFrameTimings_HeaderFile
+#define _OcctFrameTimings_HeaderFile
+
+#include <OSD_Timer.hxx>
+#include <Standard_Mutex.hxx>
+
+#include <cstdint>
+#include <vector>
+
+//! Phases of the frame measured by OcctFrameTimings.
+enum OcctFramePhase
+{
+  OcctFramePhase_InitFbo = 0,   //!< wrapping Qt framebuffer by OcctGlTools::InitializeGlFbo()
+  OcctFramePhase_ResetGlBefore, //!< OcctGlTools::ResetGlStateBeforeOcct()
+  OcctFramePhase_FlushView,     //!< AIS_ViewController::FlushViewEvents() including OCCT redraw
+  OcctFramePhase_ResetGlAfter,  //!< OcctGlTools::ResetGlStateAfterOcct()
+  OcctFramePhase_Composition,   //!< Qt composition and buffer swap after the frame has been rendered
+};
+enum
+{
+  OcctFramePhase_NB = OcctFramePhase_Composition + 1
+};
+
+//! Lightweight per-phase frame timings collected into a ring buffer of per-frame records.
+//!
+//! Frame is measured by the rendering thread between BeginFrame() and EndFrame() (or within FrameSentry scope) with phases
+//! wrapped by PhaseSentry; composition time is measured from EndFrame() till FramePresented().
+//! Records might be read from any thread.
+class OcctFrameTimings
+{
+public:
+  //! Timings of a single frame; times are in seconds.
+  struct Record
+  {
+    uint64_t FrameIndex = 0;   //!< frame index since creation
+    double   StartTime  = 0.0; //!< frame start time since creation
+    double   TotalTime  = 0.0; //!< time between BeginFrame() and EndFrame() (composition is not included)
+    double   Phases[OcctFramePhase_NB] = {}; //!< time of each phase
+  };
+
+  //! Scoped phase timer.
+  class PhaseSentry
+  {
+  public:
+    //! Start measuring phase.
+    PhaseSentry(OcctFrameTimings& theTimings, OcctFramePhase thePhase)
+    : myTimings(theTimings), myPhase(thePhase), myStartTime(theTimings.CurrentTime()) {}
+
+    //! Stop measuring phase.
+    ~PhaseSentry() { myTimings.AddPhaseTime(myPhase, myTimings.CurrentTime() - myStartTime); }
+
+  private:
+    PhaseSentry(const PhaseSentry&) = delete;
+    PhaseSentry& operator=(const PhaseSentry&) = delete;
+
+  private:
+    OcctFrameTimings& myTimings;
+    OcctFramePhase    myPhase;
+    double            myStartTime;
+  };
+
+  //! Scoped frame timer calling BeginFrame() and EndFrame(), so that early returns don't leave the frame open.
+  class FrameSentry
+  {
+  public:
+    //! Begin frame.
+    FrameSentry(OcctFrameTimings& theTimings) : myTimings(theTimings) { myTimings.BeginFrame(); }
+
+    //! End frame.
+    ~FrameSentry() { myTimings.EndFrame(); }
+
+  private:
+    FrameSentry(const FrameSentry&) = delete;
+    FrameSentry& operator=(const FrameSentry&) = delete;
+
+  private:
+    OcctFrameTimings& myTimings;
+  };
+
+  //! Return short phase name.
+  static const char* PhaseName(OcctFramePhase thePhase);
+
+public:
+  //! Main constructor.
+  //! @param[in] theCapacity  number of frames kept in the ring buffer
+  OcctFrameTimings(size_t theCapacity = 240);
+
+  //! Return number of frames kept in the ring buffer.
+  size_t Capacity() const { return myCapacity; }
+
+  //! Return time in seconds since creation.
+  double CurrentTime() const { return myClock.ElapsedTime(); }
+
+  //! Start new frame (rendering thread).
+  void BeginFrame();
+
+  //! Accumulate time of the phase within current frame (rendering thread).
+  void AddPhaseTime(OcctFramePhase thePhase, double theTime);
+
+  //! Finish current frame and put it into the ring buffer (rendering thread).
+  void EndFrame();
+
+  //! Record composition time of the last finished frame once it has been presented.
+  void FramePresented();
+
+  //! Return the most recent frame.
+  //! @return FALSE if no frames have been recorded
+  bool LastRecord(Record& theRecord) const;
+
+  //! Return recorded frames from oldest to newest.
+  //! @param[in] theMaxFrames  maximum number of the most recent frames to return
+  std::vector<Record> Records(size_t theMaxFrames = size_t(-1)) const;
+
+  //! Return timings averaged over the most recent frames.
+  Record Average(size_t theNbFrames) const;
+
+private:
+  mutable Standard_Mutex myMutex;
+  OSD_Timer              myClock;
+  std::vector<Record>    myRing;       //!< ring buffer of finished frames
+  size_t                 myCapacity;
+  size_t                 myNbRecords = 0;
+  size_t                 myNextIndex = 0;
+  Record                 myCurrent;           //!< frame being measured (rendering thread)
+  uint64_t               myNbFrames = 0;
+  double                 myLastEndTime = -1.0; //!< end time of the last frame waiting for presentation
+};
+
+#endif // _OcctFrameTimings_HeaderFile
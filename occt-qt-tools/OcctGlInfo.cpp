@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctGlInfo.h"
+
+#include <Aspect_Window.hxx>
+#include <Graphic3d_Vec2.hxx>
+
+namespace
+{
+  //! Append non-empty dictionary values to the text.
+  static void appendGlInfo(TCollection_AsciiString& theText, const TColStd_IndexedDataMapOfStringString& theDict)
+  {
+    for (TColStd_IndexedDataMapOfStringString::Iterator aValueIter(theDict); aValueIter.More(); aValueIter.Next())
+    {
+      if (!aValueIter.Value().IsEmpty())
+      {
+        if (!theText.IsEmpty())
+          theText += "\n";
+
+        theText += aValueIter.Key() + ": " + aValueIter.Value();
+      }
+    }
+  }
+}
+
+// ================================================================
+// Function : Invalidate
+// ================================================================
+void OcctGlInfo::Invalidate()
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  myInfoDict.Clear();
+  mySizeDict.Clear();
+  myHasBasic    = false;
+  myHasComplete = false;
+}
+
+// ================================================================
+// Function : HasBasic
+// ================================================================
+bool OcctGlInfo::HasBasic() const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  return myHasBasic;
+}
+
+// ================================================================
+// Function : HasComplete
+// ================================================================
+bool OcctGlInfo::HasComplete() const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  return myHasComplete;
+}
+
+// ================================================================
+// Function : UpdateBasic
+// ================================================================
+bool OcctGlInfo::UpdateBasic(const Handle(V3d_View)& theView)
+{
+  if (HasBasic() || theView.IsNull() || theView->Window().IsNull())
+    return false;
+
+  // framebuffer section is size-dependent and replaced by UpdateSize()
+  TColStd_IndexedDataMapOfStringString aDict;
+  theView->DiagnosticInformation(aDict, Graphic3d_DiagnosticInfo(Graphic3d_DiagnosticInfo_Device | Graphic3d_DiagnosticInfo_Limits));
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  myInfoDict = aDict;
+  myHasBasic = true;
+  return true;
+}
+
+// ================================================================
+// Function : UpdateComplete
+// ================================================================
+bool OcctGlInfo::UpdateComplete(const Handle(V3d_View)& theView)
+{
+  if (HasComplete() || theView.IsNull() || theView->Window().IsNull())
+    return false;
+
+  TColStd_IndexedDataMapOfStringString aDict;
+  theView->DiagnosticInformation(aDict, Graphic3d_DiagnosticInfo(Graphic3d_DiagnosticInfo_Complete & ~Graphic3d_DiagnosticInfo_FrameBuffer));
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  myInfoDict    = aDict;
+  myHasBasic    = true;
+  myHasComplete = true;
+  return true;
+}
+
+// ================================================================
+// Function : UpdateSize
+// ================================================================
+bool OcctGlInfo::UpdateSize(const Handle(V3d_View)& theView)
+{
+  if (theView.IsNull() || theView->Window().IsNull())
+    return false;
+
+  Graphic3d_Vec2i aSize;
+  theView->Window()->Size(aSize.x(), aSize.y());
+  const TCollection_AsciiString aSizeStr  = TCollection_AsciiString(aSize.x()) + "x" + aSize.y();
+  const TCollection_AsciiString aRatioStr = TCollection_AsciiString(theView->Window()->DevicePixelRatio());
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  if (mySizeDict.Size() == 2
+   && mySizeDict.FindFromIndex(1) == aSizeStr
+   && mySizeDict.FindFromIndex(2) == aRatioStr)
+  {
+    return false;
+  }
+
+  mySizeDict.Clear();
+  mySizeDict.Add("Window size", aSizeStr);
+  mySizeDict.Add("Device pixel ratio", aRatioStr);
+  return true;
+}
+
+// ================================================================
+// Function : Text
+// ================================================================
+TCollection_AsciiString OcctGlInfo::Text() const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  TCollection_AsciiString anInfo;
+  appendGlInfo(anInfo, myInfoDict);
+  appendGlInfo(anInfo, mySizeDict);
+  return anInfo;
+}
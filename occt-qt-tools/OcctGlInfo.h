@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctGlInfo_HeaderFile
+#define _OcctGlInfo_HeaderFile
+
+#include <Standard_Mutex.hxx>
+#include <TColStd_IndexedDataMapOfStringString.hxx>
+#include <V3d_View.hxx>
+
+//! Cached OpenGL diagnostic information of 3D View.
+//!
+//! Basic information (device and limits) is fetched once per OpenGL context,
+//! size-dependent fields are taken from the view window without GL queries,
+//! while complete information (including the list of extensions) is fetched only on demand.
+//! Update methods should be called from the rendering thread; Text() might be called from any thread.
+class OcctGlInfo
+{
+public:
+  //! Empty constructor.
+  OcctGlInfo() {}
+
+  //! Reset cached information; should be called on OpenGL context (re)initialization.
+  void Invalidate();
+
+  //! Return TRUE if basic information has been fetched.
+  bool HasBasic() const;
+
+  //! Return TRUE if complete information has been fetched.
+  bool HasComplete() const;
+
+  //! Fetch basic information, if not done yet (involves GL queries).
+  //! @return TRUE if information has been fetched by this call
+  bool UpdateBasic(const Handle(V3d_View)& theView);
+
+  //! Fetch complete information, if not done yet (involves querying GL extensions).
+  //! @return TRUE if information has been fetched by this call
+  bool UpdateComplete(const Handle(V3d_View)& theView);
+
+  //! Update size-dependent fields from the view window (cheap, no GL queries).
+  //! @return TRUE if fields have been changed
+  bool UpdateSize(const Handle(V3d_View)& theView);
+
+  //! Return formatted "key: value" lines: complete information when fetched (or basic one),
+  //! followed by size-dependent fields.
+  TCollection_AsciiString Text() const;
+
+private:
+  mutable Standard_Mutex               myMutex;
+  TColStd_IndexedDataMapOfStringString myInfoDict; //!< basic or complete information
+  TColStd_IndexedDataMapOfStringString mySizeDict; //!< size-dependent fields
+  bool                                 myHasBasic    = false;
+  bool                                 myHasComplete = false;
+};
+
+#endif // _OcctGlInfo_HeaderFile
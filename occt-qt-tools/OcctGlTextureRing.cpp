@@ -0,0 +1,356 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+#include <OpenGl_Texture.hxx>
+
+#include "OcctGlTextureRing.h"
+
+#include "OcctGlTools.h"
+
+#include <Standard_Version.hxx>
+
+#include <algorithm>
+
+// ================================================================
+// Function : OcctGlTextureRing
+// ================================================================
+OcctGlTextureRing::OcctGlTextureRing(int theNbBuffers)
+: mySlots(std::max(theNbBuffers, 3))
+{
+  //
+}
+
+// ================================================================
+// Function : ~OcctGlTextureRing
+// ================================================================
+OcctGlTextureRing::~OcctGlTextureRing()
+{
+  //
+}
+
+// ================================================================
+// Function : Statistics
+// ================================================================
+OcctGlTextureRing::Stats OcctGlTextureRing::Statistics() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return myStats;
+}
+
+// ================================================================
+// Function : BeginFrame
+// ================================================================
+bool OcctGlTextureRing::BeginFrame(const Handle(V3d_View)& theView,
+                                   const Graphic3d_Vec2i& theSize)
+{
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  if (aGlCtx.IsNull()
+   || theSize.x() <= 0
+   || theSize.y() <= 0)
+  {
+    return false;
+  }
+
+  releaseStaleFences(theView);
+
+  void* aConsumerFence = nullptr;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myRendering = -1;
+    for (size_t aSlotIter = 0; aSlotIter < mySlots.size(); ++aSlotIter)
+    {
+      const Slot& aSlot = mySlots[aSlotIter];
+      if (aSlot.State != SlotState_Free)
+        continue;
+
+      // prefer a texture which is no more sampled by consumer
+      const bool isUsed = aSlot.ConsumerFence != nullptr
+                       && aGlCtx->core32 != nullptr
+                       && aGlCtx->core32->glClientWaitSync((GLsync )aSlot.ConsumerFence, 0, 0) == GL_TIMEOUT_EXPIRED;
+      if (myRendering < 0 || !isUsed)
+        myRendering = (int)aSlotIter;
+      if (!isUsed)
+        break;
+    }
+    if (myRendering >= 0)
+    {
+      mySlots[myRendering].State = SlotState_Rendering;
+      aConsumerFence = mySlots[myRendering].ConsumerFence;
+      mySlots[myRendering].ConsumerFence = nullptr;
+    }
+  }
+  if (myRendering < 0)
+    return false; // unreachable with 3+ slots
+
+  if (aConsumerFence != nullptr
+   && aGlCtx->core32 != nullptr)
+  {
+    // consumer commands sampling the texture might be still in flight - GPU waits for them without blocking this thread
+    if (aGlCtx->core32->glClientWaitSync((GLsync )aConsumerFence, 0, 0) == GL_TIMEOUT_EXPIRED)
+    {
+      aGlCtx->core32->glWaitSync((GLsync )aConsumerFence, 0, GL_TIMEOUT_IGNORED);
+      std::lock_guard<std::mutex> aLock(myMutex);
+      ++myStats.NbWaited;
+    }
+    aGlCtx->core32->glDeleteSync((GLsync )aConsumerFence);
+  }
+
+  Slot& aSlot = mySlots[myRendering];
+  if (aSlot.Fbo.IsNull())
+    aSlot.Fbo = new OpenGl_FrameBuffer();
+
+  if (aSlot.Size != theSize
+  || !aSlot.Fbo->IsValid())
+  {
+    OpenGl_ColorFormats aColorFormats;
+    aColorFormats.Append(GL_RGBA8);
+  #if (OCC_VERSION_HEX >= 0x070600)
+    const bool isInit = aSlot.Fbo->Init(aGlCtx, theSize, aColorFormats, GL_DEPTH24_STENCIL8, 0);
+  #else
+    const bool isInit = aSlot.Fbo->Init(aGlCtx, theSize.x(), theSize.y(), aColorFormats, GL_DEPTH24_STENCIL8, 0);
+  #endif
+    if (!isInit)
+    {
+      aSlot.Fbo->Release(aGlCtx.get());
+      aSlot.Size = Graphic3d_Vec2i(0, 0);
+      std::lock_guard<std::mutex> aLock(myMutex);
+      aSlot.State = SlotState_Free;
+      myRendering = -1;
+      return false;
+    }
+    aSlot.Size      = theSize;
+    aSlot.TextureId = aSlot.Fbo->ColorTexture()->TextureId();
+  }
+
+  // OCCT renders into default FBO of the context
+  aGlCtx->SetDefaultFrameBuffer(aSlot.Fbo);
+
+  Graphic3d_Vec2i aViewSizeOld;
+  Handle(OcctGlTools::OcctNeutralWindow) aWindow = Handle(OcctGlTools::OcctNeutralWindow)::DownCast(theView->Window());
+  aWindow->Size(aViewSizeOld.x(), aViewSizeOld.y());
+  if (theSize != aViewSizeOld)
+  {
+    aWindow->SetSize(theSize.x(), theSize.y());
+    theView->MustBeResized();
+    theView->Invalidate();
+  }
+  return true;
+}
+
+// ================================================================
+// Function : EndFrame
+// ================================================================
+bool OcctGlTextureRing::EndFrame(const Handle(V3d_View)& theView)
+{
+  if (myRendering < 0)
+    return false;
+
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  Slot& aSlot = mySlots[myRendering];
+  if (aGlCtx->core32 != nullptr)
+  {
+    aSlot.Fence = aGlCtx->core32->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    aGlCtx->core11fwd->glFlush(); // fence should reach GPU to be ever signaled
+  }
+  else
+  {
+    // fences are unavailable (OpenGL ES 2.0) - wait for completion on producer side
+    aGlCtx->core11fwd->glFinish();
+  }
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (aSlotIter.State == SlotState_Pending
+     || aSlotIter.State == SlotState_Ready)
+    {
+      // drop older frame not yet acquired by consumer
+      releaseFence(theView, aSlotIter);
+      aSlotIter.State = SlotState_Free;
+      ++myStats.NbDropped;
+    }
+  }
+  aSlot.Index = ++myNbFrames;
+  aSlot.State = aSlot.Fence != nullptr ? SlotState_Pending : SlotState_Ready;
+  ++myStats.NbRendered;
+  myRendering = -1;
+  return aSlot.State == SlotState_Ready;
+}
+
+// ================================================================
+// Function : Poll
+// ================================================================
+bool OcctGlTextureRing::Poll(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  std::lock_guard<std::mutex> aLock(myMutex);
+  bool isPublished = false;
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (aSlotIter.State == SlotState_Pending)
+    {
+      const GLenum aRes = aGlCtx->core32->glClientWaitSync((GLsync )aSlotIter.Fence, 0, 0);
+      if (aRes == GL_TIMEOUT_EXPIRED)
+        continue;
+
+      releaseFence(theView, aSlotIter);
+      aSlotIter.State = SlotState_Ready;
+      isPublished = true;
+    }
+  }
+  return isPublished;
+}
+
+// ================================================================
+// Function : HasPending
+// ================================================================
+bool OcctGlTextureRing::HasPending() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  for (const Slot& aSlotIter : mySlots)
+  {
+    if (aSlotIter.State == SlotState_Pending)
+      return true;
+  }
+  return false;
+}
+
+// ================================================================
+// Function : Release
+// ================================================================
+void OcctGlTextureRing::Release(const Handle(V3d_View)& theView)
+{
+  if (theView.IsNull()
+   || theView->Window().IsNull())
+  {
+    return; // OpenGL context has not been created
+  }
+
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  for (const Slot& aSlotIter : mySlots)
+  {
+    if (!aSlotIter.Fbo.IsNull()
+     && aGlCtx->DefaultFrameBuffer() == aSlotIter.Fbo)
+    {
+      aGlCtx->SetDefaultFrameBuffer(Handle(OpenGl_FrameBuffer)());
+    }
+  }
+
+  releaseStaleFences(theView);
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  for (Slot& aSlotIter : mySlots)
+  {
+    releaseFence(theView, aSlotIter);
+    if (aSlotIter.ConsumerFence != nullptr
+     && aGlCtx->core32 != nullptr)
+    {
+      aGlCtx->core32->glDeleteSync((GLsync )aSlotIter.ConsumerFence);
+    }
+    if (!aSlotIter.Fbo.IsNull())
+      aSlotIter.Fbo->Release(aGlCtx.get());
+
+    aSlotIter = Slot();
+  }
+  myRendering = -1;
+}
+
+// ================================================================
+// Function : AcquireLatest
+// ================================================================
+bool OcctGlTextureRing::AcquireLatest(Frame& theFrame)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  Slot* aReady = nullptr;
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (aSlotIter.State == SlotState_Ready)
+    {
+      aReady = &aSlotIter;
+      break;
+    }
+  }
+  if (aReady == nullptr)
+    return false;
+
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (aSlotIter.State == SlotState_Displayed)
+      aSlotIter.State = SlotState_Free;
+  }
+
+  aReady->State = SlotState_Displayed;
+  theFrame.TextureId = aReady->TextureId;
+  theFrame.Size      = aReady->Size;
+  theFrame.Index     = aReady->Index;
+  ++myStats.NbAcquired;
+  return true;
+}
+
+// ================================================================
+// Function : SetDisplayedFence
+// ================================================================
+void OcctGlTextureRing::SetDisplayedFence(void* theFence)
+{
+  if (theFence == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (aSlotIter.State == SlotState_Displayed)
+    {
+      // the latest fence covers all previous uses of the texture
+      if (aSlotIter.ConsumerFence != nullptr)
+        myStaleFences.push_back(aSlotIter.ConsumerFence);
+
+      aSlotIter.ConsumerFence = theFence;
+      return;
+    }
+  }
+  myStaleFences.push_back(theFence);
+}
+
+// ================================================================
+// Function : releaseStaleFences
+// ================================================================
+void OcctGlTextureRing::releaseStaleFences(const Handle(V3d_View)& theView)
+{
+  std::vector<void*> aFences;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    aFences.swap(myStaleFences);
+  }
+
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  if (aGlCtx.IsNull()
+   || aGlCtx->core32 == nullptr)
+  {
+    return;
+  }
+
+  for (void* aFenceIter : aFences)
+    aGlCtx->core32->glDeleteSync((GLsync )aFenceIter);
+}
+
+// ================================================================
+// Function : releaseFence
+// ================================================================
+void OcctGlTextureRing::releaseFence(const Handle(V3d_View)& theView, Slot& theSlot)
+{
+  if (theSlot.Fence == nullptr)
+    return;
+
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  if (!aGlCtx.IsNull()
+   && aGlCtx->core32 != nullptr)
+  {
+    aGlCtx->core32->glDeleteSync((GLsync )theSlot.Fence);
+  }
+  theSlot.Fence = nullptr;
+}
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctGlTextureRing_HeaderFile
+#define _OcctGlTextureRing_HeaderFile
+
+#include <Graphic3d_Vec2.hxx>
+#include <V3d_View.hxx>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class OpenGl_FrameBuffer;
+
+//! Ring of offscreen color textures passing frames rendered by OCCT on its own thread
+//! to a consumer within another OpenGL context of the same share group (like Qt Quick scene graph).
+//!
+//! Producer (OCCT rendering thread) renders into a free slot set as default FBO of the view
+//! between BeginFrame() and EndFrame(); the frame is published once its fence is signaled (Poll()),
+//! so that the consumer never waits for GPU or for OCCT.
+//! Consumer (any thread) takes the newest published frame by AcquireLatest();
+//! the acquired slot is not reused by producer until the next frame is acquired
+//! and the fence put by consumer after the last use of the texture (SetDisplayedFence()) has been passed by GPU.
+//! With 3 slots there is always a free one - displayed, published (or pending) and rendered frames.
+//! Older published frames not yet acquired are dropped.
+class OcctGlTextureRing
+{
+public:
+  //! Frame published for consumer.
+  struct Frame
+  {
+    unsigned int    TextureId = 0; //!< GL color texture
+    Graphic3d_Vec2i Size;          //!< texture size in pixels
+    uint64_t        Index     = 0; //!< frame index
+  };
+
+  //! Ring statistics.
+  struct Stats
+  {
+    uint64_t NbRendered = 0; //!< number of frames rendered by producer
+    uint64_t NbAcquired = 0; //!< number of frames taken by consumer
+    uint64_t NbDropped  = 0; //!< number of frames replaced by newer ones before being acquired
+    uint64_t NbWaited   = 0; //!< number of frames which rendering had to wait for consumer fence on GPU
+  };
+
+public:
+  //! Main constructor.
+  //! @param[in] theNbBuffers  number of textures in the ring (at least 3)
+  OcctGlTextureRing(int theNbBuffers = 3);
+
+  //! Destructor; GL resources should be released by Release() in advance.
+  ~OcctGlTextureRing();
+
+  //! Return number of textures in the ring.
+  int NbBuffers() const { return (int)mySlots.size(); }
+
+  //! Return statistics.
+  Stats Statistics() const;
+
+public: //! @name producer interface (OCCT rendering thread, its OpenGL context is current)
+
+  //! Select a free slot, (re)allocate its FBO for requested size and set it as default FBO of the view.
+  //! A slot which consumer fence has been already signaled is preferred;
+  //! otherwise GPU is asked to wait for the fence (glWaitSync()) before rendering into the texture.
+  //! @param[in] theView  view to render
+  //! @param[in] theSize  frame size in pixels
+  //! @return FALSE if FBO cannot be allocated
+  bool BeginFrame(const Handle(V3d_View)& theView,
+                  const Graphic3d_Vec2i& theSize);
+
+  //! Finish the frame rendered since BeginFrame() - put a fence into GL command stream and flush it.
+  //! The frame replaces previous one not yet acquired by consumer.
+  //! @return TRUE if the frame has been published immediately (fences are unavailable and GPU has been waited)
+  bool EndFrame(const Handle(V3d_View)& theView);
+
+  //! Publish the last finished frame if its fence has been signaled (non-blocking).
+  //! @return TRUE if new frame has been published
+  bool Poll(const Handle(V3d_View)& theView);
+
+  //! Return TRUE if finished frame is waiting for its fence.
+  bool HasPending() const;
+
+  //! Release GL resources.
+  void Release(const Handle(V3d_View)& theView);
+
+public: //! @name consumer interface
+
+  //! Take the newest published frame; previously acquired slot is returned to producer.
+  //! @param[out] theFrame  acquired frame (left unchanged when there is no new frame)
+  //! @return TRUE if new frame has been acquired
+  bool AcquireLatest(Frame& theFrame);
+
+  //! Attach fence (GLsync) put by consumer into its OpenGL context after the last use of the displayed texture;
+  //! replaces previous fence of the displayed slot. The ring takes ownership - fences are deleted by producer.
+  void SetDisplayedFence(void* theFence);
+
+private:
+  //! Slot state.
+  enum SlotState
+  {
+    SlotState_Free,      //!< available for producer
+    SlotState_Rendering, //!< being rendered by producer
+    SlotState_Pending,   //!< rendered, waiting for fence
+    SlotState_Ready,     //!< published, waiting for consumer
+    SlotState_Displayed, //!< acquired by consumer
+  };
+
+  //! Ring slot.
+  struct Slot
+  {
+    Handle(OpenGl_FrameBuffer) Fbo;
+    void*           Fence         = nullptr; //!< GLsync of the finished frame
+    void*           ConsumerFence = nullptr; //!< GLsync put by consumer after the last use of the texture
+    Graphic3d_Vec2i Size;
+    unsigned int    TextureId     = 0;
+    uint64_t        Index         = 0;
+    SlotState       State         = SlotState_Free;
+  };
+
+private:
+  //! Release fence of the slot.
+  static void releaseFence(const Handle(V3d_View)& theView, Slot& theSlot);
+
+  //! Delete consumer fences replaced or released since the last call (producer).
+  void releaseStaleFences(const Handle(V3d_View)& theView);
+
+private:
+  std::vector<Slot>  mySlots;
+  std::vector<void*> myStaleFences;  //!< replaced consumer fences to be deleted by producer
+  mutable std::mutex myMutex;        //!< lock for slot states
+  int                myRendering = -1; //!< slot being rendered (producer only)
+  uint64_t           myNbFrames  = 0;
+  Stats              myStats;
+};
+
+#endif // _OcctGlTextureRing_HeaderFile
@@ -10,7 +10,11 @@
 #include <OpenGl_GlCore20.hxx>
 #include <OpenGl_FrameBuffer.hxx>
 #include <OpenGl_View.hxx>
+#include <OpenGl_ShaderProgram.hxx>
 #include <OpenGl_Window.hxx>
+#include <OSD_Environment.hxx>
+
+#include <atomic>
 
 // Exporting this symbol from .exe with value=1 will direct to NVIDIA GPU on Optimus systems
 //__declspec(dllexport) DWORD NvOptimusEnablement = 1;
@@ -48,15 +52,218 @@ public:
   {
     OpenGl_FrameBuffer::BindReadBuffer(theGlCtx);
   }
+
+  //! Return TRUE if specified Qt FBO has been already wrapped.
+  bool IsWrappedQtFbo(unsigned int theFboId, const Graphic3d_Vec2i& theFboSize, int theFboFormat) const
+  {
+    return myHasQtFbo
+        && myQtFboId == theFboId
+        && myQtFboSize == theFboSize
+        && myQtFboFormat == theFboFormat
+        && IsValid();
+  }
+
+  //! Remember wrapped Qt FBO.
+  void SetWrappedQtFbo(unsigned int theFboId, const Graphic3d_Vec2i& theFboSize, int theFboFormat)
+  {
+    myHasQtFbo    = true;
+    myQtFboId     = theFboId;
+    myQtFboSize   = theFboSize;
+    myQtFboFormat = theFboFormat;
+  }
+
+  //! Forget wrapped Qt FBO.
+  void InvalidateQtFbo() { myHasQtFbo = false; }
+
+private:
+  Graphic3d_Vec2i myQtFboSize;
+  unsigned int    myQtFboId     = 0;
+  int             myQtFboFormat = 0;
+  bool            myHasQtFbo    = false;
+};
+
+//! Shadow copy of GL state touched by OcctGlTools::ResetGlStateBeforeOcct()/ResetGlStateAfterOcct().
+//! Negative values mean unknown state.
+class OcctGlStateShadow
+{
+public:
+  int  Program         = -1; //!< GL_CURRENT_PROGRAM
+  int  Texture2d       = -1; //!< GL_TEXTURE_BINDING_2D of active texture unit
+  int  ActiveTexture   = -1; //!< GL_ACTIVE_TEXTURE
+  int  Blend           = -1; //!< GL_BLEND enabled state
+  int  AlphaTest       = -1; //!< GL_ALPHA_TEST enabled state (compatibility profile)
+  int  Texture2dFfp    = -1; //!< GL_TEXTURE_2D enabled state (compatibility profile)
+  int  PackAlignment   = -1; //!< GL_PACK_ALIGNMENT
+  int  UnpackAlignment = -1; //!< GL_UNPACK_ALIGNMENT
+  bool IsForeign       = true; //!< Qt might have rendered into context since the last OCCT frame
+
+  //! Empty constructor.
+  OcctGlStateShadow() {}
+
+  //! Mark all state as unknown.
+  void Invalidate()
+  {
+    Program = Texture2d = ActiveTexture = Blend = AlphaTest = Texture2dFfp = -1;
+    PackAlignment = UnpackAlignment = -1;
+    IsForeign = true;
+  }
 };
 
+//! OpenGL context wrapper created by OcctGlTools::InitializeGlWindow(),
+//! holding shadow GL state for exactly the lifetime of the wrapper.
+class OcctQtGlContext : public OpenGl_Context
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctQtGlContext, OpenGl_Context)
+public:
+  //! Empty constructor.
+  OcctQtGlContext() {}
+
+  //! Return shadow GL state.
+  OcctGlStateShadow& GlStateShadow() { return myGlStateShadow; }
+
+private:
+  OcctGlStateShadow myGlStateShadow;
+};
+
+namespace
+{
+  //! Flag to verify shadow GL state against glGet() values.
+  static std::atomic<bool> THE_TO_VERIFY_GL_STATE(OSD_Environment("OCCT_QT_VERIFY_GL_STATE").Value() == "1");
+
+  //! Return shadow GL state of the context, or specified unknown state for context not created by OcctGlTools
+  //! (e.g. created by OCCT itself) - so that all state is reset on every call.
+  static OcctGlStateShadow* glStateShadow(const Handle(OpenGl_Context)& theGlCtx, OcctGlStateShadow& theUnknown)
+  {
+    // shadow is a member of context wrapper, so that a new context never picks up stale state of the previous one
+    // (resource map might be shared between OCCT contexts, while pointers of released contexts might be reused)
+    if (OcctQtGlContext* aQtGlCtx = dynamic_cast<OcctQtGlContext*>(theGlCtx.get()))
+      return &aQtGlCtx->GlStateShadow();
+
+    theUnknown.Invalidate();
+    return &theUnknown;
+  }
+
+  //! Update shadow value and return TRUE if GL call should be issued to apply new value.
+  static bool toApplyGlState(int& theShadow, int theValue)
+  {
+    if (theShadow == theValue)
+      return false;
+
+    theShadow = theValue;
+    return true;
+  }
+
+  //! Compare known shadow value with actual one; mismatch is reported and shadow value is corrected.
+  //! @return FALSE on mismatch
+  static bool verifyGlState(int& theShadow, int theActual, const char* theName, const char* theStage)
+  {
+    if (theShadow >= 0 && theShadow != theActual)
+    {
+      Message::SendWarning() << "Warning: GL state shadow mismatch " << theStage << ": "
+                             << theName << " is " << theActual << " (expected " << theShadow << ")";
+      theShadow = theActual;
+      return false;
+    }
+    return true;
+  }
+
+  //! Verify shadow GL state against glGet() values.
+  //! @return FALSE if any mismatch has been found
+  static bool verifyGlStateShadow(const Handle(OpenGl_Context)& theGlCtx,
+                                  OcctGlStateShadow& theShadow,
+                                  const char* theStage)
+  {
+    bool isValid = true;
+    GLint aValue = 0;
+    if (theGlCtx->core20fwd != nullptr)
+    {
+      theGlCtx->core11fwd->glGetIntegerv(GL_CURRENT_PROGRAM, &aValue);
+      isValid = verifyGlState(theShadow.Program, aValue, "GL_CURRENT_PROGRAM", theStage) && isValid;
+    }
+    theGlCtx->core11fwd->glGetIntegerv(GL_TEXTURE_BINDING_2D, &aValue);
+    isValid = verifyGlState(theShadow.Texture2d, aValue, "GL_TEXTURE_BINDING_2D", theStage) && isValid;
+    if (theGlCtx->core15fwd != nullptr)
+    {
+      theGlCtx->core11fwd->glGetIntegerv(GL_ACTIVE_TEXTURE, &aValue);
+      isValid = verifyGlState(theShadow.ActiveTexture, aValue, "GL_ACTIVE_TEXTURE", theStage) && isValid;
+    }
+    isValid = verifyGlState(theShadow.Blend, theGlCtx->core11fwd->glIsEnabled(GL_BLEND) ? 1 : 0, "GL_BLEND", theStage) && isValid;
+    if (theGlCtx->core11ffp != nullptr)
+    {
+      isValid = verifyGlState(theShadow.AlphaTest, theGlCtx->core11fwd->glIsEnabled(GL_ALPHA_TEST) ? 1 : 0, "GL_ALPHA_TEST", theStage) && isValid;
+      isValid = verifyGlState(theShadow.Texture2dFfp, theGlCtx->core11fwd->glIsEnabled(GL_TEXTURE_2D) ? 1 : 0, "GL_TEXTURE_2D", theStage) && isValid;
+    }
+    theGlCtx->core11fwd->glGetIntegerv(GL_PACK_ALIGNMENT, &aValue);
+    isValid = verifyGlState(theShadow.PackAlignment, aValue, "GL_PACK_ALIGNMENT", theStage) && isValid;
+    theGlCtx->core11fwd->glGetIntegerv(GL_UNPACK_ALIGNMENT, &aValue);
+    isValid = verifyGlState(theShadow.UnpackAlignment, aValue, "GL_UNPACK_ALIGNMENT", theStage) && isValid;
+    return isValid;
+  }
+
+  //! Wrap bound Qt FBO, or reuse previous wrapper for the same FBO (when theFboId is not NULL).
+  static bool initializeGlFbo(const Handle(V3d_View)& theView,
+                              const unsigned int* theFboId,
+                              const Graphic3d_Vec2i& theFboSize,
+                              int theFboFormat)
+  {
+    Handle(OpenGl_Context)     aGlCtx = OcctGlTools::GetGlContext(theView);
+    Handle(OpenGl_FrameBuffer) aDefaultFbo = aGlCtx->DefaultFrameBuffer();
+    if (aDefaultFbo.IsNull())
+    {
+      aDefaultFbo = new OcctQtFrameBuffer();
+      aGlCtx->SetDefaultFrameBuffer(aDefaultFbo);
+    }
+
+    // InitWrapper() queries bound FBO and its attachments - skip it when Qt FBO is the same
+    Handle(OcctQtFrameBuffer) aQtFbo = Handle(OcctQtFrameBuffer)::DownCast(aDefaultFbo);
+    const bool isCached = theFboId != nullptr
+                      && !aQtFbo.IsNull()
+                      && aQtFbo->IsWrappedQtFbo(*theFboId, theFboSize, theFboFormat);
+    if (!isCached)
+    {
+      if (!aQtFbo.IsNull())
+        aQtFbo->InvalidateQtFbo();
+
+      if (!aDefaultFbo->InitWrapper(aGlCtx))
+      {
+        aDefaultFbo.Nullify();
+        Message::DefaultMessenger()->Send("Default FBO wrapper creation failed", Message_Fail);
+        return false;
+      }
+
+      if (theFboId != nullptr && !aQtFbo.IsNull())
+        aQtFbo->SetWrappedQtFbo(*theFboId, theFboSize, theFboFormat);
+    }
+
+    Graphic3d_Vec2i aViewSizeOld;
+    const Graphic3d_Vec2i aViewSizeNew = aDefaultFbo->GetVPSize();
+    Handle(OcctGlTools::OcctNeutralWindow) aWindow = Handle(OcctGlTools::OcctNeutralWindow)::DownCast(theView->Window());
+    aWindow->Size(aViewSizeOld.x(), aViewSizeOld.y());
+    if (aViewSizeNew != aViewSizeOld)
+    {
+      aWindow->SetSize(aViewSizeNew.x(), aViewSizeNew.y());
+      theView->MustBeResized();
+      theView->Invalidate();
+#if (OCC_VERSION_HEX >= 0x070700)
+      for (const Handle(V3d_View)& aSubviewIter : theView->Subviews())
+      {
+        aSubviewIter->MustBeResized();
+        aSubviewIter->Invalidate();
+        aDefaultFbo->SetupViewport(aGlCtx);
+      }
+#endif
+    }
+    return true;
+  }
+}
+
 // ================================================================
 // Function : GetGlContext
 // ================================================================
 Handle(OpenGl_Context) OcctGlTools::GetGlContext(const Handle(V3d_View)& theView)
 {
-  Handle(OpenGl_View) aGlView = Handle(OpenGl_View)::DownCast(theView->View());
-  return aGlView->GlWindow()->GetGlContext();
+  Handle(OpenGl_View) aGlView = !theView.IsNull() ? Handle(OpenGl_View)::DownCast(theView->View()) : Handle(OpenGl_View)();
+  return !aGlView.IsNull() && !aGlView->GlWindow().IsNull() ? aGlView->GlWindow()->GetGlContext() : Handle(OpenGl_Context)();
 }
 
 // ================================================================
@@ -81,16 +288,17 @@ bool OcctGlTools::InitializeGlWindow(const Handle(V3d_View)& theView,
                                      const Graphic3d_Vec2i& theSize,
                                      const double thePixelRatio)
 {
-  const Aspect_Drawable aNativeWin = GetGlNativeWindow(theNativeWin);
-
   Handle(OpenGl_GraphicDriver) aDriver = Handle(OpenGl_GraphicDriver)::DownCast(theView->Viewer()->Driver());
-  Handle(OpenGl_Context) aGlCtx = new OpenGl_Context();
+  Handle(OpenGl_Context) aGlCtx = new OcctQtGlContext();
   if (!aGlCtx->Init(!aDriver->Options().contextCompatible))
   {
     Message::SendFail() << "Error: OpenGl_Context is unable to wrap OpenGL context";
     return false;
   }
 
+  // offscreen surface has no window - take drawable bound to OpenGL context
+  const Aspect_Drawable aNativeWin = theNativeWin != 0 ? GetGlNativeWindow(theNativeWin) : (Aspect_Drawable)aGlCtx->Window();
+
   Handle(OcctNeutralWindow) aWindow = Handle(OcctNeutralWindow)::DownCast(theView->Window());
   if (aWindow.IsNull())
   {
@@ -110,6 +318,9 @@ bool OcctGlTools::InitializeGlWindow(const Handle(V3d_View)& theView,
     aSubviewIter->Invalidate();
   }
 #endif
+
+  // window size has been reset - Qt FBO should be wrapped again to synchronize it
+  InvalidateGlFbo(theView);
   return true;
 }
 
@@ -118,41 +329,74 @@ bool OcctGlTools::InitializeGlWindow(const Handle(V3d_View)& theView,
 // ================================================================
 bool OcctGlTools::InitializeGlFbo(const Handle(V3d_View)& theView)
 {
-  Handle(OpenGl_Context)     aGlCtx = OcctGlTools::GetGlContext(theView);
-  Handle(OpenGl_FrameBuffer) aDefaultFbo = aGlCtx->DefaultFrameBuffer();
-  if (aDefaultFbo.IsNull())
+  return initializeGlFbo(theView, nullptr, Graphic3d_Vec2i(0, 0), 0);
+}
+
+// ================================================================
+// Function : InitializeGlFbo
+// ================================================================
+bool OcctGlTools::InitializeGlFbo(const Handle(V3d_View)& theView,
+                                  unsigned int theFboId,
+                                  const Graphic3d_Vec2i& theFboSize,
+                                  int theFboFormat)
+{
+  return initializeGlFbo(theView, &theFboId, theFboSize, theFboFormat);
+}
+
+// ================================================================
+// Function : InitializeGlWindowBuffer
+// ================================================================
+bool OcctGlTools::InitializeGlWindowBuffer(const Handle(V3d_View)& theView,
+                                           const Graphic3d_Vec2i& theSize)
+{
+  Handle(OpenGl_Context) aGlCtx = GetGlContext(theView);
+  if (aGlCtx.IsNull())
+    return false;
+
+  GLint aFboId = 0;
+  aGlCtx->core11fwd->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &aFboId);
+  if (aFboId != 0)
   {
-    aDefaultFbo = new OcctQtFrameBuffer();
-    aGlCtx->SetDefaultFrameBuffer(aDefaultFbo);
+    // window is redirected into FBO (e.g. by platform plugin)
+    const unsigned int aQtFboId = (unsigned int)aFboId;
+    return initializeGlFbo(theView, &aQtFboId, theSize, 0);
   }
-  if (!aDefaultFbo->InitWrapper(aGlCtx))
+
+  if (!aGlCtx->DefaultFrameBuffer().IsNull())
   {
-    aDefaultFbo.Nullify();
-    Message::DefaultMessenger()->Send("Default FBO wrapper creation failed", Message_Fail);
-    return false;
+    // release wrapper of previously bound Qt FBO
+    aGlCtx->SetDefaultFrameBuffer(Handle(OpenGl_FrameBuffer)());
   }
 
   Graphic3d_Vec2i aViewSizeOld;
-  const Graphic3d_Vec2i aViewSizeNew = aDefaultFbo->GetVPSize();
-  Handle(OcctNeutralWindow)  aWindow = Handle(OcctNeutralWindow)::DownCast(theView->Window());
+  Handle(OcctGlTools::OcctNeutralWindow) aWindow = Handle(OcctGlTools::OcctNeutralWindow)::DownCast(theView->Window());
+  if (aWindow.IsNull())
+    return false;
+
   aWindow->Size(aViewSizeOld.x(), aViewSizeOld.y());
-  if (aViewSizeNew != aViewSizeOld)
+  if (theSize != aViewSizeOld)
   {
-    aWindow->SetSize(aViewSizeNew.x(), aViewSizeNew.y());
+    aWindow->SetSize(theSize.x(), theSize.y());
     theView->MustBeResized();
     theView->Invalidate();
-#if (OCC_VERSION_HEX >= 0x070700)
-    for (const Handle(V3d_View)& aSubviewIter : theView->Subviews())
-    {
-      aSubviewIter->MustBeResized();
-      aSubviewIter->Invalidate();
-      aDefaultFbo->SetupViewport(aGlCtx);
-    }
-#endif
   }
   return true;
 }
 
+// ================================================================
+// Function : InvalidateGlFbo
+// ================================================================
+void OcctGlTools::InvalidateGlFbo(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_View) aGlView = Handle(OpenGl_View)::DownCast(theView->View());
+  if (aGlView.IsNull() || aGlView->GlWindow().IsNull())
+    return;
+
+  Handle(OcctQtFrameBuffer) aQtFbo = Handle(OcctQtFrameBuffer)::DownCast(aGlView->GlWindow()->GetGlContext()->DefaultFrameBuffer());
+  if (!aQtFbo.IsNull())
+    aQtFbo->InvalidateQtFbo();
+}
+
 // ================================================================
 // Function : ResetGlStateBeforeOcct
 // ================================================================
@@ -162,7 +406,25 @@ void OcctGlTools::ResetGlStateBeforeOcct(const Handle(V3d_View)& theView)
   if (aGlCtx.IsNull())
     return;
 
-  if (aGlCtx->core20fwd != nullptr)
+  OcctGlStateShadow anUnknownShadow;
+  OcctGlStateShadow* aShadow = glStateShadow(aGlCtx, anUnknownShadow);
+  if (THE_TO_VERIFY_GL_STATE
+   && !verifyGlStateShadow(aGlCtx, *aShadow, "before OCCT"))
+  {
+    // shadow has been corrected to actual values - apply reset even if Qt was not expected to render
+    aShadow->IsForeign = true;
+  }
+
+  if (!aShadow->IsForeign)
+  {
+    // nothing has been rendered by Qt since the previous OCCT frame,
+    // so that GL state is consistent with OCCT caches
+    return;
+  }
+  aShadow->IsForeign = false;
+
+  if (aGlCtx->core20fwd != nullptr
+   && toApplyGlState(aShadow->Program, 0))
   {
     // shouldn't be a problem in most cases, but make sure to unbind active GLSL program
     aGlCtx->core20fwd->glUseProgram(0);
@@ -171,12 +433,16 @@ void OcctGlTools::ResetGlStateBeforeOcct(const Handle(V3d_View)& theView)
   // Qt leaves GL_BLEND enabled after drawing semitransparent elements,
   // but OCCT doesn't reset its state before drawing opaque objects.
   // Disable also texture bindings left by Qt.
-  aGlCtx->core11fwd->glBindTexture(GL_TEXTURE_2D, 0);
-  aGlCtx->core11fwd->glDisable(GL_BLEND);
+  if (toApplyGlState(aShadow->Texture2d, 0))
+    aGlCtx->core11fwd->glBindTexture(GL_TEXTURE_2D, 0);
+  if (toApplyGlState(aShadow->Blend, 0))
+    aGlCtx->core11fwd->glDisable(GL_BLEND);
   if (aGlCtx->core11ffp != nullptr)
   {
-    aGlCtx->core11fwd->glDisable(GL_ALPHA_TEST);
-    aGlCtx->core11fwd->glDisable(GL_TEXTURE_2D);
+    if (toApplyGlState(aShadow->AlphaTest, 0))
+      aGlCtx->core11fwd->glDisable(GL_ALPHA_TEST);
+    if (toApplyGlState(aShadow->Texture2dFfp, 0))
+      aGlCtx->core11fwd->glDisable(GL_TEXTURE_2D);
   }
 }
 
@@ -189,17 +455,77 @@ void OcctGlTools::ResetGlStateAfterOcct(const Handle(V3d_View)& theView)
   if (aGlCtx.IsNull())
     return;
 
+  // OCCT has been rendering since ResetGlStateBeforeOcct(),
+  // so that only state tracked by OpenGl_Context itself is known
+  OcctGlStateShadow anUnknownShadow;
+  OcctGlStateShadow* aShadow = glStateShadow(aGlCtx, anUnknownShadow);
+  aShadow->Invalidate();
+  aShadow->IsForeign = false;
+  if (aGlCtx->core20fwd != nullptr)
+  {
+    aShadow->Program = !aGlCtx->ActiveProgram().IsNull() ? int(aGlCtx->ActiveProgram()->ProgramId()) : 0;
+  }
+  if (THE_TO_VERIFY_GL_STATE)
+    verifyGlStateShadow(aGlCtx, *aShadow, "after OCCT");
+
   // Qt expects default OpenGL pack/unpack alignment setup,
   // while OCCT manages it dynamically;
   // without resetting alignment setup, Qt will draw
   // some textures corrupted (like fonts)
-  aGlCtx->core11fwd->glPixelStorei(GL_PACK_ALIGNMENT, 4);
-  aGlCtx->core11fwd->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  if (toApplyGlState(aShadow->PackAlignment, 4))
+    aGlCtx->core11fwd->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  if (toApplyGlState(aShadow->UnpackAlignment, 4))
+    aGlCtx->core11fwd->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-  if (aGlCtx->core15fwd != nullptr)
+  if (aGlCtx->core15fwd != nullptr
+   && toApplyGlState(aShadow->ActiveTexture, GL_TEXTURE0))
   {
     // Qt expects first texture object to be bound,
     // but OCCT might leave another object bound within multi-texture mapping
     aGlCtx->core15fwd->glActiveTexture(GL_TEXTURE0);
   }
 }
+
+// ================================================================
+// Function : ClearGlDepthStencil
+// ================================================================
+void OcctGlTools::ClearGlDepthStencil(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = GetGlContext(theView);
+  if (aGlCtx.IsNull())
+    return;
+
+  // writes might be masked by the last OCCT draw call
+  aGlCtx->core11fwd->glDepthMask(GL_TRUE);
+  aGlCtx->core11fwd->glStencilMask(~0u);
+  aGlCtx->core11fwd->glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
+// ================================================================
+// Function : InvalidateGlState
+// ================================================================
+void OcctGlTools::InvalidateGlState(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_View) aGlView = Handle(OpenGl_View)::DownCast(theView->View());
+  if (aGlView.IsNull() || aGlView->GlWindow().IsNull())
+    return;
+
+  OcctGlStateShadow anUnknownShadow;
+  glStateShadow(aGlView->GlWindow()->GetGlContext(), anUnknownShadow)->Invalidate();
+}
+
+// ================================================================
+// Function : IsGlStateVerification
+// ================================================================
+bool OcctGlTools::IsGlStateVerification()
+{
+  return THE_TO_VERIFY_GL_STATE;
+}
+
+// ================================================================
+// Function : SetGlStateVerification
+// ================================================================
+void OcctGlTools::SetGlStateVerification(bool theToVerify)
+{
+  THE_TO_VERIFY_GL_STATE = theToVerify;
+}
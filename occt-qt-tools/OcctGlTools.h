@@ -28,27 +28,71 @@ public:
     double myPixelRatio = 1.0;
   };
 public:
-  //! Return GL context.
+  //! Return GL context, or NULL if view has no window yet.
   static Handle(OpenGl_Context) GetGlContext(const Handle(V3d_View)& theView);
 
   //! Return active native window bound to OpenGL context.
   static Aspect_Drawable GetGlNativeWindow(Aspect_Drawable theNativeWin);
 
   //! Initialize native window for OCCT 3D Viewer.
+  //! NULL native window means drawable currently bound to OpenGL context (like QOffscreenSurface).
   static bool InitializeGlWindow(const Handle(V3d_View)& theView,
                                  const Aspect_Drawable theNativeWin,
                                  const Graphic3d_Vec2i& theSize,
                                  const double thePixelRatio);
 
   //! Wrap FBO created by QOpenGLFramebufferObject to OCCT 3D Viewer target.
+  //! Bound FBO is re-wrapped on every call, which involves synchronous GL queries.
   static bool InitializeGlFbo(const Handle(V3d_View)& theView);
 
+  //! Wrap FBO created by QOpenGLFramebufferObject to OCCT 3D Viewer target.
+  //! Re-wrapping is skipped when the same Qt FBO (id, size and format) has been wrapped by previous call.
+  //! @param[in] theView       view to setup
+  //! @param[in] theFboId      bound Qt FBO id
+  //! @param[in] theFboSize    Qt FBO size in pixels
+  //! @param[in] theFboFormat  Qt FBO format (e.g. internal texture format)
+  static bool InitializeGlFbo(const Handle(V3d_View)& theView,
+                              unsigned int theFboId,
+                              const Graphic3d_Vec2i& theFboSize,
+                              int theFboFormat);
+
+  //! Setup OCCT 3D Viewer to render directly into render target of the window bound to OpenGL context
+  //! (e.g. as underlay of Qt Quick scene): window buffer (FBO 0) is used as is, while other FBO is wrapped.
+  //! @param[in] theView  view to setup
+  //! @param[in] theSize  render target size in pixels
+  static bool InitializeGlWindowBuffer(const Handle(V3d_View)& theView,
+                                       const Graphic3d_Vec2i& theSize);
+
+  //! Invalidate cached Qt FBO, so that it will be re-wrapped by the next InitializeGlFbo() call.
+  static void InvalidateGlFbo(const Handle(V3d_View)& theView);
+
   //! Cleanup up global GL state after Qt before redrawing OCCT Viewer.
+  //! Calls are issued only for the state that might have been changed by Qt (see InvalidateGlState()),
+  //! while state left by OCCT itself is kept as is.
   static void ResetGlStateBeforeOcct(const Handle(V3d_View)& theView);
 
   //! Cleanup up global GL state after OCCT before redrawing Qt.
   //! Alternative to QQuickOpenGLUtils::resetOpenGLState().
   static void ResetGlStateAfterOcct(const Handle(V3d_View)& theView);
+
+  //! Clear depth and stencil buffers of the bound render target after OCCT redraw,
+  //! so that Qt content drawn on top within the same render pass is not depth-tested against OCCT geometry.
+  static void ClearGlDepthStencil(const Handle(V3d_View)& theView);
+
+  //! Mark shadow GL state of the view's context as unknown.
+  //! Should be called whenever Qt might render into the same OpenGL context between OCCT frames
+  //! (like Qt Quick scene graph, or Qt FBO creation and blits within QOpenGLWidget context).
+  //! Shadow state is kept only for contexts wrapped by InitializeGlWindow() and lives as long as the wrapper;
+  //! state of other contexts is always considered unknown.
+  static void InvalidateGlState(const Handle(V3d_View)& theView);
+
+  //! Return TRUE if shadow GL state should be verified against glGet() values on every reset;
+  //! FALSE by default or value of OCCT_QT_VERIFY_GL_STATE=1 environment variable.
+  static bool IsGlStateVerification();
+
+  //! Enable/disable verification of shadow GL state (slow, involves synchronous GL queries);
+  //! mismatches are reported as warnings to Message::DefaultMessenger().
+  static void SetGlStateVerification(bool theToVerify);
 };
 
 #endif // _OcctGlTools_HeaderFile
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctHoverThrottle.h"
+
+#include <V3d_View.hxx>
+
+#include <algorithm>
+#include <cstdlib>
+
+// ================================================================
+// Function : OcctHoverThrottle
+// ================================================================
+OcctHoverThrottle::OcctHoverThrottle()
+{
+  myClock.Start();
+}
+
+// ================================================================
+// Function : ToDetect
+// ================================================================
+bool OcctHoverThrottle::ToDetect(const Graphic3d_Vec2i& thePoint,
+                                 const Handle(V3d_View)& theView,
+                                 size_t theSceneRevision,
+                                 bool theToForce)
+{
+  ++myStats.NbRequested;
+  if (!myIsEnabled || theView.IsNull())
+  {
+    ++myStats.NbDetected;
+    myHasPending = false;
+    return true;
+  }
+
+  const Graphic3d_WorldViewProjState aCamState = theView->Camera()->WorldViewProjState();
+  if (!theToForce
+   && myHasLast
+   && !myCameraState.IsChanged(aCamState)
+   && mySceneRevision == theSceneRevision
+   && std::abs(thePoint.x() - myLastPoint.x()) < myParams.PixelThreshold
+   && std::abs(thePoint.y() - myLastPoint.y()) < myParams.PixelThreshold)
+  {
+    // nothing could change under still cursor
+    ++myStats.NbSkipped;
+    myHasPending = false;
+    return false;
+  }
+
+  const double aTime = myClock.ElapsedTime();
+  if (!theToForce
+   && myParams.MaxRate > 0.0
+   && myLastTime >= 0.0
+   && aTime - myLastTime < 1.0 / myParams.MaxRate)
+  {
+    ++myStats.NbDeferred;
+    myHasPending   = true;
+    myPendingPoint = thePoint;
+    return false;
+  }
+
+  ++myStats.NbDetected;
+  myCameraState   = aCamState;
+  mySceneRevision = theSceneRevision;
+  myLastPoint     = thePoint;
+  myLastTime      = aTime;
+  myHasLast       = true;
+  myHasPending    = false;
+  return true;
+}
+
+// ================================================================
+// Function : Postpone
+// ================================================================
+void OcctHoverThrottle::Postpone(const Graphic3d_Vec2i& thePoint)
+{
+  ++myStats.NbDeferred;
+  myHasPending   = true;
+  myPendingPoint = thePoint;
+}
+
+// ================================================================
+// Function : CheckSceneRevision
+// ================================================================
+void OcctHoverThrottle::CheckSceneRevision(size_t theSceneRevision)
+{
+  if (myIsEnabled
+   && myHasLast
+   && !myHasPending
+   && mySceneRevision != theSceneRevision)
+  {
+    myHasPending   = true;
+    myPendingPoint = myLastPoint;
+  }
+}
+
+// ================================================================
+// Function : PendingDelay
+// ================================================================
+double OcctHoverThrottle::PendingDelay() const
+{
+  if (!myHasPending)
+    return -1.0;
+
+  if (myParams.MaxRate <= 0.0 || myLastTime < 0.0)
+    return 0.0;
+
+  return std::max(1.0 / myParams.MaxRate - (myClock.ElapsedTime() - myLastTime), 0.0);
+}
+
+// ================================================================
+// Function : Reset
+// ================================================================
+void OcctHoverThrottle::Reset()
+{
+  myHasLast    = false;
+  myHasPending = false;
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctHoverThrottle_HeaderFile
+#define _OcctHoverThrottle_HeaderFile
+
+#include <Graphic3d_Vec2.hxx>
+#include <Graphic3d_WorldViewProjState.hxx>
+#include <OSD_Timer.hxx>
+#include <Standard_Handle.hxx>
+
+#include <cstdint>
+
+class V3d_View;
+
+//! Throttling of dynamic highlighting (AIS_InteractiveContext::MoveTo()), which might cost milliseconds on heavy models.
+//!
+//! Detection is requested at most once per frame (from AIS_ViewController::contextLazyMoveTo() override),
+//! and is skipped when cursor has moved less than a pixel threshold since the last detection
+//! while camera and scene (displayed objects and their display modes) remain the same.
+//! Detections exceeding the rate cap are postponed - the last postponed point should be detected
+//! by the viewer once PendingDelay() becomes zero.
+class OcctHoverThrottle
+{
+public:
+  //! Throttling parameters.
+  struct Params
+  {
+    int    PixelThreshold = 2;    //!< minimal cursor displacement in pixels to repeat detection for the same camera
+    double MaxRate        = 30.0; //!< maximum number of detections per second; 0 for no limit
+  };
+
+  //! Throttling statistics.
+  struct Stats
+  {
+    uint64_t NbRequested = 0; //!< number of detection requests
+    uint64_t NbDetected  = 0; //!< number of performed detections
+    uint64_t NbSkipped   = 0; //!< number of requests skipped as cursor and camera remain still
+    uint64_t NbDeferred  = 0; //!< number of requests postponed by rate cap or busy selection structures
+  };
+
+public:
+  //! Empty constructor.
+  OcctHoverThrottle();
+
+  //! Return TRUE if throttling is enabled; TRUE by default.
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable/disable throttling.
+  void SetEnabled(bool theIsEnabled) { myIsEnabled = theIsEnabled; }
+
+  //! Return throttling parameters.
+  const Params& HoverParams() const { return myParams; }
+
+  //! Return throttling parameters for modification.
+  Params& ChangeHoverParams() { return myParams; }
+
+  //! Return statistics.
+  const Stats& Statistics() const { return myStats; }
+
+  //! Decide if detection at specified point should be performed now.
+  //! @param[in] thePoint          cursor position
+  //! @param[in] theView           view defining camera
+  //! @param[in] theSceneRevision  counter incremented on every modification of displayed objects
+  //! @param[in] theToForce        perform detection regardless of throttling (e.g. for click selection)
+  //! @return TRUE if detection should be performed, FALSE if it has been skipped or postponed
+  bool ToDetect(const Graphic3d_Vec2i& thePoint,
+                const Handle(V3d_View)& theView,
+                size_t theSceneRevision,
+                bool theToForce = false);
+
+  //! Postpone detection at specified point (e.g. while selection structures are busy).
+  void Postpone(const Graphic3d_Vec2i& thePoint);
+
+  //! Postpone detection at the last point if scene has been modified since the last detection,
+  //! so that highlighting under still cursor is updated; should be called once per frame.
+  void CheckSceneRevision(size_t theSceneRevision);
+
+  //! Return TRUE if there is a postponed detection.
+  bool HasPending() const { return myHasPending; }
+
+  //! Return postponed detection point.
+  const Graphic3d_Vec2i& PendingPoint() const { return myPendingPoint; }
+
+  //! Return delay in seconds until postponed detection might be performed,
+  //! or negative value if there is no postponed detection.
+  double PendingDelay() const;
+
+  //! Forget the last detection (e.g. when cursor leaves the view or highlighting is reset).
+  void Reset();
+
+private:
+  Params                       myParams;
+  Stats                        myStats;
+  OSD_Timer                    myClock;
+  Graphic3d_WorldViewProjState myCameraState;
+  Graphic3d_Vec2i              myLastPoint;
+  Graphic3d_Vec2i              myPendingPoint;
+  size_t                       mySceneRevision = 0;
+  double                       myLastTime   = -1.0;
+  bool                         myHasLast    = false;
+  bool                         myHasPending = false;
+  bool                         myIsEnabled  = true;
+};
+
+#endif // _OcctHoverThrottle_HeaderFile
@@ -0,0 +1,194 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctInputLatency.h"
+
+#include <Message.hxx>
+#include <OSD_Environment.hxx>
+#include <OSD_OpenFile.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+// ================================================================
+// Function : LocalTime
+// ================================================================
+double OcctInputClock::LocalTime(unsigned long theTimestamp, double theTime)
+{
+  if (theTimestamp == 0)
+    return theTime; // synthesized event without timestamp
+
+  const double anEventTime = double(theTimestamp) * 0.001;
+  if (!myHasOffset
+    || theTime - anEventTime < myClockOffset)
+  {
+    myClockOffset = theTime - anEventTime;
+    myHasOffset   = true;
+  }
+  return anEventTime + myClockOffset;
+}
+
+// ================================================================
+// Function : OcctInputLatency
+// ================================================================
+OcctInputLatency::OcctInputLatency(int theNbBuckets)
+{
+  myBuckets.resize(size_t(std::max(theNbBuckets, 1)), 0);
+}
+
+// ================================================================
+// Function : ~OcctInputLatency
+// ================================================================
+OcctInputLatency::~OcctInputLatency()
+{
+  const TCollection_AsciiString aLogPath = OSD_Environment("OCCT_QT_INPUT_LATENCY_LOG").Value();
+  if (aLogPath.IsEmpty() || myNbSamples == 0)
+    return;
+
+  // several views might share the same log file
+  if (!Dump(aLogPath, true))
+    Message::SendFail() << "Error: unable to write input latency log '" << aLogPath << "'";
+}
+
+// ================================================================
+// Function : AddInput
+// ================================================================
+void OcctInputLatency::AddInput(unsigned long theTimestamp)
+{
+  const double aTime = CurrentTime();
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  myPending.push_back(myClock.LocalTime(theTimestamp, aTime));
+}
+
+// ================================================================
+// Function : InputsFlushed
+// ================================================================
+uint64_t OcctInputLatency::InputsFlushed()
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  if (myPending.empty())
+    return 0;
+
+  Batch aBatch;
+  aBatch.Index = ++myNbBatches;
+  aBatch.Times.swap(myPending);
+  myFlushed.push_back(std::move(aBatch));
+  return myNbBatches;
+}
+
+// ================================================================
+// Function : LastBatch
+// ================================================================
+uint64_t OcctInputLatency::LastBatch() const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  return myNbBatches;
+}
+
+// ================================================================
+// Function : FramePresented
+// ================================================================
+void OcctInputLatency::FramePresented(uint64_t theLastBatch)
+{
+  const double aTime = CurrentTime();
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  size_t aNbPresented = 0;
+  for (; aNbPresented < myFlushed.size() && myFlushed[aNbPresented].Index <= theLastBatch; ++aNbPresented)
+  {
+    for (double anEventTime : myFlushed[aNbPresented].Times)
+    {
+      const double aLatency = std::max(aTime - anEventTime, 0.0);
+      const size_t aBucket  = std::min(size_t(aLatency * 1000.0), myBuckets.size() - 1);
+      ++myBuckets[aBucket];
+      ++myNbSamples;
+      myMaxLatency = std::max(myMaxLatency, aLatency);
+    }
+  }
+  myFlushed.erase(myFlushed.begin(), myFlushed.begin() + aNbPresented);
+}
+
+// ================================================================
+// Function : percentile
+// ================================================================
+double OcctInputLatency::percentile(double thePercent) const
+{
+  if (myNbSamples == 0)
+    return 0.0;
+
+  // nearest-rank method
+  const uint64_t aRank = std::max(uint64_t(std::ceil(thePercent / 100.0 * double(myNbSamples))), uint64_t(1));
+  uint64_t aNbSamples = 0;
+  for (size_t aBucketIter = 0; aBucketIter < myBuckets.size(); ++aBucketIter)
+  {
+    aNbSamples += myBuckets[aBucketIter];
+    if (aNbSamples >= aRank)
+      return std::min(double(aBucketIter + 1) * 0.001, myMaxLatency);
+  }
+  return myMaxLatency;
+}
+
+// ================================================================
+// Function : Statistics
+// ================================================================
+OcctInputLatency::Stats OcctInputLatency::Statistics() const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  Stats aStats;
+  aStats.NbSamples = myNbSamples;
+  aStats.P50       = percentile(50.0);
+  aStats.P95       = percentile(95.0);
+  aStats.P99       = percentile(99.0);
+  aStats.Max       = myMaxLatency;
+  return aStats;
+}
+
+// ================================================================
+// Function : Histogram
+// ================================================================
+std::vector<uint64_t> OcctInputLatency::Histogram() const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  return myBuckets;
+}
+
+// ================================================================
+// Function : Reset
+// ================================================================
+void OcctInputLatency::Reset()
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  std::fill(myBuckets.begin(), myBuckets.end(), 0);
+  myNbSamples  = 0;
+  myMaxLatency = 0.0;
+}
+
+// ================================================================
+// Function : Dump
+// ================================================================
+bool OcctInputLatency::Dump(const TCollection_AsciiString& thePath, bool theToAppend) const
+{
+  const Stats aStats = Statistics();
+  const std::vector<uint64_t> aBuckets = Histogram();
+
+  std::ofstream aFile;
+  OSD_OpenStream(aFile, thePath.ToCString(), theToAppend ? (std::ios::out | std::ios::app) : std::ios::out);
+  if (!aFile.is_open())
+    return false;
+
+  aFile << "# input-to-photon latency: samples " << aStats.NbSamples
+        << ", p50 " << aStats.P50 * 1000.0 << " ms"
+        << ", p95 " << aStats.P95 * 1000.0 << " ms"
+        << ", p99 " << aStats.P99 * 1000.0 << " ms"
+        << ", max " << aStats.Max * 1000.0 << " ms\n";
+  aFile << "# bucket_ms count\n";
+  for (size_t aBucketIter = 0; aBucketIter < aBuckets.size(); ++aBucketIter)
+  {
+    if (aBuckets[aBucketIter] != 0)
+      aFile << aBucketIter << " " << aBuckets[aBucketIter] << "\n";
+  }
+  aFile << "\n";
+  aFile.flush();
+  return aFile.good();
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctInputLatency_HeaderFile
+#define _OcctInputLatency_HeaderFile
+
+#include <OSD_Timer.hxx>
+#include <Standard_Mutex.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <cstdint>
+#include <vector>
+
+//! Local clock mapping timestamps of input events (QInputEvent::timestamp()) onto local time.
+//! Event timestamps come from platform clock with unknown origin and millisecond resolution,
+//! so that they are mapped by the smallest observed difference between receiving time and timestamp.
+//! The class is not thread-safe.
+class OcctInputClock
+{
+public:
+  //! Empty constructor starting the clock.
+  OcctInputClock() { myClock.Start(); }
+
+  //! Return time in seconds since creation.
+  double CurrentTime() const { return myClock.ElapsedTime(); }
+
+  //! Map event timestamp onto local clock.
+  //! @param[in] theTimestamp  event timestamp in milliseconds (0 if unknown - receiving time is returned)
+  //! @param[in] theTime       receiving time returned by CurrentTime()
+  double LocalTime(unsigned long theTimestamp, double theTime);
+
+  //! Map event timestamp onto local clock, received right now.
+  double LocalTime(unsigned long theTimestamp) { return LocalTime(theTimestamp, CurrentTime()); }
+
+private:
+  OSD_Timer myClock;
+  double    myClockOffset = 0.0;   //!< minimal (local time - event timestamp) in seconds
+  bool      myHasOffset   = false;
+};
+
+//! Input-to-photon latency histogram.
+//!
+//! Input events are stamped by their timestamp (QInputEvent::timestamp()) when entering
+//! OcctQtTools::qtHandle*Event() or OcctQtInputAccumulator::Add*Event() (AddInput()).
+//! Stamps are closed into a batch once passed to AIS_ViewController::FlushViewEvents() (InputsFlushed()),
+//! and latency of each event is recorded when the first frame reflecting the batch is presented
+//! (FramePresented(), e.g. on frameSwapped() signal).
+//!
+//! Event timestamps are mapped onto local clock by OcctInputClock,
+//! hence measured latency doesn't include minimal delivery time of events by the platform.
+//!
+//! Latencies are accumulated into a histogram of 1 ms buckets, so that percentiles are computed in constant memory.
+//! When OCCT_QT_INPUT_LATENCY_LOG environment variable is defined, the histogram is appended to that file at destruction.
+//! Methods might be called from any thread.
+class OcctInputLatency
+{
+public:
+  //! Latency statistics; times are in seconds.
+  struct Stats
+  {
+    uint64_t NbSamples = 0;
+    double   P50       = 0.0;
+    double   P95       = 0.0;
+    double   P99       = 0.0;
+    double   Max       = 0.0;
+  };
+
+public:
+  //! Main constructor.
+  //! @param[in] theNbBuckets  number of 1 ms histogram buckets; longer latencies fall into the last one
+  OcctInputLatency(int theNbBuckets = 500);
+
+  //! Destructor, dumping histogram into file defined by OCCT_QT_INPUT_LATENCY_LOG environment variable.
+  ~OcctInputLatency();
+
+  //! Return time in seconds since creation.
+  double CurrentTime() const { return myClock.CurrentTime(); }
+
+  //! Stamp input event (GUI thread).
+  //! @param[in] theTimestamp  event timestamp in milliseconds (0 if unknown - receiving time is used)
+  void AddInput(unsigned long theTimestamp);
+
+  //! Close events stamped so far into a batch passed to AIS_ViewController.
+  //! @return batch index (0 if there were no stamped events)
+  uint64_t InputsFlushed();
+
+  //! Return index of the last flushed batch.
+  uint64_t LastBatch() const;
+
+  //! Record latencies of flushed batches reflected by presented frame.
+  //! @param[in] theLastBatch  the last batch reflected by the frame (all flushed batches by default)
+  void FramePresented(uint64_t theLastBatch = UINT64_MAX);
+
+  //! Return latency statistics.
+  Stats Statistics() const;
+
+  //! Return histogram - number of events per 1 ms bucket.
+  std::vector<uint64_t> Histogram() const;
+
+  //! Clear histogram.
+  void Reset();
+
+  //! Write statistics and non-empty histogram buckets into text file.
+  //! @param[in] thePath      file path
+  //! @param[in] theToAppend  append to existing file
+  //! @return FALSE on file writing error
+  bool Dump(const TCollection_AsciiString& thePath, bool theToAppend) const;
+
+private:
+  //! Batch of events flushed within one frame.
+  struct Batch
+  {
+    std::vector<double> Times; //!< local times of events
+    uint64_t            Index = 0;
+  };
+
+private:
+  //! Return percentile of recorded latencies (upper edge of bucket); should be called under lock.
+  double percentile(double thePercent) const;
+
+private:
+  mutable Standard_Mutex myMutex;
+  OcctInputClock         myClock;
+  std::vector<double>    myPending;             //!< local times of events not yet flushed
+  std::vector<Batch>     myFlushed;             //!< batches waiting for presentation
+  uint64_t               myNbBatches   = 0;
+  std::vector<uint64_t>  myBuckets;             //!< histogram of 1 ms buckets
+  uint64_t               myNbSamples   = 0;
+  double                 myMaxLatency  = 0.0;
+};
+
+#endif // _OcctInputLatency_HeaderFile
@@ -0,0 +1,215 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctInputPredictor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  //! Interval between samples in seconds, after which velocity is estimated from scratch (pointer has been paused).
+  static const double THE_VELOCITY_WINDOW = 0.05;
+
+  //! Squared distance in pixels below which positions are considered equal.
+  static const double THE_SQUARE_TOLERANCE = 0.25;
+}
+
+// ================================================================
+// Function : OcctInputPredictor
+// ================================================================
+OcctInputPredictor::OcctInputPredictor()
+{
+  //
+}
+
+// ================================================================
+// Function : SetEnabled
+// ================================================================
+void OcctInputPredictor::SetEnabled(bool theToEnable)
+{
+  myIsEnabled = theToEnable;
+  if (!theToEnable)
+    Clear();
+}
+
+// ================================================================
+// Function : findPointer
+// ================================================================
+OcctInputPredictor::Pointer* OcctInputPredictor::findPointer(Standard_Size theId)
+{
+  for (Pointer& aPointerIter : myPointers)
+  {
+    if (aPointerIter.Id == theId)
+      return &aPointerIter;
+  }
+  return nullptr;
+}
+
+// ================================================================
+// Function : addSample
+// ================================================================
+void OcctInputPredictor::addSample(Pointer& thePointer, const Graphic3d_Vec2d& thePnt, double theTime)
+{
+  thePointer.HasApplied = false;
+  if (thePointer.NbSamples > 0
+   && thePointer.Last.Time >= theTime)
+  {
+    // several events with the same timestamp - keep the latest position and re-evaluate the last velocity
+    thePointer.Last.Point = thePnt;
+    if (thePointer.NbSamples < 2)
+      return;
+  }
+  else
+  {
+    if (thePointer.NbSamples > 0)
+    {
+      thePointer.Prev         = thePointer.Last;
+      thePointer.PrevVelocity = thePointer.Velocity;
+    }
+    thePointer.Last.Point = thePnt;
+    thePointer.Last.Time  = theTime;
+    thePointer.NbSamples  = std::min(thePointer.NbSamples + 1, 3);
+    if (thePointer.NbSamples < 2)
+    {
+      thePointer.Velocity = Graphic3d_Vec2d(0.0);
+      return;
+    }
+  }
+
+  const double aDeltaTime = thePointer.Last.Time - thePointer.Prev.Time;
+  const Graphic3d_Vec2d aVelocity = (thePointer.Last.Point - thePointer.Prev.Point) / aDeltaTime;
+  if (thePointer.NbSamples == 2
+   || aDeltaTime > THE_VELOCITY_WINDOW)
+  {
+    // the first measurement within gesture or after a pause
+    thePointer.Velocity = aVelocity;
+    return;
+  }
+
+  // exponential smoothing with weight of the new measurement growing with interval since the previous sample
+  const double aWeight = mySmoothingTime > 0.0 ? 1.0 - std::exp(-aDeltaTime / mySmoothingTime) : 1.0;
+  thePointer.Velocity = thePointer.PrevVelocity + (aVelocity - thePointer.PrevVelocity) * aWeight;
+}
+
+// ================================================================
+// Function : AddMouseSample
+// ================================================================
+void OcctInputPredictor::AddMouseSample(const Graphic3d_Vec2d& thePnt,
+                                        Aspect_VKeyMouse theButtons,
+                                        Aspect_VKeyFlags theModifiers,
+                                        unsigned long theTimestamp)
+{
+  if (!myIsEnabled)
+    return;
+
+  Pointer* aPointer = findPointer(MouseId());
+  if (aPointer == nullptr)
+  {
+    myPointers.push_back(Pointer());
+    aPointer = &myPointers.back();
+    aPointer->Id = MouseId();
+  }
+  if (aPointer->Buttons != theButtons
+   || aPointer->Modifiers != theModifiers)
+  {
+    // new drag gesture
+    aPointer->NbSamples = 0;
+    aPointer->Buttons   = theButtons;
+    aPointer->Modifiers = theModifiers;
+  }
+  addSample(*aPointer, thePnt, myClock.LocalTime(theTimestamp));
+}
+
+// ================================================================
+// Function : AddTouchSample
+// ================================================================
+void OcctInputPredictor::AddTouchSample(Standard_Size theId,
+                                        const Graphic3d_Vec2d& thePnt,
+                                        unsigned long theTimestamp)
+{
+  if (!myIsEnabled)
+    return;
+
+  Pointer* aPointer = findPointer(theId);
+  if (aPointer == nullptr)
+  {
+    myPointers.push_back(Pointer());
+    aPointer = &myPointers.back();
+    aPointer->Id = theId;
+  }
+  addSample(*aPointer, thePnt, myClock.LocalTime(theTimestamp));
+}
+
+// ================================================================
+// Function : RemoveTouch
+// ================================================================
+void OcctInputPredictor::RemoveTouch(Standard_Size theId)
+{
+  myPointers.erase(std::remove_if(myPointers.begin(), myPointers.end(),
+                                  [theId](const Pointer& thePointer) { return thePointer.Id == theId; }),
+                   myPointers.end());
+}
+
+// ================================================================
+// Function : Predict
+// ================================================================
+bool OcctInputPredictor::Predict(Standard_Size theId, double theLeadTime, Graphic3d_Vec2d& thePnt) const
+{
+  const Pointer* aPointer = findPointer(theId);
+  if (aPointer == nullptr
+   || aPointer->NbSamples == 0)
+  {
+    return false;
+  }
+
+  const Sample& aLast = aPointer->Last;
+  thePnt = aLast.Point;
+
+  // the latest sample is already old, and the frame will be shown a bit later
+  const double anAge = myClock.CurrentTime() - aLast.Time;
+  if (anAge > myMaxLead)
+    return true; // pointer has stopped
+
+  const double aLead = std::min(anAge + std::max(theLeadTime, 0.0), myMaxLead);
+  thePnt += aPointer->Velocity * aLead;
+  return true;
+}
+
+// ================================================================
+// Function : Apply
+// ================================================================
+bool OcctInputPredictor::Apply(Aspect_WindowInputListener& theListener, double theLeadTime)
+{
+  if (!myIsEnabled)
+    return false;
+
+  bool toUpdate = false;
+  for (Pointer& aPointerIter : myPointers)
+  {
+    const bool isMouse = aPointerIter.Id == MouseId();
+    if (isMouse ? aPointerIter.Buttons == Aspect_VKeyMouse_NONE
+                : !theListener.TouchPoints().Contains(aPointerIter.Id))
+    {
+      continue;
+    }
+
+    Graphic3d_Vec2d aPnt;
+    if (!Predict(aPointerIter.Id, theLeadTime, aPnt)
+     || (aPointerIter.HasApplied && (aPnt - aPointerIter.Applied).SquareModulus() < THE_SQUARE_TOLERANCE))
+    {
+      continue;
+    }
+
+    aPointerIter.Applied    = aPnt;
+    aPointerIter.HasApplied = true;
+    if (isMouse)
+      theListener.UpdateMousePosition(Graphic3d_Vec2i(aPnt + Graphic3d_Vec2d(0.5)), aPointerIter.Buttons, aPointerIter.Modifiers, false);
+    else
+      theListener.UpdateTouchPoint(aPointerIter.Id, aPnt);
+
+    // listener is ahead of the actual pointer - settle it by the next frame
+    if ((aPnt - aPointerIter.Last.Point).SquareModulus() >= THE_SQUARE_TOLERANCE)
+      toUpdate = true;
+  }
+  return toUpdate;
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctInputPredictor_HeaderFile
+#define _OcctInputPredictor_HeaderFile
+
+#include "OcctInputLatency.h"
+
+#include <Aspect_WindowInputListener.hxx>
+
+#include <vector>
+
+//! Extrapolation of dragged pointers (mouse or touch) to the expected presentation time of the frame.
+//!
+//! Qt compresses mouse moves, so that by the time AIS_ViewController::FlushViewEvents() is called
+//! the latest sample is already up to one frame old, and rotation jumps between sparse samples.
+//! The predictor tracks points stamped by QInputEvent::timestamp() for each pointer,
+//! filters velocity measured between consecutive samples by exponential smoothing
+//! (with weight depending on the interval between samples, as Qt delivers them irregularly),
+//! and moves the pointer ahead by the time till presentation limited by maximum lead,
+//! so that overshoot on sudden stops remains small and is corrected by the next frame.
+//! Only dragging is extrapolated (mouse buttons pressed or touches) - hover and picking use actual positions.
+//!
+//! Samples are added by OcctQtTools::qtHandleMouseEvent(), qtHandleTouchEvent() and OcctQtInputAccumulator,
+//! while Apply() should be called right after passing accumulated events to the listener.
+//! The class is not thread-safe - like OcctQtInputAccumulator, Apply() should be called while GUI thread is blocked.
+class OcctInputPredictor
+{
+public:
+  //! Return identifier of mouse pointer (touch points use their own identifiers).
+  static Standard_Size MouseId() { return Standard_Size(-1); }
+
+public:
+  //! Main constructor.
+  OcctInputPredictor();
+
+  //! Return TRUE if prediction is enabled; TRUE by default.
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable or disable prediction; disabling clears history.
+  void SetEnabled(bool theToEnable);
+
+  //! Return time constant of exponential smoothing of pointer velocity in seconds; 0.02 by default.
+  //! Larger values suppress jitter of sparse samples, but make velocity lagging behind acceleration;
+  //! 0 means no smoothing (velocity between the last two samples).
+  double SmoothingTime() const { return mySmoothingTime; }
+
+  //! Set time constant of exponential smoothing of pointer velocity in seconds.
+  void SetSmoothingTime(double theTime) { mySmoothingTime = theTime > 0.0 ? theTime : 0.0; }
+
+  //! Return maximum extrapolation time in seconds; 0.05 by default.
+  //! Pointer which has not moved for longer time is considered as stopped.
+  double MaxLead() const { return myMaxLead; }
+
+  //! Set maximum extrapolation time in seconds.
+  void SetMaxLead(double theTime) { myMaxLead = theTime > 0.0 ? theTime : 0.0; }
+
+  //! Clear history of all pointers.
+  void Clear() { myPointers.clear(); }
+
+public: //! @name pointer samples (GUI thread)
+
+  //! Add mouse sample; history is reset on buttons change.
+  //! @param[in] thePnt        position in pixels
+  //! @param[in] theButtons    pressed buttons
+  //! @param[in] theModifiers  key modifiers
+  //! @param[in] theTimestamp  event timestamp in milliseconds (0 if unknown - receiving time is used)
+  void AddMouseSample(const Graphic3d_Vec2d& thePnt,
+                      Aspect_VKeyMouse theButtons,
+                      Aspect_VKeyFlags theModifiers,
+                      unsigned long theTimestamp);
+
+  //! Add touch point sample.
+  //! @param[in] theId         touch identifier
+  //! @param[in] thePnt        position in pixels
+  //! @param[in] theTimestamp  event timestamp in milliseconds (0 if unknown - receiving time is used)
+  void AddTouchSample(Standard_Size theId,
+                      const Graphic3d_Vec2d& thePnt,
+                      unsigned long theTimestamp);
+
+  //! Remove released touch point.
+  void RemoveTouch(Standard_Size theId);
+
+public: //! @name prediction
+
+  //! Return pointer position extrapolated to specified time.
+  //! @param[in] theId        pointer identifier
+  //! @param[in] theLeadTime  time from now till presentation in seconds
+  //! @param[out] thePnt      predicted position
+  //! @return FALSE if pointer is unknown
+  bool Predict(Standard_Size theId, double theLeadTime, Graphic3d_Vec2d& thePnt) const;
+
+  //! Pass predicted positions of dragged pointers to the listener.
+  //! @param[in] theListener  listener with already flushed actual events
+  //! @param[in] theLeadTime  time from now till presentation of the frame in seconds
+  //! @return TRUE if listener has received position ahead of the actual one,
+  //!         so that one more frame should be redrawn to settle pointer after it stops
+  bool Apply(Aspect_WindowInputListener& theListener, double theLeadTime);
+
+private:
+  //! Timestamped position.
+  struct Sample
+  {
+    Graphic3d_Vec2d Point;
+    double          Time = 0.0; //!< local time in seconds
+  };
+
+  //! Pointer state.
+  struct Pointer
+  {
+    Sample           Last;         //!< the latest sample
+    Sample           Prev;         //!< the sample preceding the latest one (with smaller time)
+    Graphic3d_Vec2d  Velocity;     //!< smoothed velocity in pixels per second
+    Graphic3d_Vec2d  PrevVelocity; //!< smoothed velocity before the latest sample
+    Graphic3d_Vec2d  Applied;      //!< the last position passed to the listener by Apply()
+    Standard_Size    Id         = 0;
+    Aspect_VKeyMouse Buttons    = Aspect_VKeyMouse_NONE;
+    Aspect_VKeyFlags Modifiers  = Aspect_VKeyFlags_NONE;
+    int              NbSamples  = 0; //!< number of samples within the gesture (saturated at 3)
+    bool             HasApplied = false;
+  };
+
+private:
+  //! Find pointer by identifier.
+  Pointer* findPointer(Standard_Size theId);
+
+  //! Find pointer by identifier.
+  const Pointer* findPointer(Standard_Size theId) const
+  {
+    return const_cast<OcctInputPredictor*>(this)->findPointer(theId);
+  }
+
+  //! Append sample to pointer and update smoothed velocity.
+  void addSample(Pointer& thePointer, const Graphic3d_Vec2d& thePnt, double theTime);
+
+private:
+  OcctInputClock       myClock;
+  std::vector<Pointer> myPointers;
+  double               mySmoothingTime = 0.02;
+  double               myMaxLead       = 0.05;
+  bool                 myIsEnabled     = true;
+};
+
+#endif // _OcctInputPredictor_HeaderFile
@@ -0,0 +1,171 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctInteractionLod.h"
+
+#include "OcctTessellator.h"
+
+#include <AIS_AnimationCamera.hxx>
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_Shape.hxx>
+#include <AIS_ViewController.hxx>
+#include <V3d_View.hxx>
+#include <V3d_Viewer.hxx>
+
+namespace
+{
+  //! AIS_Shape display mode showing bounding box.
+  static const int THE_BND_BOX_MODE = 2;
+}
+
+// ================================================================
+// Function : OcctInteractionLod
+// ================================================================
+OcctInteractionLod::OcctInteractionLod()
+{
+  myClock.Start();
+}
+
+// ================================================================
+// Function : Update
+// ================================================================
+double OcctInteractionLod::Update(const AIS_ViewController& theCtrl,
+                                  const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView)
+{
+  if (theView.IsNull())
+    return -1.0;
+
+  // camera state changes on dragging, zooming and panning; animation is checked explicitly
+  const double aTime = myClock.ElapsedTime();
+  const Graphic3d_WorldViewProjState aCamState = theView->Camera()->WorldViewProjState();
+  const bool isAnimated = !theCtrl.ViewAnimation().IsNull() && !theCtrl.ViewAnimation()->IsStopped();
+  const bool isMoving   = isAnimated || (myLastMoveTime >= 0.0 && myCameraState.IsChanged(aCamState));
+  myCameraState = aCamState;
+  if (isMoving || myLastMoveTime < 0.0)
+    myLastMoveTime = aTime;
+
+  if (!myIsEnabled)
+  {
+    if (myIsDegraded)
+      restore(theCtx, theView);
+
+    return -1.0;
+  }
+
+  if (isMoving)
+  {
+    if (!myIsDegraded)
+      degrade(theCtx, theView);
+
+    return myParams.IdleTimeout;
+  }
+
+  if (!myIsDegraded)
+    return -1.0;
+
+  const double anIdleTime = aTime - myLastMoveTime;
+  if (anIdleTime >= myParams.IdleTimeout)
+  {
+    restore(theCtx, theView);
+    return -1.0;
+  }
+  return myParams.IdleTimeout - anIdleTime;
+}
+
+// ================================================================
+// Function : degrade
+// ================================================================
+void OcctInteractionLod::degrade(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)
+{
+  myIsDegraded = true;
+
+  // remember current values to restore them later
+  Graphic3d_RenderingParams& aParams = theView->ChangeRenderingParams();
+  myFullMsaaSamples = aParams.NbMsaaSamples;
+  if (myParams.ToDisableMsaa)
+    aParams.NbMsaaSamples = 0;
+
+  // Z-layer settings and display modes would affect all views of shared viewer
+  Graphic3d_ZLayerSettings aLayer = theView->Viewer()->ZLayerSettings(Graphic3d_ZLayerId_Default);
+  myFullCullingSize = aLayer.CullingSize();
+  myHasCulling = myParams.CullingSize > 0.0 && !myIsViewerShared;
+  if (myHasCulling)
+  {
+    aLayer.SetCullingSize(myParams.CullingSize);
+    theView->Viewer()->SetZLayerSettings(Graphic3d_ZLayerId_Default, aLayer);
+  }
+
+  if (myParams.ToShowBndProxies
+  && !myIsViewerShared
+  && !theCtx.IsNull())
+  {
+    AIS_ListOfInteractive aDisplayed;
+    theCtx->DisplayedObjects(aDisplayed);
+
+    // rebuild triangles cache to drop removed objects
+    MapOfTriangles aNbTriangles;
+    for (const Handle(AIS_InteractiveObject)& aPrsIter : aDisplayed)
+    {
+      if (!aPrsIter->IsKind(STANDARD_TYPE(AIS_Shape)))
+        continue;
+
+      const int aNbTris = nbTriangles(aPrsIter);
+      aNbTriangles[aPrsIter.get()] = std::make_pair(aPrsIter, aNbTris);
+      if (aNbTris < myParams.ProxyMinTriangles
+       || aPrsIter->DisplayMode() == THE_BND_BOX_MODE)
+        continue;
+
+      myProxies.push_back(std::make_pair(aPrsIter, aPrsIter->DisplayMode()));
+      theCtx->SetDisplayMode(aPrsIter, THE_BND_BOX_MODE, false);
+    }
+    myNbTriangles.swap(aNbTriangles);
+  }
+
+  theView->Invalidate();
+}
+
+// ================================================================
+// Function : restore
+// ================================================================
+void OcctInteractionLod::restore(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)
+{
+  myIsDegraded = false;
+
+  theView->ChangeRenderingParams().NbMsaaSamples = myFullMsaaSamples;
+
+  Graphic3d_ZLayerSettings aLayer = theView->Viewer()->ZLayerSettings(Graphic3d_ZLayerId_Default);
+  if (myHasCulling
+   && aLayer.CullingSize() != myFullCullingSize)
+  {
+    aLayer.SetCullingSize(myFullCullingSize);
+    theView->Viewer()->SetZLayerSettings(Graphic3d_ZLayerId_Default, aLayer);
+  }
+  myHasCulling = false;
+
+  if (!theCtx.IsNull())
+  {
+    for (const std::pair<Handle(AIS_InteractiveObject), int>& aProxyIter : myProxies)
+    {
+      if (aProxyIter.second >= 0)
+        theCtx->SetDisplayMode(aProxyIter.first, aProxyIter.second, false);
+      else
+        theCtx->UnsetDisplayMode(aProxyIter.first, false);
+    }
+  }
+  myProxies.clear();
+
+  theView->Invalidate();
+}
+
+// ================================================================
+// Function : nbTriangles
+// ================================================================
+int OcctInteractionLod::nbTriangles(const Handle(AIS_InteractiveObject)& thePrs)
+{
+  MapOfTriangles::const_iterator aFound = myNbTriangles.find(thePrs.get());
+  if (aFound != myNbTriangles.end())
+    return aFound->second.second;
+
+  const Handle(AIS_Shape) aShape = Handle(AIS_Shape)::DownCast(thePrs);
+  return !aShape.IsNull() ? int(OcctTessellator::NbTriangles(aShape->Shape())) : 0;
+}
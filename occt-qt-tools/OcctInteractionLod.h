@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctInteractionLod_HeaderFile
+#define _OcctInteractionLod_HeaderFile
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_WorldViewProjState.hxx>
+#include <OSD_Timer.hxx>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class AIS_InteractiveContext;
+class AIS_ViewController;
+class V3d_View;
+
+//! Interaction level-of-detail controller degrading rendering quality while camera is being manipulated.
+//!
+//! While camera moves (view is dragged, zoomed or animated), the controller:
+//! - disables MSAA;
+//! - enables size culling of small objects in the default Z-layer;
+//! - optionally displays bounding box proxies (AIS_Shape display mode 2) instead of heavy shapes.
+//! Full quality is restored once the view remains idle for a configurable time.
+//!
+//! Z-layer culling and display modes belong to the viewer and interactive context,
+//! so that they are not modified when these are shared by several views (SetViewerShared()) -
+//! otherwise interaction within one view would degrade all of them.
+//!
+//! Update() should be called from AIS_ViewController::handleViewRedraw() before redrawing the view.
+class OcctInteractionLod
+{
+public:
+  //! Degradation parameters.
+  struct Params
+  {
+    bool   ToDisableMsaa     = true;   //!< disable MSAA during interaction
+    double CullingSize       = 4.0;    //!< size culling in pixels during interaction; 0 to disable
+    bool   ToShowBndProxies  = false;  //!< show bounding boxes instead of heavy shapes during interaction
+    int    ProxyMinTriangles = 200000; //!< minimal number of triangles of a shape to be replaced by proxy
+    double IdleTimeout       = 0.3;    //!< idle time in seconds to restore full quality
+  };
+
+public:
+  //! Empty constructor.
+  OcctInteractionLod();
+
+  //! Return TRUE if controller is enabled; TRUE by default.
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable/disable controller; quality is restored on the next Update() when disabled.
+  void SetEnabled(bool theIsEnabled) { myIsEnabled = theIsEnabled; }
+
+  //! Return TRUE if viewer and interactive context are shared by several views; FALSE by default.
+  bool IsViewerShared() const { return myIsViewerShared; }
+
+  //! Set if viewer and interactive context are shared by several views,
+  //! so that only view-local quality (MSAA) is degraded; takes effect on the next degradation.
+  void SetViewerShared(bool theIsShared) { myIsViewerShared = theIsShared; }
+
+  //! Return degradation parameters.
+  const Params& LodParams() const { return myParams; }
+
+  //! Return degradation parameters for modification.
+  Params& ChangeLodParams() { return myParams; }
+
+  //! Return TRUE if quality is currently degraded.
+  bool IsDegraded() const { return myIsDegraded; }
+
+  //! Update quality for the frame to be rendered.
+  //! @param[in] theCtrl  view controller defining animation state
+  //! @param[in] theCtx   interactive context
+  //! @param[in] theView  view to be redrawn
+  //! @return delay in seconds to redraw the view for restoring full quality, or negative value if not needed
+  double Update(const AIS_ViewController& theCtrl,
+                const Handle(AIS_InteractiveContext)& theCtx,
+                const Handle(V3d_View)& theView);
+
+private:
+  //! Degrade quality.
+  void degrade(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView);
+
+  //! Restore full quality.
+  void restore(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView);
+
+  //! Return number of triangles of displayed shape (cached).
+  int nbTriangles(const Handle(AIS_InteractiveObject)& thePrs);
+
+private:
+  //! Cached number of triangles; handle keeps the key alive.
+  typedef std::unordered_map<const AIS_InteractiveObject*, std::pair<Handle(AIS_InteractiveObject), int>> MapOfTriangles;
+
+private:
+  Params                       myParams;
+  OSD_Timer                    myClock;
+  Graphic3d_WorldViewProjState myCameraState;
+  double                       myLastMoveTime   = -1.0;
+  bool                         myIsEnabled      = true;
+  bool                         myIsDegraded     = false;
+  bool                         myIsViewerShared = false;
+  bool                         myHasCulling     = false; //!< Z-layer culling has been modified by degradation
+
+  int    myFullMsaaSamples = 0;
+  double myFullCullingSize = 0.0;
+  std::vector<std::pair<Handle(AIS_InteractiveObject), int>> myProxies; //!< replaced shapes with original display modes
+  MapOfTriangles myNbTriangles;
+};
+
+#endif // _OcctInteractionLod_HeaderFile
@@ -0,0 +1,447 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+#include <OpenGl_View.hxx>
+#include <OpenGl_Window.hxx>
+
+#include "OcctQtFrameCapture.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QRunnable>
+#include <Standard_WarningsRestore.hxx>
+
+#include <V3d_View.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  //! Return OpenGL context of the view, or NULL.
+  static Handle(OpenGl_Context) viewGlContext(const Handle(V3d_View)& theView)
+  {
+    Handle(OpenGl_View) aGlView = !theView.IsNull() ? Handle(OpenGl_View)::DownCast(theView->View()) : Handle(OpenGl_View)();
+    return !aGlView.IsNull() && !aGlView->GlWindow().IsNull() ? aGlView->GlWindow()->GetGlContext() : Handle(OpenGl_Context)();
+  }
+
+  //! Task writing image file on encoder thread.
+  class OcctQtImageWriteTask : public QRunnable
+  {
+  public:
+    OcctQtImageWriteTask(const QImage& theImage,
+                         const QString& theFilePath,
+                         const OcctQtFrameCapture::FileCallback& theCallback,
+                         std::atomic<int>& theNbEncoding)
+    : myImage(theImage), myFilePath(theFilePath), myCallback(theCallback), myNbEncoding(theNbEncoding) {}
+
+    virtual void run() override
+    {
+      const bool isSaved = myImage.save(myFilePath);
+      --myNbEncoding;
+      if (myCallback)
+        myCallback(myFilePath, isSaved);
+    }
+
+  private:
+    QImage                           myImage;
+    QString                          myFilePath;
+    OcctQtFrameCapture::FileCallback myCallback;
+    std::atomic<int>&                myNbEncoding;
+  };
+}
+
+// ================================================================
+// Function : OcctQtFrameCapture
+// ================================================================
+OcctQtFrameCapture::OcctQtFrameCapture(int theNbBuffers, int theMaxNbEncoding)
+: mySlots(size_t(Max(theNbBuffers, 1))),
+  myNbEncoding(0),
+  myNbInFlight(0),
+  myMaxNbEncoding(Max(theMaxNbEncoding, 1))
+{
+  // single encoder thread keeps files written in order of capture
+  myEncoderPool.setMaxThreadCount(1);
+}
+
+// ================================================================
+// Function : ~OcctQtFrameCapture
+// ================================================================
+OcctQtFrameCapture::~OcctQtFrameCapture()
+{
+  myEncoderPool.waitForDone();
+}
+
+// ================================================================
+// Function : RequestRaw
+// ================================================================
+void OcctQtFrameCapture::RequestRaw(const RawCallback& theCallback)
+{
+  Request aRequest;
+  aRequest.Raw = theCallback;
+  pushRequest(aRequest);
+}
+
+// ================================================================
+// Function : RequestImage
+// ================================================================
+void OcctQtFrameCapture::RequestImage(const ImageCallback& theCallback)
+{
+  Request aRequest;
+  aRequest.Image = theCallback;
+  pushRequest(aRequest);
+}
+
+// ================================================================
+// Function : RequestFile
+// ================================================================
+void OcctQtFrameCapture::RequestFile(const QString& theFilePath, const FileCallback& theCallback)
+{
+  Request aRequest;
+  aRequest.FilePath = theFilePath;
+  aRequest.File = theCallback;
+  pushRequest(aRequest);
+}
+
+// ================================================================
+// Function : pushRequest
+// ================================================================
+void OcctQtFrameCapture::pushRequest(const Request& theRequest)
+{
+  {
+    Standard_Mutex::Sentry aLock(myMutex);
+    myPending.push_back(theRequest);
+  }
+  if (myFrameRequester)
+    myFrameRequester();
+}
+
+// ================================================================
+// Function : requeueRequests
+// ================================================================
+void OcctQtFrameCapture::requeueRequests(const std::vector<Request>& theRequests)
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  std::vector<Request> aRequests;
+  aRequests.reserve(theRequests.size() + myPending.size());
+  for (const Request& aReqIter : theRequests)
+  {
+    if (aReqIter.IsListener)
+      ++myStats.NbSkipped;
+    else
+      aRequests.push_back(aReqIter);
+  }
+  if (aRequests.empty())
+    return;
+
+  ++myStats.NbDeferred;
+  aRequests.insert(aRequests.end(), myPending.begin(), myPending.end());
+  myPending.swap(aRequests);
+}
+
+// ================================================================
+// Function : SetFrameListener
+// ================================================================
+void OcctQtFrameCapture::SetFrameListener(const FrameCallback& theCallback, double theInterval)
+{
+  {
+    Standard_Mutex::Sentry aLock(myMutex);
+    myFrameListener    = theCallback;
+    myListenerInterval = Max(theInterval, 0.0);
+    myListenerStart    = -1.0;
+    myListenerSlot     = -1;
+  }
+  if (theCallback && myFrameRequester)
+    myFrameRequester(); // capture the first frame
+}
+
+// ================================================================
+// Function : HasPending
+// ================================================================
+bool OcctQtFrameCapture::HasPending() const
+{
+  if (myNbInFlight > 0)
+    return true;
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  return !myPending.empty();
+}
+
+// ================================================================
+// Function : Statistics
+// ================================================================
+OcctQtFrameCapture::Stats OcctQtFrameCapture::Statistics() const
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  return myStats;
+}
+
+// ================================================================
+// Function : InvalidateGl
+// ================================================================
+void OcctQtFrameCapture::InvalidateGl()
+{
+  Standard_Mutex::Sentry aLock(myMutex);
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (aSlotIter.IsBusy)
+      requeueRequests(aSlotIter.Requests);
+
+    aSlotIter = Slot();
+  }
+  myNbInFlight = 0;
+}
+
+// ================================================================
+// Function : Release
+// ================================================================
+void OcctQtFrameCapture::Release(const Handle(OpenGl_Context)& theGlCtx)
+{
+  if (!theGlCtx.IsNull()
+   && !theGlCtx->IsCurrent())
+  {
+    theGlCtx->MakeCurrent();
+  }
+
+  Standard_Mutex::Sentry aLock(myMutex);
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (!theGlCtx.IsNull())
+    {
+      if (aSlotIter.Fence != nullptr && theGlCtx->core32 != nullptr)
+        theGlCtx->core32->glDeleteSync((GLsync )aSlotIter.Fence);
+      if (aSlotIter.Pbo != 0 && theGlCtx->core15fwd != nullptr)
+        theGlCtx->core15fwd->glDeleteBuffers(1, &aSlotIter.Pbo);
+    }
+    if (aSlotIter.IsBusy)
+      requeueRequests(aSlotIter.Requests);
+
+    aSlotIter = Slot();
+  }
+  myNbInFlight = 0;
+}
+
+// ================================================================
+// Function : Perform
+// ================================================================
+void OcctQtFrameCapture::Perform(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = viewGlContext(theView);
+  if (aGlCtx.IsNull())
+    return;
+
+  ++myFrameIndex;
+  finishReadbacks(aGlCtx);
+
+  std::vector<Request> aRequests;
+  {
+    Standard_Mutex::Sentry aLock(myMutex);
+    if (!myPending.empty()
+      && myNbEncoding >= myMaxNbEncoding)
+    {
+      // encoder is behind - postpone capture instead of accumulating images in memory
+      ++myStats.NbDeferred;
+    }
+    else
+    {
+      aRequests.swap(myPending);
+    }
+
+    if (myFrameListener)
+    {
+      // capture only frames falling into the next slot; skipped slots are filled by listener
+      const double aTime = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      if (myListenerStart < 0.0)
+        myListenerStart = aTime;
+
+      const int64_t aSlot = myListenerInterval > 0.0
+                          ? int64_t(std::floor((aTime - myListenerStart) / myListenerInterval + 0.5))
+                          : myListenerSlot + 1;
+      if (aSlot > myListenerSlot)
+      {
+        myListenerSlot = aSlot;
+        const FrameCallback aListener = myFrameListener;
+        Request aRequest;
+        aRequest.Raw = [aListener, aTime](const uint8_t* theData, int theWidth, int theHeight, int theRowBytes)
+        {
+          aListener(theData, theWidth, theHeight, theRowBytes, aTime);
+        };
+        aRequest.IsListener = true;
+        aRequests.push_back(aRequest);
+      }
+    }
+    if (aRequests.empty())
+      return;
+  }
+
+  const Handle(OpenGl_FrameBuffer)& aFbo = aGlCtx->DefaultFrameBuffer();
+  Graphic3d_Vec2i aSize;
+  if (!aFbo.IsNull() && aFbo->IsValid())
+    aSize = aFbo->GetVPSize();
+  else
+    theView->Window()->Size(aSize.x(), aSize.y());
+
+  if (aSize.x() <= 0 || aSize.y() <= 0)
+  {
+    requeueRequests(aRequests);
+    return;
+  }
+
+  if (!aFbo.IsNull() && aFbo->IsValid())
+    aFbo->BindReadBuffer(aGlCtx);
+
+  const int aRowBytes = aSize.x() * 4;
+  aGlCtx->core11fwd->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  if (aGlCtx->core30 == nullptr || aGlCtx->core15fwd == nullptr)
+  {
+    // synchronous readback - PBO mapping is unavailable
+    std::vector<uint8_t> aData(size_t(aRowBytes) * size_t(aSize.y()));
+    aGlCtx->core11fwd->glReadPixels(0, 0, aSize.x(), aSize.y(), GL_RGBA, GL_UNSIGNED_BYTE, aData.data());
+    {
+      Standard_Mutex::Sentry aLock(myMutex);
+      ++myStats.NbFrames;
+      ++myStats.NbSyncFrames;
+    }
+    deliver(aRequests, aData.data(), aSize, aRowBytes);
+    return;
+  }
+
+  Slot* aSlot = nullptr;
+  for (Slot& aSlotIter : mySlots)
+  {
+    if (!aSlotIter.IsBusy)
+    {
+      aSlot = &aSlotIter;
+      break;
+    }
+  }
+  if (aSlot == nullptr)
+  {
+    // all PBOs are in flight - postpone capture till the next frame rather than waiting for GPU
+    requeueRequests(aRequests);
+    return;
+  }
+
+  const size_t aBufferSize = size_t(aRowBytes) * size_t(aSize.y());
+  if (aSlot->Pbo == 0)
+    aGlCtx->core15fwd->glGenBuffers(1, &aSlot->Pbo);
+
+  aGlCtx->core15fwd->glBindBuffer(GL_PIXEL_PACK_BUFFER, aSlot->Pbo);
+  if (aSlot->BufferSize != aBufferSize)
+  {
+    aGlCtx->core15fwd->glBufferData(GL_PIXEL_PACK_BUFFER, GLsizeiptr(aBufferSize), nullptr, GL_STREAM_READ);
+    aSlot->BufferSize = aBufferSize;
+  }
+  aGlCtx->core11fwd->glReadPixels(0, 0, aSize.x(), aSize.y(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  aGlCtx->core15fwd->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  aSlot->Fence      = aGlCtx->core32 != nullptr ? aGlCtx->core32->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+  aSlot->Size       = aSize;
+  aSlot->FrameIndex = myFrameIndex;
+  aSlot->Requests.swap(aRequests);
+  aSlot->IsBusy     = true;
+  ++myNbInFlight;
+}
+
+// ================================================================
+// Function : finishReadbacks
+// ================================================================
+void OcctQtFrameCapture::finishReadbacks(const Handle(OpenGl_Context)& theGlCtx)
+{
+  for (;;)
+  {
+    Slot* anOldest = nullptr;
+    for (Slot& aSlotIter : mySlots)
+    {
+      if (aSlotIter.IsBusy
+       && (anOldest == nullptr || aSlotIter.FrameIndex < anOldest->FrameIndex))
+      {
+        anOldest = &aSlotIter;
+      }
+    }
+    if (anOldest == nullptr)
+      return;
+
+    if (anOldest->Fence != nullptr)
+    {
+      // poll fence without waiting
+      const GLenum aRes = theGlCtx->core32->glClientWaitSync((GLsync )anOldest->Fence, 0, 0);
+      if (aRes == GL_TIMEOUT_EXPIRED)
+        return;
+
+      theGlCtx->core32->glDeleteSync((GLsync )anOldest->Fence);
+      anOldest->Fence = nullptr;
+    }
+    else if (myFrameIndex - anOldest->FrameIndex < 2)
+    {
+      // without fences, give GPU two frames to complete readback
+      return;
+    }
+
+    theGlCtx->core15fwd->glBindBuffer(GL_PIXEL_PACK_BUFFER, anOldest->Pbo);
+    const uint8_t* aData = (const uint8_t* )theGlCtx->core30->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(anOldest->BufferSize), GL_MAP_READ_BIT);
+    std::vector<Request> aRequests;
+    aRequests.swap(anOldest->Requests);
+    if (aData != nullptr)
+    {
+      {
+        Standard_Mutex::Sentry aLock(myMutex);
+        ++myStats.NbFrames;
+      }
+      deliver(aRequests, aData, anOldest->Size, anOldest->Size.x() * 4);
+      theGlCtx->core30->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    else
+    {
+      // mapping failed - capture the next frame
+      requeueRequests(aRequests);
+    }
+    theGlCtx->core15fwd->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    anOldest->IsBusy = false;
+    --myNbInFlight;
+  }
+}
+
+// ================================================================
+// Function : deliver
+// ================================================================
+void OcctQtFrameCapture::deliver(std::vector<Request>& theRequests,
+                                 const uint8_t* theData,
+                                 const Graphic3d_Vec2i& theSize,
+                                 int theRowBytes)
+{
+  QImage anImage;
+  for (Request& aReqIter : theRequests)
+  {
+    if (aReqIter.Raw)
+    {
+      aReqIter.Raw(theData, theSize.x(), theSize.y(), theRowBytes);
+      continue;
+    }
+
+    if (anImage.isNull())
+    {
+      // flip bottom-up OpenGL rows; alpha is ignored as Qt FBO might have no alpha channel
+      anImage = QImage(theSize.x(), theSize.y(), QImage::Format_RGBX8888);
+      const size_t aRowSize = std::min(size_t(anImage.bytesPerLine()), size_t(theRowBytes));
+      for (int aRowIter = 0; aRowIter < theSize.y(); ++aRowIter)
+        std::memcpy(anImage.scanLine(theSize.y() - aRowIter - 1), theData + size_t(aRowIter) * size_t(theRowBytes), aRowSize);
+    }
+
+    if (aReqIter.Image)
+      aReqIter.Image(anImage);
+
+    if (!aReqIter.FilePath.isEmpty())
+    {
+      ++myNbEncoding;
+      myEncoderPool.start(new OcctQtImageWriteTask(anImage, aReqIter.FilePath, aReqIter.File, myNbEncoding));
+    }
+  }
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtFrameCapture_HeaderFile
+#define _OcctQtFrameCapture_HeaderFile
+
+#include <Graphic3d_Vec2.hxx>
+#include <Standard_Handle.hxx>
+#include <Standard_Mutex.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QImage>
+#include <QString>
+#include <QThreadPool>
+#include <Standard_WarningsRestore.hxx>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class OpenGl_Context;
+class V3d_View;
+
+//! Asynchronous capture of 3D view content through a ring of pixel buffer objects (PBO).
+//!
+//! Requests might be pushed from any thread; the frame is read back by Perform() called
+//! from the rendering thread right after OCCT redraw while Qt FBO is still bound.
+//! glReadPixels() into PBO doesn't stall the pipeline - PBO is mapped one or two frames later,
+//! once the fence is signaled, so that the rendering thread never waits for GPU.
+//! Falls back to synchronous readback when PBO mapping is unavailable (OpenGL ES 2.0).
+//!
+//! Frame listener (e.g. video recorder) is paced by time - only frames rendered when the next capture slot is due
+//! are read back, and the listener never forces the view to be redrawn by itself.
+class OcctQtFrameCapture
+{
+public:
+  //! Callback receiving mapped pixels without a copy (rendering thread);
+  //! rows are stored bottom-up as RGBA8 with theRowBytes stride; data is valid only within the callback.
+  typedef std::function<void(const uint8_t* theData, int theWidth, int theHeight, int theRowBytes)> RawCallback;
+
+  //! Callback of frame listener receiving mapped pixels as RawCallback does (rendering thread);
+  //! theTime is the moment the frame has been rendered in seconds of std::chrono::steady_clock.
+  typedef std::function<void(const uint8_t* theData, int theWidth, int theHeight, int theRowBytes, double theTime)> FrameCallback;
+
+  //! Callback receiving top-down image (rendering thread).
+  typedef std::function<void(const QImage& theImage)> ImageCallback;
+
+  //! Callback receiving result of writing image file (encoder thread).
+  typedef std::function<void(const QString& theFilePath, bool theIsSaved)> FileCallback;
+
+  //! Capture statistics.
+  struct Stats
+  {
+    uint64_t NbFrames     = 0; //!< number of captured frames
+    uint64_t NbSyncFrames = 0; //!< number of frames read back synchronously (PBO unavailable)
+    uint64_t NbDeferred   = 0; //!< number of times capture has been postponed (PBO ring or encoder queue is full)
+    uint64_t NbSkipped    = 0; //!< number of frames skipped by frame listener (PBO ring is full)
+  };
+
+public:
+  //! Main constructor.
+  //! @param[in] theNbBuffers      number of PBOs in the ring
+  //! @param[in] theMaxNbEncoding  maximum number of images waiting for encoding
+  OcctQtFrameCapture(int theNbBuffers = 3, int theMaxNbEncoding = 8);
+
+  //! Destructor, waiting for encoder thread to finish.
+  //! GL resources are not released here - Release() should be called beforehand,
+  //! as OpenGL context share group might outlive the viewer.
+  ~OcctQtFrameCapture();
+
+  //! Set function requesting a new frame to be rendered (called on new requests and while readbacks are in flight).
+  void SetFrameRequester(const std::function<void()>& theFunc) { myFrameRequester = theFunc; }
+
+  //! Request capture of the next frame as raw mapped buffer.
+  void RequestRaw(const RawCallback& theCallback);
+
+  //! Request capture of the next frame as image.
+  void RequestImage(const ImageCallback& theCallback);
+
+  //! Request capture of the next frame into PNG (or other format deduced from file extension) file;
+  //! encoding is done on the encoder thread.
+  void RequestFile(const QString& theFilePath, const FileCallback& theCallback = FileCallback());
+
+  //! Set callback receiving rendered frames (e.g. for video recording) as raw mapped buffer;
+  //! empty callback stops continuous capture.
+  //! @param[in] theCallback  frame listener
+  //! @param[in] theInterval  minimal interval between captured frames in seconds (e.g. 1/Fps of the video);
+  //!                         0 to capture every rendered frame
+  void SetFrameListener(const FrameCallback& theCallback, double theInterval = 0.0);
+
+  //! Return TRUE if there are requests waiting for the frame or for readback completion;
+  //! frame listener alone doesn't ask for new frames.
+  bool HasPending() const;
+
+  //! Return capture statistics.
+  Stats Statistics() const;
+
+  //! Read back the frame for pending requests and deliver finished readbacks (rendering thread).
+  void Perform(const Handle(V3d_View)& theView);
+
+  //! Forget GL resources of the previous OpenGL context (rendering thread);
+  //! readbacks in flight are re-requested for the next frame.
+  void InvalidateGl();
+
+  //! Release PBOs and fences within specified OpenGL context (or context sharing resources with it);
+  //! should be called from GL cleanup path of the viewer on the rendering thread.
+  //! Readbacks in flight are re-requested for the next frame.
+  void Release(const Handle(OpenGl_Context)& theGlCtx);
+
+private:
+  //! Capture request.
+  struct Request
+  {
+    RawCallback   Raw;
+    ImageCallback Image;
+    FileCallback  File;
+    QString       FilePath;
+    bool          IsListener = false; //!< request created for frame listener, never postponed
+  };
+
+  //! PBO ring slot.
+  struct Slot
+  {
+    std::vector<Request> Requests;
+    Graphic3d_Vec2i      Size;
+    uint64_t             FrameIndex = 0;
+    size_t               BufferSize = 0;
+    void*                Fence      = nullptr;
+    unsigned int         Pbo        = 0;
+    bool                 IsBusy     = false;
+  };
+
+private:
+  //! Push new request.
+  void pushRequest(const Request& theRequest);
+
+  //! Put requests back to be fulfilled by the next frame; frame listener requests are skipped.
+  void requeueRequests(const std::vector<Request>& theRequests);
+
+  //! Map finished PBOs and deliver them, oldest first.
+  void finishReadbacks(const Handle(OpenGl_Context)& theGlCtx);
+
+  //! Deliver pixels to requests.
+  void deliver(std::vector<Request>& theRequests, const uint8_t* theData, const Graphic3d_Vec2i& theSize, int theRowBytes);
+
+private:
+  mutable Standard_Mutex myMutex;
+  std::vector<Request>   myPending;        //!< requests waiting for the next frame
+  FrameCallback          myFrameListener;  //!< callback receiving rendered frames
+  double                 myListenerInterval = 0.0;  //!< interval between frames captured for listener
+  double                 myListenerStart    = -1.0; //!< time of the first frame captured for listener
+  int64_t                myListenerSlot     = -1;   //!< capture slot of the last frame captured for listener
+  std::vector<Slot>      mySlots;          //!< PBO ring (rendering thread)
+  std::function<void()>  myFrameRequester;
+  QThreadPool            myEncoderPool;    //!< image encoding thread
+  std::atomic<int>       myNbEncoding;     //!< number of images waiting for encoding
+  std::atomic<int>       myNbInFlight;     //!< number of busy slots
+  int                    myMaxNbEncoding;
+  uint64_t               myFrameIndex = 0;
+  Stats                  myStats;
+};
+
+#endif // _OcctQtFrameCapture_HeaderFile
@@ -0,0 +1,492 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctQtFrameRecorder.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <Standard_WarningsRestore.hxx>
+
+#include <Image_VideoRecorder.hxx>
+#include <Message.hxx>
+#include <OSD_OpenFile.hxx>
+#include <OSD_Timer.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  //! Convert RGB into full-range BT.601 luma.
+  static inline uint8_t rgbToY(int theR, int theG, int theB)
+  {
+    return uint8_t((77 * theR + 150 * theG + 29 * theB + 128) >> 8);
+  }
+
+  //! Convert RGB into full-range BT.601 chroma.
+  static inline void rgbToUV(int theR, int theG, int theB, uint8_t& theU, uint8_t& theV)
+  {
+    theU = uint8_t(std::min(255, std::max(0, ((-43 * theR - 85 * theG + 128 * theB + 128) >> 8) + 128)));
+    theV = uint8_t(std::min(255, std::max(0, ((128 * theR - 107 * theG - 21 * theB + 128) >> 8) + 128)));
+  }
+}
+
+// ================================================================
+// Function : OcctQtFrameRecorder
+// ================================================================
+OcctQtFrameRecorder::OcctQtFrameRecorder()
+{
+  //
+}
+
+// ================================================================
+// Function : ~OcctQtFrameRecorder
+// ================================================================
+OcctQtFrameRecorder::~OcctQtFrameRecorder()
+{
+  Stop();
+}
+
+// ================================================================
+// Function : currentTime
+// ================================================================
+double OcctQtFrameRecorder::currentTime()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ================================================================
+// Function : IsRecording
+// ================================================================
+bool OcctQtFrameRecorder::IsRecording() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return myIsRecording;
+}
+
+// ================================================================
+// Function : LastError
+// ================================================================
+QString OcctQtFrameRecorder::LastError() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return myError;
+}
+
+// ================================================================
+// Function : setError
+// ================================================================
+void OcctQtFrameRecorder::setError(const QString& theError)
+{
+  Message::SendFail() << "Error: " << theError.toUtf8().constData();
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myError = theError;
+}
+
+// ================================================================
+// Function : Statistics
+// ================================================================
+OcctQtFrameRecorder::Stats OcctQtFrameRecorder::Statistics() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return myStats;
+}
+
+// ================================================================
+// Function : Start
+// ================================================================
+bool OcctQtFrameRecorder::Start(const Params& theParams)
+{
+  Stop();
+
+  const QString anExt = QFileInfo(theParams.FilePath).suffix().toLower();
+  Format aFormat = Format_FFmpeg;
+  if (anExt == "y4m")
+    aFormat = Format_Y4M;
+  else if (anExt == "png")
+    aFormat = Format_PNG;
+  if (theParams.FilePath.isEmpty() || theParams.Fps <= 0)
+  {
+    setError("invalid video recording parameters");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myParams = theParams;
+  myParams.QueueCapacity = std::max(theParams.QueueCapacity, 1);
+  myFormat = aFormat;
+  myStats  = Stats();
+  myError.clear();
+  myFrameSizeX = 0;
+  myFrameSizeY = 0;
+  myStartTime  = 0.0;
+  myLastSlot   = -1;
+  myNbTrailing = 0;
+  myNbWritten  = 0;
+  myLastPngPath.clear();
+  myIsOutputFailed = false;
+  myQueue.clear();
+  myFreeFrames.clear();
+  myFreeFrames.resize(size_t(myParams.QueueCapacity));
+  myToStop = false;
+  myIsRecording = true;
+  myThread = std::thread([this]() { encoderLoop(); });
+  return true;
+}
+
+// ================================================================
+// Function : Stop
+// ================================================================
+void OcctQtFrameRecorder::Stop()
+{
+  {
+    std::unique_lock<std::mutex> aLock(myMutex);
+    if (myIsRecording
+     && myLastSlot >= 0)
+    {
+      // the last frame remains on screen till the end of recording
+      const int64_t aStopSlot = int64_t(std::floor((currentTime() - myStartTime) * double(myParams.Fps) + 0.5));
+      myNbTrailing = std::max(aStopSlot - myLastSlot - 1, int64_t(0));
+      myStats.NbDuplicated += uint64_t(myNbTrailing);
+    }
+    myIsRecording = false;
+
+    // frame being copied outside of the lock should still reach the encoder
+    myCondition.wait(aLock, [this]() { return myNbCopying == 0; });
+    myToStop = true;
+  }
+  myCondition.notify_all();
+  if (myThread.joinable())
+    myThread.join();
+}
+
+// ================================================================
+// Function : PushFrame
+// ================================================================
+void OcctQtFrameRecorder::PushFrame(const uint8_t* theData, int theSizeX, int theSizeY, int theRowBytes, double theTime)
+{
+  Frame aFrame;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    if (!myIsRecording)
+      return;
+
+    ++myStats.NbPushed;
+    if (myFrameSizeX == 0)
+    {
+      myFrameSizeX = theSizeX;
+      myFrameSizeY = theSizeY;
+    }
+    if (theSizeX != myFrameSizeX || theSizeY != myFrameSizeY)
+    {
+      ++myStats.NbMismatched;
+      return;
+    }
+
+    // pace stream to the fixed frame rate by frame timestamps
+    if (myLastSlot < 0)
+      myStartTime = theTime;
+
+    const int64_t aSlot = int64_t(std::floor((theTime - myStartTime) * double(myParams.Fps) + 0.5));
+    if (aSlot <= myLastSlot)
+    {
+      ++myStats.NbDecimated;
+      return;
+    }
+    if (myFreeFrames.empty())
+    {
+      // encoder is behind - drop the frame instead of blocking rendering thread;
+      // its slot will be filled by repeating the previous frame
+      ++myStats.NbDropped;
+      return;
+    }
+
+    aFrame = std::move(myFreeFrames.back());
+    myFreeFrames.pop_back();
+    aFrame.NbRepeatsOfPrevious = myLastSlot >= 0 ? int(aSlot - myLastSlot - 1) : 0;
+    myStats.NbDuplicated += uint64_t(aFrame.NbRepeatsOfPrevious);
+    myLastSlot = aSlot;
+    ++myNbCopying;
+  }
+
+  // copy outside of the lock; buffers are reused between frames
+  const size_t aRowSize = size_t(theSizeX) * 4;
+  aFrame.SizeX = theSizeX;
+  aFrame.SizeY = theSizeY;
+  aFrame.Data.resize(aRowSize * size_t(theSizeY));
+  if (size_t(theRowBytes) == aRowSize)
+  {
+    std::memcpy(aFrame.Data.data(), theData, aFrame.Data.size());
+  }
+  else
+  {
+    for (int aRowIter = 0; aRowIter < theSizeY; ++aRowIter)
+      std::memcpy(aFrame.Data.data() + aRowSize * size_t(aRowIter), theData + size_t(theRowBytes) * size_t(aRowIter), aRowSize);
+  }
+
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myQueue.push_back(std::move(aFrame));
+    myStats.QueueDepth    = int(myQueue.size());
+    myStats.MaxQueueDepth = std::max(myStats.MaxQueueDepth, myStats.QueueDepth);
+    --myNbCopying;
+  }
+  myCondition.notify_all(); // wake up both encoder and Stop()
+}
+
+// ================================================================
+// Function : encoderLoop
+// ================================================================
+void OcctQtFrameRecorder::encoderLoop()
+{
+  double aTotalTime = 0.0;
+  for (;;)
+  {
+    Frame aFrame;
+    {
+      std::unique_lock<std::mutex> aLock(myMutex);
+      myCondition.wait(aLock, [this]() { return myToStop || !myQueue.empty(); });
+      if (myQueue.empty())
+        break; // queued frames are encoded before stopping
+
+      aFrame = std::move(myQueue.front());
+      myQueue.pop_front();
+      myStats.QueueDepth = int(myQueue.size());
+    }
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    const bool isEncoded = encodeFrame(aFrame);
+    aTimer.Stop();
+    aTotalTime += aTimer.ElapsedTime();
+
+    std::lock_guard<std::mutex> aLock(myMutex);
+    if (isEncoded)
+      ++myStats.NbEncoded;
+    else
+      ++myStats.NbFailed;
+
+    myStats.EncodeTime = aTotalTime / double(myStats.NbEncoded + myStats.NbFailed);
+    myFreeFrames.push_back(std::move(aFrame));
+  }
+
+  // fill slots till the moment of stop
+  for (int64_t aRepeatIter = 0; aRepeatIter < myNbTrailing; ++aRepeatIter)
+  {
+    if (!repeatLastFrame())
+      break;
+  }
+
+  // finalize output
+  if (myY4mStream.is_open())
+    myY4mStream.close();
+  if (!myVideoRecorder.IsNull())
+  {
+    myVideoRecorder->Close();
+    myVideoRecorder.Nullify();
+  }
+}
+
+// ================================================================
+// Function : encodeFrame
+// ================================================================
+bool OcctQtFrameRecorder::encodeFrame(const Frame& theFrame)
+{
+  for (int aRepeatIter = 0; aRepeatIter < theFrame.NbRepeatsOfPrevious; ++aRepeatIter)
+  {
+    if (!repeatLastFrame())
+      break;
+  }
+
+  bool isDone = false;
+  switch (myFormat)
+  {
+    case Format_Y4M:    isDone = writeY4m(theFrame);    break;
+    case Format_PNG:    isDone = writePng(theFrame);    break;
+    case Format_FFmpeg: isDone = writeFFmpeg(theFrame); break;
+  }
+  if (isDone)
+    ++myNbWritten;
+
+  return isDone;
+}
+
+// ================================================================
+// Function : repeatLastFrame
+// ================================================================
+bool OcctQtFrameRecorder::repeatLastFrame()
+{
+  bool isDone = false;
+  switch (myFormat)
+  {
+    case Format_Y4M:
+    {
+      // converted frame is kept in the buffer
+      if (!myY4mStream.is_open() || myYuvBuffer.empty())
+        return false;
+
+      myY4mStream << "FRAME\n";
+      myY4mStream.write((const char* )myYuvBuffer.data(), std::streamsize(myYuvBuffer.size()));
+      isDone = myY4mStream.good();
+      break;
+    }
+    case Format_PNG:
+    {
+      if (myLastPngPath.isEmpty())
+        return false;
+
+      const QString aFilePath = pngFilePath();
+      QFile::remove(aFilePath);
+      isDone = QFile::copy(myLastPngPath, aFilePath);
+      if (isDone)
+        myLastPngPath = aFilePath;
+      break;
+    }
+    case Format_FFmpeg:
+    {
+      // frame buffer of video recorder keeps the last frame
+      if (myVideoRecorder.IsNull())
+        return false;
+
+      isDone = myVideoRecorder->PushFrame();
+      break;
+    }
+  }
+  if (isDone)
+    ++myNbWritten;
+
+  return isDone;
+}
+
+// ================================================================
+// Function : pngFilePath
+// ================================================================
+QString OcctQtFrameRecorder::pngFilePath() const
+{
+  const QFileInfo aFileInfo(myParams.FilePath);
+  return aFileInfo.path() + "/" + aFileInfo.completeBaseName()
+       + QString("_%1.png").arg(qulonglong(myNbWritten), 6, 10, QChar('0'));
+}
+
+// ================================================================
+// Function : writeY4m
+// ================================================================
+bool OcctQtFrameRecorder::writeY4m(const Frame& theFrame)
+{
+  const int aSizeX = theFrame.SizeX, aSizeY = theFrame.SizeY;
+  const int aChromaX = (aSizeX + 1) / 2, aChromaY = (aSizeY + 1) / 2;
+  if (!myY4mStream.is_open())
+  {
+    if (myIsOutputFailed)
+      return false;
+
+    OSD_OpenStream(myY4mStream, myParams.FilePath.toUtf8().constData(), std::ios::out | std::ios::binary);
+    if (!myY4mStream.is_open())
+    {
+      setError(QString("unable to create '%1'").arg(myParams.FilePath));
+      myIsOutputFailed = true;
+      return false;
+    }
+
+    // full-range chroma sited as JPEG
+    myY4mStream << "YUV4MPEG2 W" << aSizeX << " H" << aSizeY << " F" << myParams.Fps << ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+  }
+
+  myYuvBuffer.resize(size_t(aSizeX) * size_t(aSizeY) + 2 * size_t(aChromaX) * size_t(aChromaY));
+  uint8_t* aPlaneY = myYuvBuffer.data();
+  uint8_t* aPlaneU = aPlaneY + size_t(aSizeX) * size_t(aSizeY);
+  uint8_t* aPlaneV = aPlaneU + size_t(aChromaX) * size_t(aChromaY);
+  const size_t aRowSize = size_t(aSizeX) * 4;
+  for (int aRowIter = 0; aRowIter < aSizeY; ++aRowIter)
+  {
+    // flip bottom-up rows
+    const uint8_t* aSrcRow = theFrame.Data.data() + aRowSize * size_t(aSizeY - aRowIter - 1);
+    uint8_t*       aDstRow = aPlaneY + size_t(aSizeX) * size_t(aRowIter);
+    for (int aColIter = 0; aColIter < aSizeX; ++aColIter)
+    {
+      const uint8_t* aPix = aSrcRow + aColIter * 4;
+      aDstRow[aColIter] = rgbToY(aPix[0], aPix[1], aPix[2]);
+    }
+  }
+  for (int aRowIter = 0; aRowIter < aChromaY; ++aRowIter)
+  {
+    // average 2x2 blocks (clamped at odd borders)
+    const int aRow0 = aSizeY - 2 * aRowIter - 1;
+    const int aRow1 = std::max(aRow0 - 1, 0);
+    const uint8_t* aSrcRow0 = theFrame.Data.data() + aRowSize * size_t(aRow0);
+    const uint8_t* aSrcRow1 = theFrame.Data.data() + aRowSize * size_t(aRow1);
+    for (int aColIter = 0; aColIter < aChromaX; ++aColIter)
+    {
+      const int aCol0 = 2 * aColIter * 4;
+      const int aCol1 = std::min(2 * aColIter + 1, aSizeX - 1) * 4;
+      int aRgb[3] = {};
+      for (int aCompIter = 0; aCompIter < 3; ++aCompIter)
+      {
+        aRgb[aCompIter] = (aSrcRow0[aCol0 + aCompIter] + aSrcRow0[aCol1 + aCompIter]
+                         + aSrcRow1[aCol0 + aCompIter] + aSrcRow1[aCol1 + aCompIter] + 2) / 4;
+      }
+      const size_t anIndex = size_t(aChromaX) * size_t(aRowIter) + size_t(aColIter);
+      rgbToUV(aRgb[0], aRgb[1], aRgb[2], aPlaneU[anIndex], aPlaneV[anIndex]);
+    }
+  }
+
+  myY4mStream << "FRAME\n";
+  myY4mStream.write((const char* )myYuvBuffer.data(), std::streamsize(myYuvBuffer.size()));
+  return myY4mStream.good();
+}
+
+// ================================================================
+// Function : writePng
+// ================================================================
+bool OcctQtFrameRecorder::writePng(const Frame& theFrame)
+{
+  // wrap buffer without copy and let mirrored() flip bottom-up rows
+  const QImage anImage((const uchar* )theFrame.Data.data(), theFrame.SizeX, theFrame.SizeY,
+                       theFrame.SizeX * 4, QImage::Format_RGBX8888);
+  const QString aFilePath = pngFilePath();
+  if (!anImage.mirrored().save(aFilePath, "PNG"))
+    return false;
+
+  myLastPngPath = aFilePath;
+  return true;
+}
+
+// ================================================================
+// Function : writeFFmpeg
+// ================================================================
+bool OcctQtFrameRecorder::writeFFmpeg(const Frame& theFrame)
+{
+  if (myVideoRecorder.IsNull())
+  {
+    if (myIsOutputFailed)
+      return false;
+
+    Image_VideoParams aParams;
+    aParams.Width  = theFrame.SizeX;
+    aParams.Height = theFrame.SizeY;
+    aParams.FpsNum = myParams.Fps;
+    aParams.FpsDen = 1;
+    myVideoRecorder = new Image_VideoRecorder();
+    if (!myVideoRecorder->Open(myParams.FilePath.toUtf8().constData(), aParams))
+    {
+      myVideoRecorder.Nullify();
+      setError(QString("unable to open '%1' for video encoding (OCCT might be built without FFmpeg; use .y4m or .png output)").arg(myParams.FilePath));
+      myIsOutputFailed = true;
+      return false;
+    }
+  }
+
+  // Image_PixMap::ChangeRow() indexes rows top-down regardless of memory layout
+  Image_PixMap& aPixMap = myVideoRecorder->ChangeFrame();
+  const size_t aRowSize = std::min(size_t(theFrame.SizeX) * 4, aPixMap.SizeRowBytes());
+  for (int aRowIter = 0; aRowIter < theFrame.SizeY && size_t(aRowIter) < aPixMap.SizeY(); ++aRowIter)
+  {
+    std::memcpy(aPixMap.ChangeRow(size_t(aRowIter)),
+                theFrame.Data.data() + size_t(theFrame.SizeX) * 4 * size_t(theFrame.SizeY - aRowIter - 1),
+                aRowSize);
+  }
+  return myVideoRecorder->PushFrame();
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtFrameRecorder_HeaderFile
+#define _OcctQtFrameRecorder_HeaderFile
+
+#include <Standard_Handle.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QString>
+#include <Standard_WarningsRestore.hxx>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Image_VideoRecorder;
+
+//! Video recording of rendered frames.
+//!
+//! Frames are passed by PushFrame() (typically as OcctQtFrameCapture frame listener, so that readback is asynchronous)
+//! and copied into a bounded queue of preallocated buffers consumed by the encoder thread.
+//! Frames are dropped instead of blocking rendering thread when the queue is full.
+//! Stream is paced by frame timestamps to the fixed frame rate: frames falling into already filled slot are dropped,
+//! while the previous frame is repeated for slots without frames (e.g. while the view was not redrawn),
+//! including slots till the moment of Stop().
+//! Output format is deduced from file extension:
+//! - .y4m - raw YUV 4:2:0 stream (YUV4MPEG2);
+//! - .png - sequence of PNG images with frame index appended to the file name;
+//! - other (.mkv, .mp4, .webm) - FFmpeg encoding through Image_VideoRecorder (requires OCCT built with FFmpeg).
+class OcctQtFrameRecorder
+{
+public:
+  //! Recording parameters.
+  struct Params
+  {
+    QString FilePath;            //!< output file path
+    int     Fps = 30;            //!< frame rate written into the stream
+    int     QueueCapacity = 8;   //!< number of frames buffered for the encoder
+  };
+
+  //! Recording statistics.
+  struct Stats
+  {
+    uint64_t NbPushed      = 0;   //!< number of frames passed to the recorder
+    uint64_t NbEncoded     = 0;   //!< number of encoded frames
+    uint64_t NbDropped     = 0;   //!< number of frames dropped due to full queue (backpressure)
+    uint64_t NbDecimated   = 0;   //!< number of frames dropped as their slot has been already filled
+    uint64_t NbDuplicated  = 0;   //!< number of repeated frames filling slots without frames
+    uint64_t NbMismatched  = 0;   //!< number of frames dropped due to frame size change
+    uint64_t NbFailed      = 0;   //!< number of frames failed to be encoded
+    int      QueueDepth    = 0;   //!< current number of queued frames
+    int      MaxQueueDepth = 0;   //!< maximum number of queued frames
+    double   EncodeTime    = 0.0; //!< average encoding time per frame in seconds
+  };
+
+public:
+  //! Empty constructor.
+  OcctQtFrameRecorder();
+
+  //! Destructor, stopping recording.
+  ~OcctQtFrameRecorder();
+
+  //! Return TRUE if recording is active.
+  bool IsRecording() const;
+
+  //! Start recording; the previous recording is stopped.
+  //! @return FALSE if output format is unsupported
+  bool Start(const Params& theParams);
+
+  //! Stop recording, waiting for frames being pushed and for the encoder thread to encode queued frames.
+  void Stop();
+
+  //! Return error message of the last failure.
+  QString LastError() const;
+
+  //! Return recording statistics.
+  Stats Statistics() const;
+
+  //! Copy frame into the queue or drop it when queue is full (never blocks on encoder).
+  //! Frame size is fixed by the first frame; frames of another size are dropped.
+  //! @param[in] theData      bottom-up RGBA8 rows
+  //! @param[in] theSizeX     frame width
+  //! @param[in] theSizeY     frame height
+  //! @param[in] theRowBytes  row stride in bytes
+  //! @param[in] theTime      moment the frame has been rendered in seconds of std::chrono::steady_clock
+  void PushFrame(const uint8_t* theData, int theSizeX, int theSizeY, int theRowBytes, double theTime);
+
+private:
+  //! Output format.
+  enum Format
+  {
+    Format_Y4M,
+    Format_PNG,
+    Format_FFmpeg,
+  };
+
+  //! Queued frame.
+  struct Frame
+  {
+    std::vector<uint8_t> Data; //!< bottom-up RGBA8 rows without padding
+    int SizeX = 0;
+    int SizeY = 0;
+    int NbRepeatsOfPrevious = 0; //!< number of times to repeat the previous frame before this one
+  };
+
+private:
+  //! Encoder thread procedure.
+  void encoderLoop();
+
+  //! Return current time in seconds of std::chrono::steady_clock.
+  static double currentTime();
+
+  //! Encode single frame (encoder thread).
+  bool encodeFrame(const Frame& theFrame);
+
+  //! Write the last encoded frame once more (encoder thread).
+  bool repeatLastFrame();
+
+  //! Write frame into Y4M stream (encoder thread).
+  bool writeY4m(const Frame& theFrame);
+
+  //! Write frame into PNG file (encoder thread).
+  bool writePng(const Frame& theFrame);
+
+  //! Return path to the next PNG file of the sequence (encoder thread).
+  QString pngFilePath() const;
+
+  //! Write frame through FFmpeg (encoder thread).
+  bool writeFFmpeg(const Frame& theFrame);
+
+  //! Set error message.
+  void setError(const QString& theError);
+
+private:
+  mutable std::mutex      myMutex;
+  std::condition_variable myCondition;
+  std::thread             myThread;
+  std::deque<Frame>       myQueue;      //!< frames waiting for encoder
+  std::vector<Frame>      myFreeFrames; //!< preallocated frames
+  Params                  myParams;
+  Stats                   myStats;
+  QString                 myError;
+  Format                  myFormat = Format_Y4M;
+  int                     myFrameSizeX = 0;
+  int                     myFrameSizeY = 0;
+  double                  myStartTime = 0.0;  //!< timestamp of the first frame
+  int64_t                 myLastSlot = -1;    //!< slot of the last accepted frame
+  int64_t                 myNbTrailing = 0;   //!< number of slots to be filled by the last frame on stop
+  int                     myNbCopying = 0;    //!< number of frames being copied by PushFrame() outside of the lock
+  bool                    myIsRecording = false;
+  bool                    myToStop = false;
+
+  // encoder thread state
+  std::ofstream               myY4mStream;
+  std::vector<uint8_t>        myYuvBuffer;
+  QString                     myLastPngPath;
+  Handle(Image_VideoRecorder) myVideoRecorder;
+  uint64_t                    myNbWritten = 0;
+  bool                        myIsOutputFailed = false;
+};
+
+#endif // _OcctQtFrameRecorder_HeaderFile
@@ -0,0 +1,158 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctQtFrameScheduler.h"
+
+#include <AIS_Animation.hxx>
+#include <Standard_Version.hxx>
+
+#include <cmath>
+
+namespace
+{
+  //! Timeout to consider frame in flight as lost (e.g. when hidden widget never swaps buffers).
+  static const double THE_LOST_FRAME_TIMEOUT = 0.25;
+
+  //! Presentation intervals longer than this are considered as idle gaps and not averaged.
+  static const double THE_IDLE_INTERVAL = 0.25;
+}
+
+// ================================================================
+// Function : OcctQtFrameScheduler
+// ================================================================
+OcctQtFrameScheduler::OcctQtFrameScheduler(QObject* theParent)
+: QObject(theParent)
+{
+  myClock.start();
+  myCapTimer.setSingleShot(true);
+  myCapTimer.setTimerType(Qt::PreciseTimer);
+  connect(&myCapTimer, &QTimer::timeout, this, &OcctQtFrameScheduler::dispatchFrame);
+}
+
+// ================================================================
+// Function : SetMaxFps
+// ================================================================
+void OcctQtFrameScheduler::SetMaxFps(double theFps)
+{
+  myMaxFps = theFps > 0.0 ? theFps : 0.0;
+  myCapTimer.stop();
+  dispatchFrame();
+}
+
+// ================================================================
+// Function : NextPresentationTime
+// ================================================================
+double OcctQtFrameScheduler::NextPresentationTime() const
+{
+  const double aTime = CurrentTime();
+  const double aNextTime = myLastPresentTime + myFrameInterval;
+  // after idle, the next frame will be presented within one interval from now
+  return aNextTime > aTime ? aNextTime : aTime + myFrameInterval;
+}
+
+// ================================================================
+// Function : RequestFrame
+// ================================================================
+void OcctQtFrameScheduler::RequestFrame()
+{
+  myIsPending = true;
+  dispatchFrame();
+}
+
+// ================================================================
+// Function : FrameStarted
+// ================================================================
+void OcctQtFrameScheduler::FrameStarted()
+{
+  // all pending requests will be handled by this frame
+  myIsPending     = false;
+  myIsInFlight    = true;
+  myLastStartTime = CurrentTime();
+}
+
+// ================================================================
+// Function : FramePresented
+// ================================================================
+void OcctQtFrameScheduler::FramePresented()
+{
+  const double aTime  = CurrentTime();
+  const double aDelta = aTime - myLastPresentTime;
+  if (myLastPresentTime > 0.0 && aDelta < THE_IDLE_INTERVAL)
+    myFrameInterval = myFrameInterval * 0.9 + aDelta * 0.1;
+
+  myLastPresentTime = aTime;
+  myIsInFlight      = false;
+  dispatchFrame();
+}
+
+// ================================================================
+// Function : dispatchFrame
+// ================================================================
+void OcctQtFrameScheduler::dispatchFrame()
+{
+  if (!myIsPending)
+    return;
+
+  const double aTime = CurrentTime();
+  if (myIsInFlight)
+  {
+    // wait for presentation of the previous frame, but not forever
+    const double aLostTime = myLastStartTime + THE_LOST_FRAME_TIMEOUT;
+    if (aTime < aLostTime)
+    {
+      if (!myCapTimer.isActive())
+        myCapTimer.start(int(std::ceil((aLostTime - aTime) * 1000.0)));
+
+      return;
+    }
+  }
+
+  if (myMaxFps > 0.0)
+  {
+    const double aNextTime = myLastPresentTime + 1.0 / myMaxFps;
+    if (aTime < aNextTime)
+    {
+      if (!myCapTimer.isActive())
+        myCapTimer.start(int(std::ceil((aNextTime - aTime) * 1000.0)));
+
+      return;
+    }
+  }
+
+  myCapTimer.stop();
+  myIsPending     = false;
+  myIsInFlight    = true;
+  myLastStartTime = aTime;
+  emit frameRequested();
+}
+
+// ================================================================
+// Function : SyncAnimationTimer
+// ================================================================
+void OcctQtFrameScheduler::SyncAnimationTimer(const Handle(AIS_Animation)& theAnim,
+                                              double thePresentTime)
+{
+#if (OCC_VERSION_HEX >= 0x070500)
+  if (theAnim.IsNull() || theAnim->IsStopped() || theAnim->Timer().IsNull())
+  {
+    myAnimPresentTime = -1.0;
+    return;
+  }
+
+  const Handle(Media_Timer)& aTimer = theAnim->Timer();
+  if (aTimer->IsStarted() || myAnimPresentTime < 0.0)
+  {
+    // animation has been (re)started - take control over its timer
+    aTimer->Pause();
+    myAnimPresentTime = thePresentTime;
+    return;
+  }
+
+  const double aStep = thePresentTime - myAnimPresentTime;
+  myAnimPresentTime = thePresentTime;
+  if (aStep > 0.0)
+    aTimer->Seek(aTimer->ElapsedTime() + aStep);
+#else
+  (void)theAnim;
+  (void)thePresentTime;
+#endif
+}
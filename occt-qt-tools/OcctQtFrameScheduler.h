@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtFrameScheduler_HeaderFile
+#define _OcctQtFrameScheduler_HeaderFile
+
+#include <Standard_Handle.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <Standard_WarningsRestore.hxx>
+
+class AIS_Animation;
+
+//! Frame scheduler driven by presentation events like QOpenGLWidget::frameSwapped() / QQuickWindow::frameSwapped().
+//!
+//! Instead of calling update() on every input event or animation step,
+//! the viewer calls RequestFrame() and redraws on frameRequested() signal.
+//! The scheduler keeps at most one frame in flight (requested but not yet presented)
+//! and optionally limits the frame rate, so that redraws are never queued faster than they could be presented.
+//!
+//! Scheduler should be used from GUI thread, with the following exception:
+//! QtQuick viewers call FrameStarted(), NextPresentationTime() and CurrentTime() from
+//! QQuickFramebufferObject::Renderer::synchronize() / QQuickWindow::beforeSynchronizing() (direct connection)
+//! on the scene graph rendering thread, which is safe only because GUI thread is blocked during synchronization.
+//! These methods don't touch timers and don't emit signals, unlike RequestFrame() and FramePresented(),
+//! which should be always called from GUI thread (e.g. through queued connection from rendering thread).
+//! SyncAnimationTimer() might be called from rendering thread at any time.
+class OcctQtFrameScheduler : public QObject
+{
+  Q_OBJECT
+public:
+  //! Main constructor.
+  OcctQtFrameScheduler(QObject* theParent = nullptr);
+
+  //! Return frame rate limit; 0 means no limit (presentation-bound).
+  double MaxFps() const { return myMaxFps; }
+
+  //! Set frame rate limit; 0 means no limit (presentation-bound).
+  void SetMaxFps(double theFps);
+
+  //! Return TRUE if frame has been requested or started but not yet presented.
+  bool IsFrameInFlight() const { return myIsInFlight; }
+
+  //! Return current time in seconds (monotonic clock of this scheduler).
+  double CurrentTime() const { return double(myClock.nsecsElapsed()) * 1.0e-9; }
+
+  //! Return time of the last presented frame in seconds.
+  double LastPresentationTime() const { return myLastPresentTime; }
+
+  //! Return estimated interval between presented frames in seconds.
+  double FrameInterval() const { return myFrameInterval; }
+
+  //! Return expected presentation time of the next frame in seconds.
+  double NextPresentationTime() const;
+
+  //! Drive the animation timer by presentation time instead of time of rendering.
+  //! Should be called before AIS_ViewController::handleViewRedraw() with NextPresentationTime() value;
+  //! animation timer is paused and advanced manually by steps between presentation times.
+  //! Might be called from rendering thread (the only method touching animation state).
+  void SyncAnimationTimer(const Handle(AIS_Animation)& theAnim,
+                          double thePresentTime);
+
+public slots:
+  //! Request a new frame; frameRequested() will be emitted at most once per presented frame.
+  void RequestFrame();
+
+  //! Notify that frame rendering has been started (e.g. paintGL() has been called).
+  //! Might be called from rendering thread only while GUI thread is blocked (e.g. within synchronize()).
+  void FrameStarted();
+
+  //! Notify that frame has been presented (e.g. frameSwapped() has been emitted).
+  void FramePresented();
+
+signals:
+  //! Emitted when a new frame should be redrawn (viewer should call update()).
+  void frameRequested();
+
+private:
+  //! Emit frameRequested() if no frame is in flight and frame rate limit allows.
+  void dispatchFrame();
+
+private:
+  QElapsedTimer myClock;
+  QTimer        myCapTimer;
+  double        myMaxFps          = 0.0;
+  double        myLastPresentTime = 0.0;
+  double        myLastStartTime   = 0.0;
+  double        myFrameInterval   = 1.0 / 60.0;
+  double        myAnimPresentTime = -1.0;
+  bool          myIsPending       = false;
+  bool          myIsInFlight      = false;
+};
+
+#endif // _OcctQtFrameScheduler_HeaderFile
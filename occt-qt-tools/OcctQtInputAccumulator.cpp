@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctQtInputAccumulator.h"
+
+#include "OcctInputLatency.h"
+#include "OcctInputPredictor.h"
+#include "OcctQtTools.h"
+
+// ================================================================
+// Function : Flush
+// ================================================================
+bool OcctQtInputAccumulator::Flush(Aspect_WindowInputListener& theListener)
+{
+  bool toUpdate = false;
+  for (const InputEvent& anEvent : myEvents)
+  {
+    switch (anEvent.Type)
+    {
+      case InputEventType_Move:
+        toUpdate = theListener.UpdateMousePosition(anEvent.Point, anEvent.Buttons, anEvent.Modifiers, anEvent.IsEmulated)
+                || toUpdate;
+        break;
+      case InputEventType_Buttons:
+        toUpdate = theListener.UpdateMouseButtons(anEvent.Point, anEvent.Buttons, anEvent.Modifiers, anEvent.IsEmulated)
+                || toUpdate;
+        break;
+      case InputEventType_Scroll:
+        toUpdate = theListener.UpdateMouseScroll(anEvent.Scroll) || toUpdate;
+        break;
+    }
+  }
+
+  myNbRawLast    = myNbRawEvents;
+  myNbMergedLast = myNbRawEvents - (int)myEvents.size();
+  Clear();
+  if (myLatency != nullptr)
+    myLatency->InputsFlushed();
+
+  return toUpdate;
+}
+
+// ================================================================
+// Function : UpdateMousePosition
+// ================================================================
+void OcctQtInputAccumulator::UpdateMousePosition(const Graphic3d_Vec2i& thePoint,
+                                                 Aspect_VKeyMouse theButtons,
+                                                 Aspect_VKeyFlags theModifiers,
+                                                 bool theIsEmulated)
+{
+  ++myNbRawEvents;
+  if (!myEvents.empty())
+  {
+    // only the last position matters for consecutive moves
+    InputEvent& aLast = myEvents.back();
+    if (aLast.Type == InputEventType_Move
+     && aLast.Buttons == theButtons
+     && aLast.Modifiers == theModifiers
+     && aLast.IsEmulated == theIsEmulated)
+    {
+      aLast.Point = thePoint;
+      return;
+    }
+  }
+
+  InputEvent anEvent;
+  anEvent.Type       = InputEventType_Move;
+  anEvent.Point      = thePoint;
+  anEvent.Buttons    = theButtons;
+  anEvent.Modifiers  = theModifiers;
+  anEvent.IsEmulated = theIsEmulated;
+  myEvents.push_back(anEvent);
+}
+
+// ================================================================
+// Function : UpdateMouseButtons
+// ================================================================
+void OcctQtInputAccumulator::UpdateMouseButtons(const Graphic3d_Vec2i& thePoint,
+                                                Aspect_VKeyMouse theButtons,
+                                                Aspect_VKeyFlags theModifiers,
+                                                bool theIsEmulated)
+{
+  ++myNbRawEvents;
+  InputEvent anEvent;
+  anEvent.Type       = InputEventType_Buttons;
+  anEvent.Point      = thePoint;
+  anEvent.Buttons    = theButtons;
+  anEvent.Modifiers  = theModifiers;
+  anEvent.IsEmulated = theIsEmulated;
+  myEvents.push_back(anEvent);
+}
+
+// ================================================================
+// Function : UpdateMouseScroll
+// ================================================================
+void OcctQtInputAccumulator::UpdateMouseScroll(const Aspect_ScrollDelta& theDelta)
+{
+  ++myNbRawEvents;
+  if (!myEvents.empty())
+  {
+    InputEvent& aLast = myEvents.back();
+    if (aLast.Type == InputEventType_Scroll
+     && aLast.Scroll.Flags == theDelta.Flags)
+    {
+      aLast.Scroll.Point  = theDelta.Point;
+      aLast.Scroll.Delta += theDelta.Delta;
+      return;
+    }
+  }
+
+  InputEvent anEvent;
+  anEvent.Type   = InputEventType_Scroll;
+  anEvent.Scroll = theDelta;
+  myEvents.push_back(anEvent);
+}
+
+// ================================================================
+// Function : AddHoverEvent
+// ================================================================
+bool OcctQtInputAccumulator::AddHoverEvent(double theDevicePixelRatio,
+                                           const QHoverEvent* theEvent)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  const Graphic3d_Vec2d aPnt2d(theEvent->position().x(), theEvent->position().y());
+#else
+  const Graphic3d_Vec2d aPnt2d(theEvent->pos().x(), theEvent->pos().y());
+#endif
+  const Graphic3d_Vec2i  aPnt2i(aPnt2d * theDevicePixelRatio + Graphic3d_Vec2d(0.5));
+  const Aspect_VKeyFlags aFlags = OcctQtTools::qtMouseModifiers2VKeys(theEvent->modifiers());
+  UpdateMousePosition(aPnt2i, Aspect_VKeyMouse_NONE, aFlags, false);
+  if (myLatency != nullptr)
+    myLatency->AddInput(theEvent->timestamp());
+  return true;
+}
+
+// ================================================================
+// Function : AddMouseEvent
+// ================================================================
+bool OcctQtInputAccumulator::AddMouseEvent(double theDevicePixelRatio,
+                                           const QMouseEvent* theEvent)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  const Graphic3d_Vec2d aPnt2d(theEvent->position().x(), theEvent->position().y());
+#else
+  const Graphic3d_Vec2d aPnt2d(theEvent->pos().x(), theEvent->pos().y());
+#endif
+  const Graphic3d_Vec2d  aPntBack(aPnt2d * theDevicePixelRatio);
+  const Graphic3d_Vec2i  aPnt2i(aPntBack + Graphic3d_Vec2d(0.5));
+  const Aspect_VKeyMouse aButtons = OcctQtTools::qtMouseButtons2VKeys(theEvent->buttons());
+  const Aspect_VKeyFlags aFlags = OcctQtTools::qtMouseModifiers2VKeys(theEvent->modifiers());
+  if (theEvent->type() == QEvent::MouseMove)
+  {
+    UpdateMousePosition(aPnt2i, aButtons, aFlags, false);
+  }
+  else if (OcctQtTools::qtMouseButtons2VKeys(theEvent->button()) == Aspect_VKeyMouse_NONE)
+  {
+    return false; // press or release of a button unknown to AIS_ViewController
+  }
+  else
+  {
+    UpdateMouseButtons(aPnt2i, aButtons, aFlags, false);
+  }
+
+  if (myLatency != nullptr)
+    myLatency->AddInput(theEvent->timestamp());
+  if (myPredictor != nullptr)
+    myPredictor->AddMouseSample(aPntBack, aButtons, aFlags, theEvent->timestamp());
+  return true;
+}
+
+// ================================================================
+// Function : AddWheelEvent
+// ================================================================
+bool OcctQtInputAccumulator::AddWheelEvent(double theDevicePixelRatio,
+                                           const QWheelEvent* theEvent)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+  const Graphic3d_Vec2d aPnt2d(theEvent->position().x(), theEvent->position().y());
+#else
+  const Graphic3d_Vec2d aPnt2d(theEvent->pos().x(), theEvent->pos().y());
+#endif
+  const Graphic3d_Vec2i aPnt2i(aPnt2d * theDevicePixelRatio + Graphic3d_Vec2d(0.5));
+  if (theEvent->angleDelta().y() == 0)
+    return false; // horizontal scrolling is not handled
+
+  UpdateMouseScroll(Aspect_ScrollDelta(aPnt2i, double(theEvent->angleDelta().y()) / 120.0));
+  if (myLatency != nullptr)
+    myLatency->AddInput(theEvent->timestamp());
+  return true;
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtInputAccumulator_HeaderFile
+#define _OcctQtInputAccumulator_HeaderFile
+
+#include <Aspect_ScrollDelta.hxx>
+#include <Aspect_WindowInputListener.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QMouseEvent>
+#include <Standard_WarningsRestore.hxx>
+
+#include <vector>
+
+class OcctInputLatency;
+class OcctInputPredictor;
+
+//! Accumulator of Qt mouse input events to be passed to OCCT listener once per frame.
+//!
+//! High-frequency input devices (1000 Hz mice, trackpads) generate many events per displayed frame,
+//! so that passing each one to AIS_ViewController leads to redundant processing (like dynamic highlighting).
+//! The accumulator merges consecutive mouse moves, sums wheel deltas and keeps button transitions in order.
+//! Queued events should be passed to the listener by Flush() right before AIS_ViewController::FlushViewEvents().
+//!
+//! The class is not thread-safe - Flush() should be called while GUI thread is blocked
+//! (e.g. within QQuickFramebufferObject::Renderer::synchronize()).
+//! Qt events are converted into backing store pixels by device pixel ratio passed from GUI thread,
+//! so that queueing never accesses V3d_View, which might be owned by another (rendering) thread.
+//!
+//! Optional OcctInputLatency is stamped by each queued raw event, and its stamps are closed into a batch by Flush().
+//! Optional OcctInputPredictor receives each raw mouse event, so that merged moves still contribute to velocity estimation.
+class OcctQtInputAccumulator
+{
+public:
+  //! Empty constructor.
+  OcctQtInputAccumulator() {}
+
+  //! Set latency histogram stamped by queued events (NULL by default).
+  void SetInputLatency(OcctInputLatency* theLatency) { myLatency = theLatency; }
+
+  //! Set predictor receiving samples of raw mouse events (NULL by default).
+  void SetInputPredictor(OcctInputPredictor* thePredictor) { myPredictor = thePredictor; }
+
+  //! Return TRUE if there are pending events.
+  bool HasEvents() const { return !myEvents.empty(); }
+
+  //! Return number of raw events queued since the last flush.
+  int NbPendingRawEvents() const { return myNbRawEvents; }
+
+  //! Return number of raw events passed to the listener by the last flush.
+  int NbRawEventsLastFrame() const { return myNbRawLast; }
+
+  //! Return number of raw events merged (not passed to the listener individually) by the last flush.
+  int NbMergedEventsLastFrame() const { return myNbMergedLast; }
+
+  //! Clear pending events.
+  void Clear()
+  {
+    myEvents.clear();
+    myNbRawEvents = 0;
+  }
+
+  //! Pass accumulated events to the listener and clear the queue;
+  //! events stamped into latency histogram (including ones passed to the listener directly) are closed into a batch.
+  //! @return TRUE if listener has requested view update
+  bool Flush(Aspect_WindowInputListener& theListener);
+
+public: //! @name methods for queueing Qt input events
+
+  //! Queue Qt mouse hover event.
+  //! @param[in] theDevicePixelRatio  device pixel ratio of the widget receiving the event
+  //! @param[in] theEvent             event to queue
+  //! @return TRUE if event has been queued
+  bool AddHoverEvent(double theDevicePixelRatio, const QHoverEvent* theEvent);
+
+  //! Queue Qt mouse event; press/release of buttons unknown to AIS_ViewController is ignored.
+  //! @return TRUE if event has been queued
+  bool AddMouseEvent(double theDevicePixelRatio, const QMouseEvent* theEvent);
+
+  //! Queue Qt mouse wheel event; events without vertical scrolling are ignored.
+  //! @return TRUE if event has been queued
+  bool AddWheelEvent(double theDevicePixelRatio, const QWheelEvent* theEvent);
+
+public: //! @name methods mirroring Aspect_WindowInputListener interface
+
+  //! Queue mouse position update; merged with the previous move with the same buttons and modifiers.
+  void UpdateMousePosition(const Graphic3d_Vec2i& thePoint,
+                           Aspect_VKeyMouse theButtons,
+                           Aspect_VKeyFlags theModifiers,
+                           bool theIsEmulated);
+
+  //! Queue mouse buttons state change; never merged to preserve transitions order.
+  void UpdateMouseButtons(const Graphic3d_Vec2i& thePoint,
+                          Aspect_VKeyMouse theButtons,
+                          Aspect_VKeyFlags theModifiers,
+                          bool theIsEmulated);
+
+  //! Queue mouse scroll; delta is summed up with the previous scroll event with the same modifiers.
+  void UpdateMouseScroll(const Aspect_ScrollDelta& theDelta);
+
+private:
+  //! Queued event type.
+  enum InputEventType
+  {
+    InputEventType_Move,
+    InputEventType_Buttons,
+    InputEventType_Scroll,
+  };
+
+  //! Queued event.
+  struct InputEvent
+  {
+    Aspect_ScrollDelta Scroll;
+    Graphic3d_Vec2i    Point;
+    Aspect_VKeyMouse   Buttons    = Aspect_VKeyMouse_NONE;
+    Aspect_VKeyFlags   Modifiers  = Aspect_VKeyFlags_NONE;
+    InputEventType     Type       = InputEventType_Move;
+    bool               IsEmulated = false;
+  };
+
+private:
+  std::vector<InputEvent> myEvents;
+  OcctInputLatency* myLatency = nullptr;
+  OcctInputPredictor* myPredictor = nullptr;
+  int myNbRawEvents  = 0;
+  int myNbRawLast    = 0;
+  int myNbMergedLast = 0;
+};
+
+#endif // _OcctQtInputAccumulator_HeaderFile
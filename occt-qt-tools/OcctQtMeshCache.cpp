@@ -0,0 +1,851 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctQtMeshCache.h"
+
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <Geom_Curve.hxx>
+#include <Geom_Surface.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Version.hxx>
+#include <TColStd_HArray1OfReal.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <Standard_WarningsRestore.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  //! File signature, including format version.
+  static const char THE_CACHE_MAGIC[8] = { 'O', 'C', 'C', 'M', 'E', 'S', 'H', '3' };
+
+  //! Default limit of total cache size.
+  static const uint64_t THE_DEFAULT_MAX_SIZE = uint64_t(512) * 1024 * 1024;
+
+  //! File header, followed by NbFaces face signatures, NbFaces face records and NbEdges edge records.
+  struct OcctMeshCacheHeader
+  {
+    char     Magic[8];
+    uint64_t Key;
+    uint32_t NbFaces;
+    uint32_t NbEdges;
+    double   LinDeflection;
+    double   AngDeflection;
+  };
+
+  //! Geometric signature of the face verified on restoring to reject entries with colliding key.
+  struct OcctMeshCacheFaceSignature
+  {
+    int32_t  SurfaceType; //!< GeomAbs_SurfaceType
+    uint32_t Orientation;
+    double   UVBounds[4]; //!< UMin, UMax, VMin, VMax
+    double   Params[8];   //!< surface-specific parameters (axis, radii, degrees, number of poles)
+    double   BoxMin[3];
+    double   BoxMax[3];
+  };
+
+  //! Compute geometric signature of the face.
+  static OcctMeshCacheFaceSignature faceSignature(const TopoDS_Face& theFace)
+  {
+    OcctMeshCacheFaceSignature aSign;
+    std::memset(&aSign, 0, sizeof(aSign)); // zero unused parameters to compare signatures bitwise
+    aSign.Orientation = uint32_t(theFace.Orientation());
+    if (BRep_Tool::Surface(theFace).IsNull())
+      return aSign;
+
+    BRepTools::UVBounds(theFace, aSign.UVBounds[0], aSign.UVBounds[1], aSign.UVBounds[2], aSign.UVBounds[3]);
+
+    const BRepAdaptor_Surface aSurf(theFace, false);
+    aSign.SurfaceType = int32_t(aSurf.GetType());
+    double* aParams = aSign.Params;
+    const auto setAxis = [aParams](const gp_Ax1& theAxis)
+    {
+      aParams[0] = theAxis.Location().X(); aParams[1] = theAxis.Location().Y(); aParams[2] = theAxis.Location().Z();
+      aParams[3] = theAxis.Direction().X(); aParams[4] = theAxis.Direction().Y(); aParams[5] = theAxis.Direction().Z();
+    };
+    switch (aSurf.GetType())
+    {
+      case GeomAbs_Plane:
+      {
+        setAxis(aSurf.Plane().Axis());
+        break;
+      }
+      case GeomAbs_Cylinder:
+      {
+        setAxis(aSurf.Cylinder().Axis());
+        aParams[6] = aSurf.Cylinder().Radius();
+        break;
+      }
+      case GeomAbs_Cone:
+      {
+        setAxis(aSurf.Cone().Axis());
+        aParams[6] = aSurf.Cone().RefRadius();
+        aParams[7] = aSurf.Cone().SemiAngle();
+        break;
+      }
+      case GeomAbs_Sphere:
+      {
+        setAxis(aSurf.Sphere().Position().Axis());
+        aParams[6] = aSurf.Sphere().Radius();
+        break;
+      }
+      case GeomAbs_Torus:
+      {
+        setAxis(aSurf.Torus().Axis());
+        aParams[6] = aSurf.Torus().MajorRadius();
+        aParams[7] = aSurf.Torus().MinorRadius();
+        break;
+      }
+      case GeomAbs_BezierSurface:
+      case GeomAbs_BSplineSurface:
+      {
+        const bool isBSpline = aSurf.GetType() == GeomAbs_BSplineSurface;
+        aParams[0] = aSurf.UDegree();
+        aParams[1] = aSurf.VDegree();
+        aParams[2] = aSurf.NbUPoles();
+        aParams[3] = aSurf.NbVPoles();
+        aParams[4] = isBSpline ? aSurf.NbUKnots() : 0;
+        aParams[5] = isBSpline ? aSurf.NbVKnots() : 0;
+        aParams[6] = aSurf.IsURational() ? 1.0 : 0.0;
+        aParams[7] = aSurf.IsVRational() ? 1.0 : 0.0;
+        break;
+      }
+      case GeomAbs_SurfaceOfRevolution:
+      {
+        setAxis(aSurf.AxeOfRevolution());
+        break;
+      }
+      case GeomAbs_SurfaceOfExtrusion:
+      {
+        aParams[3] = aSurf.Direction().X(); aParams[4] = aSurf.Direction().Y(); aParams[5] = aSurf.Direction().Z();
+        break;
+      }
+      case GeomAbs_OffsetSurface:
+      {
+        aParams[6] = aSurf.OffsetValue();
+        break;
+      }
+      default:
+      {
+        break;
+      }
+    }
+
+    Bnd_Box aBox;
+    BRepBndLib::Add(theFace, aBox, false);
+    if (!aBox.IsVoid())
+      aBox.Get(aSign.BoxMin[0], aSign.BoxMin[1], aSign.BoxMin[2], aSign.BoxMax[0], aSign.BoxMax[1], aSign.BoxMax[2]);
+    return aSign;
+  }
+
+  //! Face record flags.
+  enum OcctMeshCacheFaceFlags
+  {
+    OcctMeshCacheFaceFlags_UVNodes = 0x01,
+    OcctMeshCacheFaceFlags_Normals = 0x02,
+  };
+
+  //! Face record header, followed by double[3 * NbNodes] nodes, optional double[2 * NbNodes] UV nodes,
+  //! optional float[3 * NbNodes] normals and int32[3 * NbTriangles] triangles.
+  struct OcctMeshCacheFace
+  {
+    uint32_t NbNodes;
+    uint32_t NbTriangles;
+    uint32_t Flags;
+    uint32_t Reserved;
+    double   Deflection;
+  };
+
+  //! Edge record is uint32 number of polygons followed by polygon records.
+  //! Polygon record header, followed by int32[NbNodes] nodes, optional double[NbNodes] parameters,
+  //! and the same for the second polygon of seam edge (NbNodes2 > 0).
+  struct OcctMeshCachePolygon
+  {
+    uint32_t FaceIndex;   //!< 1-based index of the face owning triangulation
+    uint32_t NbNodes;
+    uint32_t NbNodes2;
+    uint32_t HasParams;
+    double   Deflection;
+  };
+
+  //! Append value to 64-bit FNV-1a hash.
+  template<typename T>
+  static uint64_t hashValue(uint64_t theHash, const T& theValue);
+
+  //! Append 64-bit FNV-1a hash.
+  static uint64_t hashFnv1a(uint64_t theHash, const void* theData, size_t theSize)
+  {
+    const unsigned char* aBytes = (const unsigned char*)theData;
+    for (size_t aByteIter = 0; aByteIter < theSize; ++aByteIter)
+    {
+      theHash ^= aBytes[aByteIter];
+      theHash *= 1099511628211ULL;
+    }
+    return theHash;
+  }
+
+  template<typename T>
+  static uint64_t hashValue(uint64_t theHash, const T& theValue)
+  {
+    return hashFnv1a(theHash, &theValue, sizeof(theValue));
+  }
+
+  //! Append point to hash.
+  static uint64_t hashPoint(uint64_t theHash, const gp_Pnt& thePnt)
+  {
+    theHash = hashValue(theHash, thePnt.X());
+    theHash = hashValue(theHash, thePnt.Y());
+    return hashValue(theHash, thePnt.Z());
+  }
+
+  //! Append class name of geometry to hash.
+  static uint64_t hashType(uint64_t theHash, const Handle(Standard_Transient)& theGeom)
+  {
+    const char* aName = !theGeom.IsNull() ? theGeom->DynamicType()->Name() : "";
+    return hashFnv1a(theHash, aName, std::strlen(aName));
+  }
+
+  //! Append array to byte buffer.
+  template<typename T>
+  static void appendArray(QByteArray& theData, const std::vector<T>& theArray)
+  {
+    if (!theArray.empty())
+      theData.append((const char*)theArray.data(), int(theArray.size() * sizeof(T)));
+  }
+
+  //! Append polygon nodes and parameters to byte buffer.
+  static void appendPolygon(QByteArray& theData, const Handle(Poly_PolygonOnTriangulation)& thePolygon, bool theHasParams)
+  {
+    const TColStd_Array1OfInteger& aNodes = thePolygon->Nodes();
+    std::vector<int32_t> aNodeIds;
+    aNodeIds.reserve(size_t(aNodes.Length()));
+    for (int aNodeIter = aNodes.Lower(); aNodeIter <= aNodes.Upper(); ++aNodeIter)
+      aNodeIds.push_back(int32_t(aNodes.Value(aNodeIter)));
+
+    appendArray(theData, aNodeIds);
+    if (!theHasParams)
+      return;
+
+    const TColStd_Array1OfReal& aParams = thePolygon->Parameters()->Array1();
+    std::vector<double> aParamValues(aParams.begin(), aParams.end());
+    appendArray(theData, aParamValues);
+  }
+
+  //! Bounded reader of memory-mapped data.
+  struct OcctMeshCacheReader
+  {
+    const uchar* Data = nullptr;
+    qint64       Size = 0;
+    qint64       Pos  = 0;
+
+    bool Read(void* theDst, qint64 theSize)
+    {
+      if (theSize < 0 || Pos + theSize > Size)
+        return false;
+
+      std::memcpy(theDst, Data + Pos, size_t(theSize));
+      Pos += theSize;
+      return true;
+    }
+
+    //! Read array of specified length.
+    template<typename T>
+    bool ReadArray(std::vector<T>& theArray, size_t theLength)
+    {
+      if (qint64(theLength * sizeof(T)) > Size - Pos)
+        return false;
+
+      theArray.resize(theLength);
+      return theLength == 0 || Read(theArray.data(), qint64(theLength * sizeof(T)));
+    }
+
+    //! Read polygon on triangulation with nodes validated against number of triangulation nodes.
+    Handle(Poly_PolygonOnTriangulation) ReadPolygon(uint32_t theNbNodes, bool theHasParams, double theDeflection, int theNbTriNodes)
+    {
+      std::vector<int32_t> aNodeIds;
+      std::vector<double>  aParamValues;
+      if (theNbNodes < 2
+      || !ReadArray(aNodeIds, theNbNodes)
+      || (theHasParams && !ReadArray(aParamValues, theNbNodes)))
+      {
+        return Handle(Poly_PolygonOnTriangulation)();
+      }
+
+      TColStd_Array1OfInteger aNodes(1, int(theNbNodes));
+      for (uint32_t aNodeIter = 0; aNodeIter < theNbNodes; ++aNodeIter)
+      {
+        if (aNodeIds[aNodeIter] < 1 || aNodeIds[aNodeIter] > theNbTriNodes)
+          return Handle(Poly_PolygonOnTriangulation)();
+
+        aNodes.SetValue(int(aNodeIter) + 1, aNodeIds[aNodeIter]);
+      }
+
+      Handle(Poly_PolygonOnTriangulation) aPolygon;
+      if (theHasParams)
+      {
+        TColStd_Array1OfReal aParams(1, int(theNbNodes));
+        for (uint32_t aNodeIter = 0; aNodeIter < theNbNodes; ++aNodeIter)
+          aParams.SetValue(int(aNodeIter) + 1, aParamValues[aNodeIter]);
+
+        aPolygon = new Poly_PolygonOnTriangulation(aNodes, aParams);
+      }
+      else
+      {
+        aPolygon = new Poly_PolygonOnTriangulation(aNodes);
+      }
+      aPolygon->Deflection(theDeflection);
+      return aPolygon;
+    }
+  };
+
+  //! Decoded polygon of edge on face triangulation.
+  struct OcctMeshCacheEdgePolygon
+  {
+    int                                 FaceIndex = 0;
+    Handle(Poly_PolygonOnTriangulation) Polygon1;
+    Handle(Poly_PolygonOnTriangulation) Polygon2; //!< second polygon of seam edge
+  };
+}
+
+// ================================================================
+// Function : DefaultFolder
+// ================================================================
+QString OcctQtMeshCache::DefaultFolder()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/occt-mesh-cache";
+}
+
+// ================================================================
+// Function : OcctQtMeshCache
+// ================================================================
+OcctQtMeshCache::OcctQtMeshCache(const QString& theFolder)
+: myFolder(theFolder),
+  myNbHits(0),
+  myNbMisses(0),
+  myNbBytesRead(0),
+  myNbBytesWritten(0),
+  myMaxSize(THE_DEFAULT_MAX_SIZE)
+{
+  QDir().mkpath(myFolder);
+}
+
+// ================================================================
+// Function : ResetStats
+// ================================================================
+void OcctQtMeshCache::ResetStats()
+{
+  myNbHits = 0;
+  myNbMisses = 0;
+  myNbBytesRead = 0;
+  myNbBytesWritten = 0;
+}
+
+// ================================================================
+// Function : StatsString
+// ================================================================
+TCollection_AsciiString OcctQtMeshCache::StatsString() const
+{
+  const size_t aNbTotal = NbHits() + NbMisses();
+  const double aHitRate = aNbTotal != 0 ? 100.0 * double(NbHits()) / double(aNbTotal) : 0.0;
+  return TCollection_AsciiString() + int(NbHits()) + " hits, " + int(NbMisses()) + " misses ("
+       + int(aHitRate) + "% hit rate), " + int(myNbBytesRead.load() / 1024) + " KiB read, "
+       + int(myNbBytesWritten.load() / 1024) + " KiB written";
+}
+
+// ================================================================
+// Function : PartKey
+// ================================================================
+uint64_t OcctQtMeshCache::PartKey(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection)
+{
+  // cheap signature instead of full serialization; part location doesn't affect triangulation
+  const TopoDS_Shape aPart = thePart.Located(TopLoc_Location());
+  TopTools_IndexedMapOfShape aVertices, anEdges, aFaces;
+  TopExp::MapShapes(aPart, TopAbs_VERTEX, aVertices);
+  TopExp::MapShapes(aPart, TopAbs_EDGE,   anEdges);
+  TopExp::MapShapes(aPart, TopAbs_FACE,   aFaces);
+
+  uint64_t aHash = 14695981039346656037ULL;
+  aHash = hashFnv1a(aHash, THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC));
+  aHash = hashValue(aHash, theLinDeflection);
+  aHash = hashValue(aHash, theAngDeflection);
+  aHash = hashValue(aHash, aVertices.Extent());
+  aHash = hashValue(aHash, anEdges.Extent());
+  aHash = hashValue(aHash, aFaces.Extent());
+  for (int aVertIter = 1; aVertIter <= aVertices.Extent(); ++aVertIter)
+  {
+    const TopoDS_Vertex& aVertex = TopoDS::Vertex(aVertices.FindKey(aVertIter));
+    aHash = hashPoint(aHash, BRep_Tool::Pnt(aVertex));
+    aHash = hashValue(aHash, BRep_Tool::Tolerance(aVertex));
+  }
+  for (int anEdgeIter = 1; anEdgeIter <= anEdges.Extent(); ++anEdgeIter)
+  {
+    const TopoDS_Edge& anEdge = TopoDS::Edge(anEdges.FindKey(anEdgeIter));
+    double aFirst = 0.0, aLast = 0.0;
+    const Handle(Geom_Curve) aCurve = BRep_Tool::Curve(anEdge, aFirst, aLast);
+    aHash = hashType(aHash, aCurve);
+    aHash = hashValue(aHash, aFirst);
+    aHash = hashValue(aHash, aLast);
+    aHash = hashValue(aHash, BRep_Tool::Tolerance(anEdge));
+    aHash = hashValue(aHash, int(anEdge.Orientation()));
+  }
+  for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter)
+  {
+    const TopoDS_Face& aFace = TopoDS::Face(aFaces.FindKey(aFaceIter));
+    aHash = hashType(aHash, BRep_Tool::Surface(aFace));
+    aHash = hashValue(aHash, BRep_Tool::Tolerance(aFace));
+    aHash = hashValue(aHash, int(aFace.Orientation()));
+
+    // bounding box from geometry distinguishes faces with the same boundary (e.g. different fillet radius)
+    Bnd_Box aBox;
+    BRepBndLib::Add(aFace, aBox, false);
+    if (!aBox.IsVoid())
+    {
+      aHash = hashPoint(aHash, aBox.CornerMin());
+      aHash = hashPoint(aHash, aBox.CornerMax());
+    }
+  }
+  return aHash;
+}
+
+// ================================================================
+// Function : filePath
+// ================================================================
+QString OcctQtMeshCache::filePath(uint64_t theKey) const
+{
+  return myFolder + "/" + QString("%1.omc").arg(qulonglong(theKey), 16, 16, QChar('0'));
+}
+
+// ================================================================
+// Function : Restore
+// ================================================================
+bool OcctQtMeshCache::Restore(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection)
+{
+  const uint64_t aKey = PartKey(thePart, theLinDeflection, theAngDeflection);
+  QFile aFile(filePath(aKey));
+  if (!aFile.open(QIODevice::ReadOnly))
+  {
+    ++myNbMisses;
+    return false;
+  }
+
+  OcctMeshCacheReader aReader;
+  aReader.Size = aFile.size();
+  aReader.Data = aFile.map(0, aReader.Size);
+  if (aReader.Data == nullptr)
+  {
+    ++myNbMisses;
+    return false;
+  }
+
+  TopTools_IndexedMapOfShape aFaces;
+  TopExp::MapShapes(thePart, TopAbs_FACE, aFaces);
+  TopTools_IndexedDataMapOfShapeListOfShape anEdgeFaces;
+  TopExp::MapShapesAndAncestors(thePart, TopAbs_EDGE, TopAbs_FACE, anEdgeFaces);
+
+  OcctMeshCacheHeader aHeader;
+  if (!aReader.Read(&aHeader, sizeof(aHeader))
+   || std::memcmp(aHeader.Magic, THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC)) != 0
+   || aHeader.Key != aKey
+   || aHeader.LinDeflection != theLinDeflection
+   || aHeader.AngDeflection != theAngDeflection
+   || int(aHeader.NbFaces) != aFaces.Extent()
+   || int(aHeader.NbEdges) != anEdgeFaces.Extent())
+  {
+    ++myNbMisses;
+    return false;
+  }
+
+  // key is a cheap hash - verify full signature of every face to never attach mesh of another part on collision
+  for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter)
+  {
+    OcctMeshCacheFaceSignature aStoredSign;
+    const OcctMeshCacheFaceSignature aFaceSign = faceSignature(TopoDS::Face(aFaces.FindKey(aFaceIter)));
+    if (!aReader.Read(&aStoredSign, sizeof(aStoredSign))
+     || std::memcmp(&aStoredSign, &aFaceSign, sizeof(aFaceSign)) != 0)
+    {
+      ++myNbMisses;
+      return false;
+    }
+  }
+
+  // decode all faces and edges before modifying the part to leave it untouched on corrupted file
+  std::vector<Handle(Poly_Triangulation)> aTriangulations(aFaces.Extent());
+  for (int aFaceIter = 0; aFaceIter < aFaces.Extent(); ++aFaceIter)
+  {
+    OcctMeshCacheFace aFaceHeader;
+    if (!aReader.Read(&aFaceHeader, sizeof(aFaceHeader)))
+    {
+      ++myNbMisses;
+      return false;
+    }
+    if (aFaceHeader.NbNodes == 0 || aFaceHeader.NbTriangles == 0)
+      continue;
+
+    const int  aNbNodes = int(aFaceHeader.NbNodes);
+    const int  aNbTris  = int(aFaceHeader.NbTriangles);
+    const bool hasUV      = (aFaceHeader.Flags & OcctMeshCacheFaceFlags_UVNodes) != 0;
+    const bool hasNormals = (aFaceHeader.Flags & OcctMeshCacheFaceFlags_Normals) != 0;
+    std::vector<double>  aNodes, aUVNodes;
+    std::vector<float>   aNormals;
+    std::vector<int32_t> aTriNodes;
+    if (!aReader.ReadArray(aNodes, size_t(aNbNodes) * 3)
+     || (hasUV      && !aReader.ReadArray(aUVNodes, size_t(aNbNodes) * 2))
+     || (hasNormals && !aReader.ReadArray(aNormals, size_t(aNbNodes) * 3))
+     || !aReader.ReadArray(aTriNodes, size_t(aNbTris) * 3))
+    {
+      ++myNbMisses;
+      return false;
+    }
+    for (int32_t aNodeId : aTriNodes)
+    {
+      if (aNodeId < 1 || aNodeId > aNbNodes)
+      {
+        ++myNbMisses;
+        return false;
+      }
+    }
+
+#if (OCC_VERSION_HEX >= 0x070600)
+    Handle(Poly_Triangulation) aTris = new Poly_Triangulation(aNbNodes, aNbTris, hasUV, hasNormals);
+#else
+    Handle(Poly_Triangulation) aTris = new Poly_Triangulation(aNbNodes, aNbTris, hasUV);
+#endif
+    aTris->Deflection(aFaceHeader.Deflection);
+    for (int aNodeIter = 1; aNodeIter <= aNbNodes; ++aNodeIter)
+    {
+      const double* aXYZ = aNodes.data() + size_t(aNodeIter - 1) * 3;
+      const gp_Pnt aPnt(aXYZ[0], aXYZ[1], aXYZ[2]);
+#if (OCC_VERSION_HEX >= 0x070600)
+      aTris->SetNode(aNodeIter, aPnt);
+#else
+      aTris->ChangeNode(aNodeIter) = aPnt;
+#endif
+      if (hasUV)
+      {
+        const gp_Pnt2d aUV(aUVNodes[size_t(aNodeIter - 1) * 2], aUVNodes[size_t(aNodeIter - 1) * 2 + 1]);
+#if (OCC_VERSION_HEX >= 0x070600)
+        aTris->SetUVNode(aNodeIter, aUV);
+#else
+        aTris->ChangeUVNode(aNodeIter) = aUV;
+#endif
+      }
+#if (OCC_VERSION_HEX >= 0x070600)
+      if (hasNormals)
+      {
+        const float* aNorm = aNormals.data() + size_t(aNodeIter - 1) * 3;
+        aTris->SetNormal(aNodeIter, gp_Vec3f(aNorm[0], aNorm[1], aNorm[2]));
+      }
+#endif
+    }
+#if (OCC_VERSION_HEX < 0x070600)
+    if (hasNormals)
+    {
+      Handle(TShort_HArray1OfShortReal) aNormArray = new TShort_HArray1OfShortReal(1, aNbNodes * 3);
+      for (int aCompIter = 0; aCompIter < aNbNodes * 3; ++aCompIter)
+        aNormArray->SetValue(aCompIter + 1, aNormals[size_t(aCompIter)]);
+      aTris->SetNormals(aNormArray);
+    }
+#endif
+    for (int aTriIter = 1; aTriIter <= aNbTris; ++aTriIter)
+    {
+      const int32_t* aTriNode = aTriNodes.data() + size_t(aTriIter - 1) * 3;
+#if (OCC_VERSION_HEX >= 0x070600)
+      aTris->SetTriangle(aTriIter, Poly_Triangle(aTriNode[0], aTriNode[1], aTriNode[2]));
+#else
+      aTris->ChangeTriangle(aTriIter) = Poly_Triangle(aTriNode[0], aTriNode[1], aTriNode[2]);
+#endif
+    }
+    aTriangulations[aFaceIter] = aTris;
+  }
+
+  std::vector<std::vector<OcctMeshCacheEdgePolygon>> anEdgePolygons(size_t(anEdgeFaces.Extent()));
+  for (int anEdgeIter = 0; anEdgeIter < anEdgeFaces.Extent(); ++anEdgeIter)
+  {
+    uint32_t aNbPolygons = 0;
+    if (!aReader.Read(&aNbPolygons, sizeof(aNbPolygons)))
+    {
+      ++myNbMisses;
+      return false;
+    }
+    for (uint32_t aPolyIter = 0; aPolyIter < aNbPolygons; ++aPolyIter)
+    {
+      OcctMeshCachePolygon aPolyHeader;
+      if (!aReader.Read(&aPolyHeader, sizeof(aPolyHeader))
+       || aPolyHeader.FaceIndex < 1
+       || int(aPolyHeader.FaceIndex) > aFaces.Extent()
+       || aTriangulations[aPolyHeader.FaceIndex - 1].IsNull())
+      {
+        ++myNbMisses;
+        return false;
+      }
+
+      const int aNbTriNodes = aTriangulations[aPolyHeader.FaceIndex - 1]->NbNodes();
+      OcctMeshCacheEdgePolygon anEdgePolygon;
+      anEdgePolygon.FaceIndex = int(aPolyHeader.FaceIndex);
+      anEdgePolygon.Polygon1  = aReader.ReadPolygon(aPolyHeader.NbNodes, aPolyHeader.HasParams != 0, aPolyHeader.Deflection, aNbTriNodes);
+      if (aPolyHeader.NbNodes2 != 0)
+        anEdgePolygon.Polygon2 = aReader.ReadPolygon(aPolyHeader.NbNodes2, aPolyHeader.HasParams != 0, aPolyHeader.Deflection, aNbTriNodes);
+      if (anEdgePolygon.Polygon1.IsNull()
+       || (aPolyHeader.NbNodes2 != 0 && anEdgePolygon.Polygon2.IsNull()))
+      {
+        ++myNbMisses;
+        return false;
+      }
+      anEdgePolygons[size_t(anEdgeIter)].push_back(anEdgePolygon);
+    }
+  }
+
+  BRep_Builder aBuilder;
+  for (int aFaceIter = 0; aFaceIter < aFaces.Extent(); ++aFaceIter)
+  {
+    if (!aTriangulations[aFaceIter].IsNull())
+      aBuilder.UpdateFace(TopoDS::Face(aFaces.FindKey(aFaceIter + 1)), aTriangulations[aFaceIter]);
+  }
+  for (int anEdgeIter = 0; anEdgeIter < anEdgeFaces.Extent(); ++anEdgeIter)
+  {
+    const TopoDS_Edge& anEdge = TopoDS::Edge(anEdgeFaces.FindKey(anEdgeIter + 1));
+    for (const OcctMeshCacheEdgePolygon& aPolyIter : anEdgePolygons[size_t(anEdgeIter)])
+    {
+      const TopoDS_Face& aFace = TopoDS::Face(aFaces.FindKey(aPolyIter.FaceIndex));
+      const Handle(Poly_Triangulation)& aTris = aTriangulations[size_t(aPolyIter.FaceIndex - 1)];
+      if (!aPolyIter.Polygon2.IsNull())
+        aBuilder.UpdateEdge(TopoDS::Edge(anEdge.Oriented(TopAbs_FORWARD)), aPolyIter.Polygon1, aPolyIter.Polygon2, aTris, aFace.Location());
+      else
+        aBuilder.UpdateEdge(anEdge, aPolyIter.Polygon1, aTris, aFace.Location());
+    }
+  }
+
+  myNbBytesRead += size_t(aReader.Size);
+  ++myNbHits;
+
+  // refresh modification time for the least recently used eviction
+  aFile.unmap((uchar* )aReader.Data);
+  aFile.close();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+  if (aFile.open(QIODevice::Append))
+    aFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+#endif
+  return true;
+}
+
+// ================================================================
+// Function : Store
+// ================================================================
+void OcctQtMeshCache::Store(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection)
+{
+  const uint64_t aKey = PartKey(thePart, theLinDeflection, theAngDeflection);
+  TopTools_IndexedMapOfShape aFaces;
+  TopExp::MapShapes(thePart, TopAbs_FACE, aFaces);
+  TopTools_IndexedDataMapOfShapeListOfShape anEdgeFaces;
+  TopExp::MapShapesAndAncestors(thePart, TopAbs_EDGE, TopAbs_FACE, anEdgeFaces);
+
+  QByteArray aData;
+  OcctMeshCacheHeader aHeader;
+  std::memcpy(aHeader.Magic, THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC));
+  aHeader.Key     = aKey;
+  aHeader.NbFaces = uint32_t(aFaces.Extent());
+  aHeader.NbEdges = uint32_t(anEdgeFaces.Extent());
+  aHeader.LinDeflection = theLinDeflection;
+  aHeader.AngDeflection = theAngDeflection;
+  aData.append((const char*)&aHeader, sizeof(aHeader));
+  for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter)
+  {
+    const OcctMeshCacheFaceSignature aFaceSign = faceSignature(TopoDS::Face(aFaces.FindKey(aFaceIter)));
+    aData.append((const char*)&aFaceSign, sizeof(aFaceSign));
+  }
+  for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter)
+  {
+    // triangulation is defined in face coordinates without location - store it as is
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(TopoDS::Face(aFaces.FindKey(aFaceIter)), aLoc);
+
+    OcctMeshCacheFace aFaceHeader;
+    aFaceHeader.NbNodes     = !aTris.IsNull() ? uint32_t(aTris->NbNodes()) : 0;
+    aFaceHeader.NbTriangles = !aTris.IsNull() ? uint32_t(aTris->NbTriangles()) : 0;
+    aFaceHeader.Flags       = 0;
+    aFaceHeader.Reserved    = 0;
+    aFaceHeader.Deflection  = !aTris.IsNull() ? aTris->Deflection() : 0.0;
+    if (!aTris.IsNull() && aTris->HasUVNodes())
+      aFaceHeader.Flags |= OcctMeshCacheFaceFlags_UVNodes;
+    if (!aTris.IsNull() && aTris->HasNormals())
+      aFaceHeader.Flags |= OcctMeshCacheFaceFlags_Normals;
+    aData.append((const char*)&aFaceHeader, sizeof(aFaceHeader));
+    if (aTris.IsNull())
+      continue;
+
+    const int aNbNodes = aTris->NbNodes();
+    std::vector<double> aNodes;
+    aNodes.reserve(size_t(aNbNodes) * 3);
+    for (int aNodeIter = 1; aNodeIter <= aNbNodes; ++aNodeIter)
+    {
+      const gp_Pnt aPnt = aTris->Node(aNodeIter);
+      aNodes.insert(aNodes.end(), { aPnt.X(), aPnt.Y(), aPnt.Z() });
+    }
+    appendArray(aData, aNodes);
+    if (aTris->HasUVNodes())
+    {
+      std::vector<double> aUVNodes;
+      aUVNodes.reserve(size_t(aNbNodes) * 2);
+      for (int aNodeIter = 1; aNodeIter <= aNbNodes; ++aNodeIter)
+      {
+        const gp_Pnt2d aUV = aTris->UVNode(aNodeIter);
+        aUVNodes.insert(aUVNodes.end(), { aUV.X(), aUV.Y() });
+      }
+      appendArray(aData, aUVNodes);
+    }
+    if (aTris->HasNormals())
+    {
+      std::vector<float> aNormals;
+      aNormals.reserve(size_t(aNbNodes) * 3);
+#if (OCC_VERSION_HEX >= 0x070600)
+      for (int aNodeIter = 1; aNodeIter <= aNbNodes; ++aNodeIter)
+      {
+        gp_Vec3f aNorm;
+        aTris->Normal(aNodeIter, aNorm);
+        aNormals.insert(aNormals.end(), { aNorm.x(), aNorm.y(), aNorm.z() });
+      }
+#else
+      const TShort_Array1OfShortReal& aNormArray = aTris->Normals();
+      aNormals.assign(aNormArray.begin(), aNormArray.end());
+#endif
+      appendArray(aData, aNormals);
+    }
+
+    std::vector<int32_t> aTriNodes;
+    aTriNodes.reserve(size_t(aTris->NbTriangles()) * 3);
+    for (int aTriIter = 1; aTriIter <= aTris->NbTriangles(); ++aTriIter)
+    {
+      int aTriNode[3] = { 0, 0, 0 };
+      aTris->Triangle(aTriIter).Get(aTriNode[0], aTriNode[1], aTriNode[2]);
+      aTriNodes.insert(aTriNodes.end(), { int32_t(aTriNode[0]), int32_t(aTriNode[1]), int32_t(aTriNode[2]) });
+    }
+    appendArray(aData, aTriNodes);
+  }
+
+  // edge polygons on triangulation are required to treat part as meshed and to display face boundaries
+  for (int anEdgeIter = 1; anEdgeIter <= anEdgeFaces.Extent(); ++anEdgeIter)
+  {
+    const TopoDS_Edge& anEdge = TopoDS::Edge(anEdgeFaces.FindKey(anEdgeIter));
+    std::vector<int> aFaceIndices;
+    for (TopTools_ListOfShape::Iterator aFaceIter(anEdgeFaces.FindFromIndex(anEdgeIter)); aFaceIter.More(); aFaceIter.Next())
+    {
+      const int aFaceIndex = aFaces.FindIndex(aFaceIter.Value());
+      if (aFaceIndex > 0
+       && std::find(aFaceIndices.begin(), aFaceIndices.end(), aFaceIndex) == aFaceIndices.end())
+      {
+        aFaceIndices.push_back(aFaceIndex);
+      }
+    }
+
+    QByteArray anEdgeData;
+    uint32_t aNbPolygons = 0;
+    for (int aFaceIndex : aFaceIndices)
+    {
+      const TopoDS_Face& aFace = TopoDS::Face(aFaces.FindKey(aFaceIndex));
+      TopLoc_Location aLoc;
+      const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(aFace, aLoc);
+      if (aTris.IsNull())
+        continue;
+
+      const bool isSeam = BRep_Tool::IsClosed(anEdge, aFace);
+      const Handle(Poly_PolygonOnTriangulation) aPoly1 =
+        BRep_Tool::PolygonOnTriangulation(isSeam ? TopoDS::Edge(anEdge.Oriented(TopAbs_FORWARD)) : anEdge, aTris, aLoc);
+      const Handle(Poly_PolygonOnTriangulation) aPoly2 =
+        isSeam ? BRep_Tool::PolygonOnTriangulation(TopoDS::Edge(anEdge.Oriented(TopAbs_REVERSED)), aTris, aLoc)
+               : Handle(Poly_PolygonOnTriangulation)();
+      if (aPoly1.IsNull()
+       || (isSeam && (aPoly2.IsNull() || aPoly2 == aPoly1)))
+      {
+        continue;
+      }
+
+      const bool hasParams = aPoly1->HasParameters()
+                         && (aPoly2.IsNull() || aPoly2->HasParameters());
+      OcctMeshCachePolygon aPolyHeader;
+      aPolyHeader.FaceIndex  = uint32_t(aFaceIndex);
+      aPolyHeader.NbNodes    = uint32_t(aPoly1->NbNodes());
+      aPolyHeader.NbNodes2   = !aPoly2.IsNull() ? uint32_t(aPoly2->NbNodes()) : 0;
+      aPolyHeader.HasParams  = hasParams ? 1 : 0;
+      aPolyHeader.Deflection = aPoly1->Deflection();
+      anEdgeData.append((const char*)&aPolyHeader, sizeof(aPolyHeader));
+      appendPolygon(anEdgeData, aPoly1, hasParams);
+      if (!aPoly2.IsNull())
+        appendPolygon(anEdgeData, aPoly2, hasParams);
+
+      ++aNbPolygons;
+    }
+    aData.append((const char*)&aNbPolygons, sizeof(aNbPolygons));
+    aData.append(anEdgeData);
+  }
+
+  // write into temporary file and rename, so that readers never see partially written file
+  QSaveFile aFile(filePath(aKey));
+  if (!aFile.open(QIODevice::WriteOnly)
+   || aFile.write(aData) != aData.size()
+   || !aFile.commit())
+    return;
+
+  myNbBytesWritten += size_t(aData.size());
+  trimFolder(uint64_t(aData.size()));
+}
+
+// ================================================================
+// Function : trimFolder
+// ================================================================
+void OcctQtMeshCache::trimFolder(uint64_t theNbBytesWritten)
+{
+  const uint64_t aMaxSize = myMaxSize.load();
+  if (aMaxSize == 0)
+    return;
+
+  std::lock_guard<std::mutex> aLock(myTrimMutex);
+  const QStringList aFilter("*.omc");
+  if (!myHasFolderSize)
+  {
+    myFolderSize = 0;
+    for (const QFileInfo& aFileIter : QDir(myFolder).entryInfoList(aFilter, QDir::Files))
+      myFolderSize += uint64_t(aFileIter.size());
+
+    myHasFolderSize = true;
+  }
+  else
+  {
+    myFolderSize += theNbBytesWritten;
+  }
+  if (myFolderSize <= aMaxSize)
+    return;
+
+  // folder might be shared with other processes - rescan it and remove the oldest files
+  // (modification time is refreshed on cache hit) leaving some room to avoid trimming on every store
+  const QFileInfoList aFiles = QDir(myFolder).entryInfoList(aFilter, QDir::Files, QDir::Time | QDir::Reversed);
+  myFolderSize = 0;
+  for (const QFileInfo& aFileIter : aFiles)
+    myFolderSize += uint64_t(aFileIter.size());
+
+  const uint64_t aTargetSize = aMaxSize / 10 * 9;
+  for (const QFileInfo& aFileIter : aFiles)
+  {
+    if (myFolderSize <= aTargetSize)
+      break;
+
+    if (QFile::remove(aFileIter.absoluteFilePath()))
+      myFolderSize -= std::min(myFolderSize, uint64_t(aFileIter.size()));
+  }
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtMeshCache_HeaderFile
+#define _OcctQtMeshCache_HeaderFile
+
+#include "OcctTessellator.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QString>
+#include <Standard_WarningsRestore.hxx>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+//! Persistent on-disk cache of part triangulations.
+//!
+//! Each part is stored in a separate compact binary file named by 64-bit hash of meshing parameters
+//! and cheap geometric signature of the part (topology, vertex positions, curve and surface types,
+//! parameter ranges and tolerances), which doesn't depend on existing triangulation.
+//! File holds meshing parameters, full geometric signature of every face (surface type and parameters,
+//! UV bounds and bounding box) verified on restoring to reject entries with colliding key,
+//! per-face triangulations (double nodes, optional UV nodes and normals, int32 triangles)
+//! and per-edge polygons on these triangulations in the order of TopExp::MapShapes().
+//! File is memory mapped and fully decoded and validated before triangulations are attached to the part.
+//!
+//! Files are written atomically, so that cache might be shared by concurrent processes.
+//! Total size of the cache is limited - the least recently used files are removed once it is exceeded.
+class OcctQtMeshCache : public OcctTessellatorCache
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctQtMeshCache, OcctTessellatorCache)
+public:
+  //! Return default cache folder within user cache location.
+  static QString DefaultFolder();
+
+public:
+  //! Main constructor.
+  //! @param[in] theFolder  cache folder, created if not exists
+  OcctQtMeshCache(const QString& theFolder = DefaultFolder());
+
+  //! Return cache folder.
+  const QString& Folder() const { return myFolder; }
+
+  //! Return maximum total size of cache files in bytes; 512 MiB by default.
+  uint64_t MaxSize() const { return myMaxSize.load(); }
+
+  //! Set maximum total size of cache files in bytes; 0 means unlimited.
+  void SetMaxSize(uint64_t theSize) { myMaxSize = theSize; }
+
+  //! Restore triangulation of the part.
+  virtual bool Restore(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection) override;
+
+  //! Store triangulation of the part.
+  virtual void Store(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection) override;
+
+  //! Return number of cache hits.
+  size_t NbHits() const { return myNbHits.load(); }
+
+  //! Return number of cache misses.
+  size_t NbMisses() const { return myNbMisses.load(); }
+
+  //! Reset hit/miss counters.
+  void ResetStats();
+
+  //! Format hit/miss statistics into string.
+  TCollection_AsciiString StatsString() const;
+
+  //! Compute cache key of the part from its geometric signature and meshing parameters (ignores existing triangulation).
+  static uint64_t PartKey(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection);
+
+private:
+  //! Return file path for the key.
+  QString filePath(uint64_t theKey) const;
+
+  //! Account written file and remove the least recently used files when size limit is exceeded.
+  void trimFolder(uint64_t theNbBytesWritten);
+
+private:
+  QString               myFolder;
+  std::atomic<size_t>   myNbHits;
+  std::atomic<size_t>   myNbMisses;
+  std::atomic<size_t>   myNbBytesRead;
+  std::atomic<size_t>   myNbBytesWritten;
+  std::atomic<uint64_t> myMaxSize;
+  std::mutex            myTrimMutex;
+  uint64_t              myFolderSize = 0;         //!< estimated total size of cache files (guarded by myTrimMutex)
+  bool                  myHasFolderSize = false;  //!< folder size has been computed
+};
+
+#endif // _OcctQtMeshCache_HeaderFile
@@ -0,0 +1,430 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctQtModelLoader.h"
+
+#include "OcctQtMeshCache.h"
+#include "OcctQtTools.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_Shape.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD_Timer.hxx>
+#include <STEPControl_Reader.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <V3d_View.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QFileInfo>
+#include <Standard_WarningsRestore.hxx>
+
+#include <deque>
+#include <thread>
+
+namespace
+{
+  //! Minimal progress change (in percents) to be passed to Qt.
+  static const double THE_PROGRESS_STEP = 0.5;
+
+  //! Maximum number of parts displayed at once before checking time budget.
+  static const size_t THE_DISPLAY_BATCH = 16;
+}
+
+// ================================================================
+// Function : Show
+// ================================================================
+void OcctQtProgressIndicator::Show(const Message_ProgressScope& theScope, const Standard_Boolean theIsForce)
+{
+  // called under indicator lock, no extra synchronization necessary
+  const double aPercent = GetPosition() * 100.0;
+  if (!theIsForce && myLastPercent >= 0.0 && aPercent - myLastPercent < THE_PROGRESS_STEP)
+    return;
+
+  myLastPercent = aPercent;
+  if (!myCallback)
+    return;
+
+  QString aStep;
+  for (const Message_ProgressScope* aScopeIter = &theScope; aScopeIter != nullptr; aScopeIter = aScopeIter->Parent())
+  {
+    if (aScopeIter->Name() != nullptr)
+    {
+      aStep = QString::fromUtf8(aScopeIter->Name());
+      break;
+    }
+  }
+  myCallback(aPercent, aStep);
+}
+
+//! State of a single loading request shared with its working thread.
+struct OcctQtModelLoader::LoadJob
+{
+  OcctTessellator          Tessellator;
+  QString                  FilePath;
+  Standard_Mutex           OwnerMutex;        //!< lock for Owner, held while emitting signals
+  OcctQtModelLoader*       Owner = nullptr;   //!< loader receiving signals; NULL once job is retired
+  mutable Standard_Mutex   PartsMutex;
+  std::deque<TopoDS_Shape> LoadedParts;
+  std::atomic<bool>        ToCancel    { false };
+  std::atomic<bool>        IsLoading   { true };
+  std::atomic<bool>        IsDone      { false };
+  std::atomic<size_t>      NbDisplayed { 0 };
+  std::atomic<bool>        IsFitDone   { false };
+  std::atomic<bool>        IsFinished  { false }; //!< working thread has returned from performLoading()
+};
+
+// ================================================================
+// Function : OcctQtModelLoader
+// ================================================================
+OcctQtModelLoader::OcctQtModelLoader(QObject* theParent)
+: QObject(theParent)
+{
+  // reuse triangulation of previously opened models
+  myTessellator.SetCache(new OcctQtMeshCache());
+}
+
+// ================================================================
+// Function : ~OcctQtModelLoader
+// ================================================================
+OcctQtModelLoader::~OcctQtModelLoader()
+{
+  // working thread might be stuck within non-interruptible STEP parsing - wait for it anyway,
+  // so that it doesn't outlive the application
+  retireJob();
+  joinWorkers(true);
+}
+
+// ================================================================
+// Function : currentJob
+// ================================================================
+std::shared_ptr<OcctQtModelLoader::LoadJob> OcctQtModelLoader::currentJob() const
+{
+  Standard_Mutex::Sentry aLock(myJobMutex);
+  return myJob;
+}
+
+// ================================================================
+// Function : retireJob
+// ================================================================
+void OcctQtModelLoader::retireJob()
+{
+  std::shared_ptr<LoadJob> aJob;
+  {
+    Standard_Mutex::Sentry aLock(myJobMutex);
+    aJob.swap(myJob);
+  }
+  if (!aJob)
+    return;
+
+  aJob->ToCancel = true;
+  Standard_Mutex::Sentry aLock(aJob->OwnerMutex);
+  aJob->Owner = nullptr;
+}
+
+// ================================================================
+// Function : joinWorkers
+// ================================================================
+void OcctQtModelLoader::joinWorkers(bool theToJoinAll)
+{
+  for (std::vector<Worker>::iterator aWorkerIter = myWorkers.begin(); aWorkerIter != myWorkers.end();)
+  {
+    if (!theToJoinAll
+     && !aWorkerIter->Job->IsFinished)
+    {
+      ++aWorkerIter;
+      continue;
+    }
+
+    aWorkerIter->Thread.join();
+    aWorkerIter = myWorkers.erase(aWorkerIter);
+  }
+}
+
+// ================================================================
+// Function : Cancel
+// ================================================================
+void OcctQtModelLoader::Cancel()
+{
+  if (std::shared_ptr<LoadJob> aJob = currentJob())
+    aJob->ToCancel = true;
+}
+
+// ================================================================
+// Function : IsLoading
+// ================================================================
+bool OcctQtModelLoader::IsLoading() const
+{
+  std::shared_ptr<LoadJob> aJob = currentJob();
+  return aJob && aJob->IsLoading.load();
+}
+
+// ================================================================
+// Function : NbDisplayed
+// ================================================================
+size_t OcctQtModelLoader::NbDisplayed() const
+{
+  std::shared_ptr<LoadJob> aJob = currentJob();
+  return aJob ? aJob->NbDisplayed.load() : 0;
+}
+
+// ================================================================
+// Function : Load
+// ================================================================
+bool OcctQtModelLoader::Load(const QString& theFilePath)
+{
+  // the previous job finishes on its own; parts it has queued are never displayed
+  retireJob();
+  joinWorkers(false);
+  if (!QFileInfo(theFilePath).isFile())
+  {
+    emit loadingFinished(false, QString("File '") + theFilePath + "' does not exist");
+    return false;
+  }
+
+  std::shared_ptr<LoadJob> aJob = std::make_shared<LoadJob>();
+  aJob->Tessellator = myTessellator;
+  aJob->FilePath    = theFilePath;
+  aJob->Owner       = this;
+  {
+    Standard_Mutex::Sentry aLock(myJobMutex);
+    myJob = aJob;
+  }
+  Worker aWorker;
+  aWorker.Job    = aJob;
+  aWorker.Thread = std::thread([aJob]()
+  {
+    performLoading(aJob);
+    aJob->IsFinished = true;
+  });
+  myWorkers.push_back(std::move(aWorker));
+  return true;
+}
+
+// ================================================================
+// Function : HasLoadedParts
+// ================================================================
+bool OcctQtModelLoader::HasLoadedParts() const
+{
+  std::shared_ptr<LoadJob> aJob = currentJob();
+  if (!aJob)
+    return false;
+
+  Standard_Mutex::Sentry aLock(aJob->PartsMutex);
+  return !aJob->LoadedParts.empty();
+}
+
+// ================================================================
+// Function : TakeLoadedParts
+// ================================================================
+size_t OcctQtModelLoader::TakeLoadedParts(std::vector<TopoDS_Shape>& theParts, size_t theMaxNb)
+{
+  std::shared_ptr<LoadJob> aJob = currentJob();
+  if (!aJob)
+    return 0;
+
+  Standard_Mutex::Sentry aLock(aJob->PartsMutex);
+  const size_t aNbParts = Min(theMaxNb, aJob->LoadedParts.size());
+  theParts.insert(theParts.end(), aJob->LoadedParts.begin(), aJob->LoadedParts.begin() + aNbParts);
+  aJob->LoadedParts.erase(aJob->LoadedParts.begin(), aJob->LoadedParts.begin() + aNbParts);
+  return aNbParts;
+}
+
+// ================================================================
+// Function : DisplayLoadedParts
+// ================================================================
+bool OcctQtModelLoader::DisplayLoadedParts(const Handle(AIS_InteractiveContext)& theCtx,
+                                           const Handle(V3d_View)& theView,
+                                           double theTimeBudget)
+{
+  // job might be replaced by GUI thread meanwhile - the whole call works with the same one
+  std::shared_ptr<LoadJob> aJob = currentJob();
+  if (!aJob)
+    return false;
+
+  const size_t aNbDisplayedOld = aJob->NbDisplayed;
+  OSD_Timer aTimer;
+  aTimer.Start();
+  std::vector<TopoDS_Shape> aParts;
+  for (;;)
+  {
+    {
+      Standard_Mutex::Sentry aLock(aJob->PartsMutex);
+      const size_t aNbParts = Min(THE_DISPLAY_BATCH, aJob->LoadedParts.size());
+      aParts.assign(aJob->LoadedParts.begin(), aJob->LoadedParts.begin() + aNbParts);
+      aJob->LoadedParts.erase(aJob->LoadedParts.begin(), aJob->LoadedParts.begin() + aNbParts);
+    }
+    if (aParts.empty())
+      break;
+
+    for (const TopoDS_Shape& aPartIter : aParts)
+    {
+      Handle(AIS_Shape) aPrs = new AIS_Shape(aPartIter);
+      // part has been already meshed by working thread
+      aPrs->Attributes()->SetAutoTriangulation(false);
+      theCtx->Display(aPrs, AIS_Shaded, 0, false);
+    }
+    aJob->NbDisplayed += aParts.size();
+    aParts.clear();
+    if (aTimer.ElapsedTime() >= theTimeBudget)
+      break;
+  }
+
+  bool hasMore = false;
+  {
+    Standard_Mutex::Sentry aLock(aJob->PartsMutex);
+    hasMore = !aJob->LoadedParts.empty();
+  }
+  const size_t aNbDisplayed = aJob->NbDisplayed;
+  if (!theView.IsNull()
+   && ((aNbDisplayedOld == 0 && aNbDisplayed != 0)
+    || (aJob->IsDone && !hasMore && !aJob->IsFitDone && aNbDisplayed != 0)))
+  {
+    theView->FitAll(0.01, false);
+    aJob->IsFitDone = aJob->IsDone && !hasMore;
+  }
+  return hasMore;
+}
+
+// ================================================================
+// Function : performLoading
+// ================================================================
+void OcctQtModelLoader::performLoading(const std::shared_ptr<LoadJob>& theJob)
+{
+  const QString& aFilePath = theJob->FilePath;
+  OSD_Timer aTimer;
+  aTimer.Start();
+  Handle(OcctQtProgressIndicator) aProgress = new OcctQtProgressIndicator(
+    [&theJob](double thePercent, const QString& theStep)
+    {
+      Standard_Mutex::Sentry aLock(theJob->OwnerMutex);
+      if (theJob->Owner != nullptr)
+        emit theJob->Owner->progressChanged(thePercent, theStep);
+    },
+    &theJob->ToCancel);
+
+  bool isRead = false;
+  std::vector<TopoDS_Shape> aParts;
+  try
+  {
+    Message_ProgressScope aPS(aProgress->Start(), "Loading", 100);
+    TopoDS_Shape aShape;
+    isRead = readShape(aFilePath, aShape, aPS.Next(40));
+    if (isRead && !aPS.UserBreak())
+    {
+      explodeParts(aShape, aParts);
+      theJob->Tessellator.Perform(aParts,
+                                  [&theJob, &aParts](size_t thePartIndex) { pushLoadedPart(*theJob, aParts[thePartIndex]); },
+                                  aPS.Next(60));
+    }
+  }
+  catch (const Standard_Failure& theEx)
+  {
+    Message::SendFail() << "Error: exception while loading '" << OcctQtTools::qtStringToOcct(aFilePath)
+                        << "': " << theEx;
+    isRead = false;
+  }
+
+  const bool isCancelled = theJob->ToCancel.load();
+  QString aMessage;
+  if (isCancelled)
+    aMessage = "Loading of '" + aFilePath + "' has been cancelled";
+  else if (!isRead)
+    aMessage = "Unable to read file '" + aFilePath + "'";
+  else
+    aMessage = QString("Loaded ") + QString::number(aParts.size()) + " parts from '" + aFilePath + "' in "
+             + QString::number(aTimer.ElapsedTime(), 'f', 2) + " s; meshed "
+             + OcctQtTools::qtStringFromOcct(theJob->Tessellator.LastStats().ToString());
+
+  Handle(OcctQtMeshCache) aCache = Handle(OcctQtMeshCache)::DownCast(theJob->Tessellator.Cache());
+  if (!aCache.IsNull())
+    Message::SendInfo() << "Mesh cache: " << aCache->StatsString();
+
+  if (isRead && !isCancelled)
+    Message::SendInfo() << OcctQtTools::qtStringToOcct(aMessage);
+  else
+    Message::SendWarning() << OcctQtTools::qtStringToOcct(aMessage);
+
+  theJob->IsDone    = isRead && !isCancelled;
+  theJob->IsLoading = false;
+
+  Standard_Mutex::Sentry aLock(theJob->OwnerMutex);
+  if (theJob->Owner != nullptr)
+  {
+    emit theJob->Owner->loadingFinished(theJob->IsDone.load(), aMessage);
+    // wake up viewer to fit the model
+    emit theJob->Owner->partsLoaded();
+  }
+}
+
+// ================================================================
+// Function : readShape
+// ================================================================
+bool OcctQtModelLoader::readShape(const QString& theFilePath,
+                                  TopoDS_Shape& theShape,
+                                  const Message_ProgressRange& theRange)
+{
+  const TCollection_AsciiString aPath = OcctQtTools::qtStringToOcct(theFilePath);
+  const QString aSuffix = QFileInfo(theFilePath).suffix().toLower();
+  Message_ProgressScope aPS(theRange, "Reading", 1);
+  if (aSuffix == "brep" || aSuffix == "rle")
+  {
+    BRep_Builder aBuilder;
+    return BRepTools::Read(theShape, aPath.ToCString(), aBuilder, aPS.Next())
+        && !theShape.IsNull();
+  }
+  else if (aSuffix == "step" || aSuffix == "stp")
+  {
+    // STEP parsing is not interruptible, only transfer reports progress
+    STEPControl_Reader aReader;
+    if (aReader.ReadFile(aPath.ToCString()) != IFSelect_RetDone
+     || aPS.UserBreak())
+      return false;
+
+    aReader.TransferRoots(aPS.Next());
+    theShape = aReader.OneShape();
+    return !theShape.IsNull();
+  }
+
+  Message::SendFail() << "Error: unsupported file format '" << aPath << "'";
+  return false;
+}
+
+// ================================================================
+// Function : explodeParts
+// ================================================================
+void OcctQtModelLoader::explodeParts(const TopoDS_Shape& theShape, std::vector<TopoDS_Shape>& theParts)
+{
+  if (theShape.IsNull())
+    return;
+
+  if (theShape.ShapeType() != TopAbs_COMPOUND)
+  {
+    theParts.push_back(theShape);
+    return;
+  }
+
+  for (TopoDS_Iterator aSubIter(theShape); aSubIter.More(); aSubIter.Next())
+    explodeParts(aSubIter.Value(), theParts);
+}
+
+// ================================================================
+// Function : pushLoadedPart
+// ================================================================
+void OcctQtModelLoader::pushLoadedPart(LoadJob& theJob, const TopoDS_Shape& thePart)
+{
+  bool wasEmpty = false;
+  {
+    Standard_Mutex::Sentry aLock(theJob.PartsMutex);
+    wasEmpty = theJob.LoadedParts.empty();
+    theJob.LoadedParts.push_back(thePart);
+  }
+  // notify only on empty -> non-empty transition to avoid flooding Qt event queue
+  if (wasEmpty)
+  {
+    Standard_Mutex::Sentry aLock(theJob.OwnerMutex);
+    if (theJob.Owner != nullptr)
+      emit theJob.Owner->partsLoaded();
+  }
+}
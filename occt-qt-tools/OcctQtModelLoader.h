@@ -0,0 +1,169 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtModelLoader_HeaderFile
+#define _OcctQtModelLoader_HeaderFile
+
+#include "OcctTessellator.h"
+
+#include <Message_ProgressIndicator.hxx>
+#include <Standard_Mutex.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QObject>
+#include <QString>
+#include <Standard_WarningsRestore.hxx>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class AIS_InteractiveContext;
+class V3d_View;
+
+//! Progress indicator passing progress of OCCT algorithms to Qt through callback
+//! and checking cancellation flag.
+class OcctQtProgressIndicator : public Message_ProgressIndicator
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctQtProgressIndicator, Message_ProgressIndicator)
+public:
+  //! Callback receiving progress in percents and the name of current step; called from working threads.
+  typedef std::function<void(double thePercent, const QString& theStep)> Callback;
+
+public:
+  //! Main constructor.
+  OcctQtProgressIndicator(const Callback& theCallback, const std::atomic<bool>* theToCancel)
+  : myCallback(theCallback),
+    myToCancel(theToCancel)
+  {
+  }
+
+  //! Return TRUE if cancellation has been requested.
+  virtual Standard_Boolean UserBreak() override { return myToCancel != nullptr && myToCancel->load(); }
+
+  //! Pass progress to callback (throttled to avoid flooding Qt event queue).
+  virtual void Show(const Message_ProgressScope& theScope, const Standard_Boolean theIsForce) override;
+
+  //! Reset progress.
+  virtual void Reset() override
+  {
+    Message_ProgressIndicator::Reset();
+    myLastPercent = -1.0;
+  }
+
+private:
+  Callback                 myCallback;
+  const std::atomic<bool>* myToCancel    = nullptr;
+  double                   myLastPercent = -1.0;
+};
+
+//! Asynchronous loader of STEP/BREP models.
+//!
+//! File is read within working thread, then parts (non-compound sub-shapes) are meshed in parallel
+//! and put into the queue as soon as each part is ready.
+//! The viewer takes ready parts for display by DisplayLoadedParts() at every frame within limited time budget,
+//! so that 3D viewer remains interactive while model is being loaded.
+//!
+//! Signals are emitted from working threads - use queued connections (default for receivers in GUI thread).
+//!
+//! STEP parsing cannot be interrupted, so that Load() doesn't wait for the cancelled working thread:
+//! each Load() creates a new job owning its own state (queue, counters, tessellator), while the previous job
+//! is detached from the loader and finishes on its own without emitting signals anymore.
+//! Working threads of finished jobs are joined by the next Load(), and the destructor cancels and joins all of them
+//! (waiting for non-interruptible STEP parsing to complete, if any).
+class OcctQtModelLoader : public QObject
+{
+  Q_OBJECT
+public:
+  //! Main constructor.
+  OcctQtModelLoader(QObject* theParent = nullptr);
+
+  //! Destructor, cancelling loading and joining working threads.
+  virtual ~OcctQtModelLoader();
+
+  //! Return TRUE if loading is in progress.
+  bool IsLoading() const;
+
+  //! Start loading of STEP (.step, .stp) or BREP (.brep) file; the previous loading is cancelled.
+  bool Load(const QString& theFilePath);
+
+  //! Request cancellation of loading without waiting;
+  //! working thread stops at the next progress check.
+  void Cancel();
+
+  //! Return tessellation service meshing loaded parts; modifications are applied to the next Load().
+  OcctTessellator& Tessellator() { return myTessellator; }
+
+  //! Return TRUE if there are loaded parts not yet displayed (thread-safe).
+  bool HasLoadedParts() const;
+
+  //! Return number of parts displayed by DisplayLoadedParts().
+  size_t NbDisplayed() const;
+
+  //! Take loaded parts (thread-safe).
+  //! @param[out] theParts   loaded parts appended
+  //! @param[in]  theMaxNb   maximum number of parts to take
+  //! @return number of taken parts
+  size_t TakeLoadedParts(std::vector<TopoDS_Shape>& theParts, size_t theMaxNb);
+
+  //! Display loaded parts within specified time budget in seconds;
+  //! view is fitted to the model on the first displayed batch and once loading is done.
+  //! Should be called from thread rendering OCCT viewer.
+  //! @return TRUE if some parts remain for display (next frame should be requested)
+  bool DisplayLoadedParts(const Handle(AIS_InteractiveContext)& theCtx,
+                          const Handle(V3d_View)& theView,
+                          double theTimeBudget);
+
+signals:
+  //! Emitted when loaded parts queue becomes non-empty.
+  void partsLoaded();
+
+  //! Emitted on loading progress.
+  void progressChanged(double thePercent, const QString& theStep);
+
+  //! Emitted when loading is finished, failed or cancelled.
+  void loadingFinished(bool theIsDone, const QString& theMessage);
+
+private:
+  //! State of a single Load() request shared with its working thread.
+  struct LoadJob;
+
+  //! Return current job (thread-safe).
+  std::shared_ptr<LoadJob> currentJob() const;
+
+  //! Detach current job from the loader and cancel it.
+  void retireJob();
+
+  //! Join working threads of finished jobs (or all of them).
+  void joinWorkers(bool theToJoinAll);
+
+  //! Loading procedure executed within working thread; should not access the loader except through job owner.
+  static void performLoading(const std::shared_ptr<LoadJob>& theJob);
+
+  //! Read the file into shape.
+  static bool readShape(const QString& theFilePath, TopoDS_Shape& theShape, const Message_ProgressRange& theRange);
+
+  //! Put meshed part into queue.
+  static void pushLoadedPart(LoadJob& theJob, const TopoDS_Shape& thePart);
+
+  //! Split shape into parts (non-compound sub-shapes).
+  static void explodeParts(const TopoDS_Shape& theShape, std::vector<TopoDS_Shape>& theParts);
+
+private:
+  //! Working thread with its job.
+  struct Worker
+  {
+    std::shared_ptr<LoadJob> Job;
+    std::thread              Thread;
+  };
+
+private:
+  OcctTessellator          myTessellator; //!< tessellator setup copied into each job
+  mutable Standard_Mutex   myJobMutex;    //!< lock for myJob (GUI and rendering threads)
+  std::shared_ptr<LoadJob> myJob;
+  std::vector<Worker>      myWorkers;     //!< working threads of current and retired jobs (GUI thread)
+};
+
+#endif // _OcctQtModelLoader_HeaderFile
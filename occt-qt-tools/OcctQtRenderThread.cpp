@@ -0,0 +1,180 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctQtRenderThread.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <Standard_WarningsRestore.hxx>
+
+#include <Message.hxx>
+
+#include <chrono>
+
+// ================================================================
+// Function : ~OcctQtRenderThread
+// ================================================================
+OcctQtRenderThread::~OcctQtRenderThread()
+{
+  Stop();
+  delete myGlContext; // thread has never been started
+  myGlContext = nullptr;
+  delete mySurface;
+  mySurface = nullptr;
+}
+
+// ================================================================
+// Function : FenceShownFrame
+// ================================================================
+void OcctQtRenderThread::FenceShownFrame()
+{
+  QOpenGLContext* aGlCtx = QOpenGLContext::currentContext();
+  if (aGlCtx == nullptr)
+    return;
+
+  const QSurfaceFormat aFormat = aGlCtx->format();
+  const bool hasSync = aGlCtx->isOpenGLES()
+                     ? aFormat.majorVersion() >= 3
+                     : aFormat.version() >= qMakePair(3, 2);
+  if (!hasSync)
+  {
+    // fences are unavailable (OpenGL ES 2.0) - wait for completion on consumer side
+    aGlCtx->functions()->glFinish();
+    return;
+  }
+
+  QOpenGLExtraFunctions* aGlFuncs = aGlCtx->extraFunctions();
+  GLsync aFence = aGlFuncs->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  aGlFuncs->glFlush(); // fence should reach GPU to be ever signaled
+  myTextureRing.SetDisplayedFence(aFence);
+}
+
+// ================================================================
+// Function : CreateContext
+// ================================================================
+bool OcctQtRenderThread::CreateContext(QOpenGLContext* theShareContext)
+{
+  if (myGlContext != nullptr)
+    return true;
+  else if (theShareContext == nullptr)
+    return false;
+
+  myGlContext = new QOpenGLContext();
+  myGlContext->setFormat(theShareContext->format());
+  myGlContext->setShareContext(theShareContext);
+  if (!myGlContext->create())
+  {
+    Message::SendFail() << "Error: unable to create OpenGL context for rendering thread";
+    delete myGlContext;
+    myGlContext = nullptr;
+    return false;
+  }
+
+  myGlContext->moveToThread(this);
+  return true;
+}
+
+// ================================================================
+// Function : Start
+// ================================================================
+bool OcctQtRenderThread::Start(Renderer* theRenderer)
+{
+  if (isRunning())
+    return true;
+
+  if (myGlContext != nullptr)
+  {
+    // QOffscreenSurface should be created within GUI thread
+    mySurface = new QOffscreenSurface();
+    mySurface->setFormat(myGlContext->format());
+    mySurface->create();
+  }
+
+  {
+    // thread might be restarted after Stop()
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myToStop = false;
+  }
+  myRenderer = theRenderer;
+  start();
+  return true;
+}
+
+// ================================================================
+// Function : RequestFrame
+// ================================================================
+void OcctQtRenderThread::RequestFrame(const FrameRequest& theRequest)
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myRequest  = theRequest;
+    myToRedraw = true;
+  }
+  myCondition.notify_one();
+}
+
+// ================================================================
+// Function : Stop
+// ================================================================
+void OcctQtRenderThread::Stop()
+{
+  if (!isRunning())
+    return;
+
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myToStop = true;
+  }
+  myCondition.notify_all();
+  wait();
+}
+
+// ================================================================
+// Function : run
+// ================================================================
+void OcctQtRenderThread::run()
+{
+  if (myGlContext != nullptr
+   && !myGlContext->makeCurrent(mySurface))
+  {
+    Message::SendFail() << "Error: unable to make OpenGL context current within rendering thread";
+    myRenderer->ReleaseGl();
+    return;
+  }
+
+  bool hasPending = false;
+  for (;;)
+  {
+    FrameRequest aRequest;
+    bool toRedraw = false;
+    {
+      std::unique_lock<std::mutex> aLock(myMutex);
+      const auto aWakeUp = [this]() { return myToStop || myToRedraw; };
+      if (hasPending)
+        myCondition.wait_for(aLock, std::chrono::milliseconds(1), aWakeUp); // keep polling fence of the last frame
+      else
+        myCondition.wait(aLock, aWakeUp);
+
+      if (myToStop)
+        break;
+
+      toRedraw   = myToRedraw;
+      aRequest   = myRequest;
+      myToRedraw = false;
+    }
+
+    if (toRedraw)
+      myRenderer->RenderFrame(aRequest);
+
+    hasPending = myRenderer->PollFrames();
+  }
+
+  myRenderer->ReleaseGl();
+  if (myGlContext != nullptr)
+  {
+    myGlContext->doneCurrent();
+    delete myGlContext;
+    myGlContext = nullptr;
+  }
+}
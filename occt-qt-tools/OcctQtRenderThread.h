@@ -0,0 +1,111 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQtRenderThread_HeaderFile
+#define _OcctQtRenderThread_HeaderFile
+
+#include "OcctGlTextureRing.h"
+
+#include <Aspect_Drawable.hxx>
+#include <Graphic3d_Vec2.hxx>
+
+#include <Standard_WarningsDisable.hxx>
+#include <QThread>
+#include <Standard_WarningsRestore.hxx>
+
+#include <condition_variable>
+#include <mutex>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+
+//! Dedicated OCCT rendering thread owning OpenGL context, which shares resources with Qt context
+//! (QOpenGLWidget or Qt Quick scene graph), and a ring of textures passing rendered frames to Qt (OcctGlTextureRing).
+//! When started without CreateContext(), the renderer manages OpenGL context on its own
+//! (like OCCT rendering into native window and swapping its buffers), and the texture ring is unused.
+//!
+//! GUI thread wakes up the thread by RequestFrame(); requests are merged, so that the thread
+//! renders only the latest one. While the last frame waits for its fence, the thread polls it without blocking.
+//! Renderer callbacks are called from the thread with OpenGL context being current (if created).
+//!
+//! QThread (instead of std::thread) is required to move QOpenGLContext into it.
+class OcctQtRenderThread : public QThread
+{
+public:
+  //! Frame request.
+  struct FrameRequest
+  {
+    Graphic3d_Vec2i Size;                   //!< frame size in pixels
+    double          DevicePixelRatio = 1.0; //!< device pixel ratio
+    double          PresentTime      = 0.0; //!< expected presentation time
+    Aspect_Drawable NativeWindow     = 0;   //!< native window to render into (renderer managing OpenGL context)
+  };
+
+  //! Interface of renderer called from rendering thread.
+  class Renderer
+  {
+  public:
+    virtual ~Renderer() {}
+
+    //! Render frame into the next texture of the ring.
+    virtual void RenderFrame(const FrameRequest& theRequest) = 0;
+
+    //! Publish frames of the ring which have been completed by GPU.
+    //! @return TRUE if there are still frames waiting for GPU
+    virtual bool PollFrames() = 0;
+
+    //! Release GL resources before OpenGL context destruction.
+    virtual void ReleaseGl() = 0;
+  };
+
+public:
+  //! Empty constructor.
+  OcctQtRenderThread() {}
+
+  //! Destructor, stopping the thread.
+  virtual ~OcctQtRenderThread();
+
+  //! Return OpenGL context of the thread.
+  QOpenGLContext* Context() const { return myGlContext; }
+
+  //! Return texture ring.
+  OcctGlTextureRing& TextureRing() { return myTextureRing; }
+
+  //! Return texture ring.
+  const OcctGlTextureRing& TextureRing() const { return myTextureRing; }
+
+  //! Put a fence into the current (consumer) OpenGL context after the last use of the texture acquired from the ring,
+  //! so that OCCT thread does not render into it before consumer commands are completed by GPU.
+  //! Should be called by consumer after every frame showing the texture, with its OpenGL context being current.
+  void FenceShownFrame();
+
+  //! Create OpenGL context sharing resources with specified context, and move it to this thread.
+  //! Might be called from the thread owning theShareContext.
+  bool CreateContext(QOpenGLContext* theShareContext);
+
+  //! Create offscreen surface for OpenGL context (if any) and start the thread (GUI thread).
+  bool Start(Renderer* theRenderer);
+
+  //! Request a new frame; replaces previous request not yet taken by the thread.
+  void RequestFrame(const FrameRequest& theRequest);
+
+  //! Stop the thread and wait for its termination; Renderer::ReleaseGl() is called from the thread.
+  void Stop();
+
+protected:
+  //! Rendering loop.
+  virtual void run() override;
+
+private:
+  QOpenGLContext*         myGlContext = nullptr; //!< OCCT context shared with Qt one
+  QOffscreenSurface*      mySurface   = nullptr; //!< surface for OCCT context (created by GUI thread)
+  Renderer*               myRenderer  = nullptr;
+  OcctGlTextureRing       myTextureRing;
+
+  std::mutex              myMutex;            //!< lock for requests
+  std::condition_variable myCondition;
+  FrameRequest            myRequest;          //!< the latest frame request
+  bool                    myToRedraw = false; //!< new frame has been requested
+  bool                    myToStop   = false; //!< thread should be stopped
+};
+
+#endif // _OcctQtRenderThread_HeaderFile
@@ -2,6 +2,9 @@
 
 #include "OcctQtTools.h"
 
+#include "OcctInputLatency.h"
+#include "OcctInputPredictor.h"
+
 #include <Aspect_ScrollDelta.hxx>
 #include <Message.hxx>
 #include <OpenGl_Caps.hxx>
@@ -81,6 +84,21 @@ QString OcctQtTools::qtStringFromOcctExt(const TCollection_ExtendedString& theTe
   return QString::fromUtf16(theText.ToExtString());
 }
 
+// ================================================================
+// Function : qtInputLatencyMap
+// ================================================================
+QVariantMap OcctQtTools::qtInputLatencyMap(const OcctInputLatency& theLatency)
+{
+  const OcctInputLatency::Stats aStats = theLatency.Statistics();
+  QVariantMap aMap;
+  aMap["samples"] = QVariant::fromValue<qulonglong>(aStats.NbSamples);
+  aMap["p50"]     = aStats.P50 * 1000.0;
+  aMap["p95"]     = aStats.P95 * 1000.0;
+  aMap["p99"]     = aStats.P99 * 1000.0;
+  aMap["max"]     = aStats.Max * 1000.0;
+  return aMap;
+}
+
 // ================================================================
 // Function : qtMsgTypeToGravity
 // ================================================================
@@ -242,7 +260,8 @@ void OcctQtTools::qtGlCapsFromSurfaceFormat(OpenGl_Caps& theCaps, const QSurface
 // ================================================================
 bool OcctQtTools::qtHandleHoverEvent(Aspect_WindowInputListener& theListener,
                                      const Handle(V3d_View)& theView,
-                                     const QHoverEvent* theEvent)
+                                     const QHoverEvent* theEvent,
+                                     OcctInputLatency* theLatency)
 {
   if (theView->Window().IsNull())
     return false;
@@ -255,6 +274,9 @@ bool OcctQtTools::qtHandleHoverEvent(Aspect_WindowInputListener& theListener,
   const Graphic3d_Vec2i  aPnt2i(theView->Window()->ConvertPointToBacking(aPnt2d) + Graphic3d_Vec2d(0.5));
   const Aspect_VKeyMouse aButtons = Aspect_VKeyMouse_NONE;
   const Aspect_VKeyFlags aFlags = OcctQtTools::qtMouseModifiers2VKeys(theEvent->modifiers());
+  if (theLatency != nullptr)
+    theLatency->AddInput(theEvent->timestamp());
+
   return theListener.UpdateMousePosition(aPnt2i, aButtons, aFlags, false);
 }
 
@@ -263,7 +285,9 @@ bool OcctQtTools::qtHandleHoverEvent(Aspect_WindowInputListener& theListener,
 // ================================================================
 bool OcctQtTools::qtHandleMouseEvent(Aspect_WindowInputListener& theListener,
                                      const Handle(V3d_View)& theView,
-                                     const QMouseEvent* theEvent)
+                                     const QMouseEvent* theEvent,
+                                     OcctInputLatency* theLatency,
+                                     OcctInputPredictor* thePredictor)
 {
   if (theView->Window().IsNull())
     return false;
@@ -273,9 +297,15 @@ bool OcctQtTools::qtHandleMouseEvent(Aspect_WindowInputListener& theListener,
 #else
   const Graphic3d_Vec2d aPnt2d(theEvent->pos().x(), theEvent->pos().y());
 #endif
-  const Graphic3d_Vec2i  aPnt2i(theView->Window()->ConvertPointToBacking(aPnt2d) + Graphic3d_Vec2d(0.5));
+  const Graphic3d_Vec2d  aPntBack(theView->Window()->ConvertPointToBacking(aPnt2d));
+  const Graphic3d_Vec2i  aPnt2i(aPntBack + Graphic3d_Vec2d(0.5));
   const Aspect_VKeyMouse aButtons = OcctQtTools::qtMouseButtons2VKeys(theEvent->buttons());
   const Aspect_VKeyFlags aFlags = OcctQtTools::qtMouseModifiers2VKeys(theEvent->modifiers());
+  if (theLatency != nullptr)
+    theLatency->AddInput(theEvent->timestamp());
+  if (thePredictor != nullptr)
+    thePredictor->AddMouseSample(aPntBack, aButtons, aFlags, theEvent->timestamp());
+
   if (theEvent->type() == QEvent::MouseMove)
     return theListener.UpdateMousePosition(aPnt2i, aButtons, aFlags, false);
 
@@ -287,7 +317,8 @@ bool OcctQtTools::qtHandleMouseEvent(Aspect_WindowInputListener& theListener,
 // ================================================================
 bool OcctQtTools::qtHandleWheelEvent(Aspect_WindowInputListener& theListener,
                                      const Handle(V3d_View)& theView,
-                                     const QWheelEvent* theEvent)
+                                     const QWheelEvent* theEvent,
+                                     OcctInputLatency* theLatency)
 {
   if (theView->Window().IsNull())
     return false;
@@ -298,6 +329,9 @@ bool OcctQtTools::qtHandleWheelEvent(Aspect_WindowInputListener& theListener,
   const Graphic3d_Vec2d aPnt2d(theEvent->pos().x(), theEvent->pos().y());
 #endif
   const Graphic3d_Vec2i aPnt2i(theView->Window()->ConvertPointToBacking(aPnt2d) + Graphic3d_Vec2d(0.5));
+  if (theLatency != nullptr)
+    theLatency->AddInput(theEvent->timestamp());
+
   return theListener.UpdateMouseScroll(Aspect_ScrollDelta(aPnt2i, double(theEvent->angleDelta().y()) / 120.0));
 }
 
@@ -306,63 +340,92 @@ bool OcctQtTools::qtHandleWheelEvent(Aspect_WindowInputListener& theListener,
 // ================================================================
 bool OcctQtTools::qtHandleTouchEvent(Aspect_WindowInputListener& theListener,
                                      const Handle(V3d_View)& theView,
-                                     const QTouchEvent* theEvent)
+                                     const QTouchEvent* theEvent,
+                                     OcctInputLatency* theLatency,
+                                     OcctInputPredictor* thePredictor)
 {
   if (theView->Window().IsNull())
     return false;
 
+  return qtHandleTouchEvent(theListener, theView->Window()->DevicePixelRatio(), theEvent, theLatency, thePredictor);
+}
+
+// ================================================================
+// Function : qtHandleTouchEvent
+// ================================================================
+bool OcctQtTools::qtHandleTouchEvent(Aspect_WindowInputListener& theListener,
+                                     double theDevicePixelRatio,
+                                     const QTouchEvent* theEvent,
+                                     OcctInputLatency* theLatency,
+                                     OcctInputPredictor* thePredictor)
+{
   bool hasUpdates = false;
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
   for (const QTouchEvent::TouchPoint& aQTouch : theEvent->points())
   {
     const Standard_Size   aTouchId = aQTouch.id();
-    const Graphic3d_Vec2d aNewPos2d =
-      theView->Window()->ConvertPointToBacking(Graphic3d_Vec2d(aQTouch.position().x(), aQTouch.position().y()));
+    const Graphic3d_Vec2d aNewPos2d = Graphic3d_Vec2d(aQTouch.position().x(), aQTouch.position().y()) * theDevicePixelRatio;
     const Graphic3d_Vec2i aNewPos2i = Graphic3d_Vec2i(aNewPos2d + Graphic3d_Vec2d(0.5));
     if (aQTouch.state() == QEventPoint::Pressed
      && aNewPos2i.minComp() >= 0)
     {
       hasUpdates = true;
       theListener.AddTouchPoint(aTouchId, aNewPos2d);
+      if (thePredictor != nullptr)
+        thePredictor->AddTouchSample(aTouchId, aNewPos2d, theEvent->timestamp());
     }
     else if (aQTouch.state() == QEventPoint::Updated
           && theListener.TouchPoints().Contains(aTouchId))
     {
       hasUpdates = true;
       theListener.UpdateTouchPoint(aTouchId, aNewPos2d);
+      if (thePredictor != nullptr)
+        thePredictor->AddTouchSample(aTouchId, aNewPos2d, theEvent->timestamp());
     }
     else if (aQTouch.state() == QEventPoint::Released
           && theListener.RemoveTouchPoint(aTouchId))
     {
       hasUpdates = true;
+      if (thePredictor != nullptr)
+        thePredictor->RemoveTouch(aTouchId);
     }
   }
 #else
   for (const QTouchEvent::TouchPoint& aQTouch : theEvent->touchPoints())
   {
     const Standard_Size   aTouchId = aQTouch.id();
-    const Graphic3d_Vec2d aNewPos2d =
-      theView->Window()->ConvertPointToBacking(Graphic3d_Vec2d(aQTouch.pos().x(), aQTouch.pos().y()));
+    const Graphic3d_Vec2d aNewPos2d = Graphic3d_Vec2d(aQTouch.pos().x(), aQTouch.pos().y()) * theDevicePixelRatio;
     const Graphic3d_Vec2i aNewPos2i = Graphic3d_Vec2i(aNewPos2d + Graphic3d_Vec2d(0.5));
     if (aQTouch.state() == Qt::TouchPointPressed
      && aNewPos2i.minComp() >= 0)
     {
       hasUpdates = true;
       theListener.AddTouchPoint(aTouchId, aNewPos2d);
+      if (thePredictor != nullptr)
+        thePredictor->AddTouchSample(aTouchId, aNewPos2d, theEvent->timestamp());
     }
     else if (aQTouch.state() == Qt::TouchPointMoved
           && theListener.TouchPoints().Contains(aTouchId))
     {
       hasUpdates = true;
       theListener.UpdateTouchPoint(aTouchId, aNewPos2d);
+      if (thePredictor != nullptr)
+        thePredictor->AddTouchSample(aTouchId, aNewPos2d, theEvent->timestamp());
     }
     else if (aQTouch.state() == Qt::TouchPointReleased
           && theListener.RemoveTouchPoint(aTouchId))
     {
       hasUpdates = true;
+      if (thePredictor != nullptr)
+        thePredictor->RemoveTouch(aTouchId);
     }
   }
 #endif
+  if (hasUpdates
+   && theLatency != nullptr)
+  {
+    theLatency->AddInput(theEvent->timestamp());
+  }
   return hasUpdates;
 }
 
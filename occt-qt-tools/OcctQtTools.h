@@ -11,8 +11,11 @@
 #include <QColor>
 #include <QMouseEvent>
 #include <QSurfaceFormat>
+#include <QVariantMap>
 #include <Standard_WarningsRestore.hxx>
 
+class OcctInputLatency;
+class OcctInputPredictor;
 class OpenGl_Caps;
 class V3d_View;
 
@@ -59,6 +62,10 @@ public: //! @name common conversion tools
   //! Map TCollection_ExtendedString (UTF-16) into QString.
   static QString qtStringFromOcctExt(const TCollection_ExtendedString& theText);
 
+  //! Map input-to-photon latency statistics into QML map of "p50", "p95", "p99", "max" milliseconds
+  //! and number of "samples".
+  static QVariantMap qtInputLatencyMap(const OcctInputLatency& theLatency);
+
 public: //! @name methods for message logs
 
   //! Map QtMsgType into Message_Gravity.
@@ -70,26 +77,42 @@ public: //! @name methods for message logs
                                      const QString& theMsg);
 
 public: //! @name methods for wrapping Qt input events into Aspect_WindowInputListener events
+  //! Optional OcctInputLatency is stamped by timestamp of accepted event,
+  //! while optional OcctInputPredictor receives samples of dragged pointers.
 
   //! Queue Qt mouse hover event to OCCT listener.
   static bool qtHandleHoverEvent(Aspect_WindowInputListener& theListener,
                                  const Handle(V3d_View)& theView,
-                                 const QHoverEvent* theEvent);
+                                 const QHoverEvent* theEvent,
+                                 OcctInputLatency* theLatency = nullptr);
 
   //! Queue Qt mouse event to OCCT listener.
   static bool qtHandleMouseEvent(Aspect_WindowInputListener& theListener,
                                  const Handle(V3d_View)& theView,
-                                 const QMouseEvent* theEvent);
+                                 const QMouseEvent* theEvent,
+                                 OcctInputLatency* theLatency = nullptr,
+                                 OcctInputPredictor* thePredictor = nullptr);
 
   //! Queue Qt mouse wheel event to OCCT listener.
   static bool qtHandleWheelEvent(Aspect_WindowInputListener& theListener,
                                  const Handle(V3d_View)& theView,
-                                 const QWheelEvent* theEvent);
+                                 const QWheelEvent* theEvent,
+                                 OcctInputLatency* theLatency = nullptr);
 
   //! Queue Qt touch event to OCCT listener.
   static bool qtHandleTouchEvent(Aspect_WindowInputListener& theListener,
                                  const Handle(V3d_View)& theView,
-                                 const QTouchEvent* theEvent);
+                                 const QTouchEvent* theEvent,
+                                 OcctInputLatency* theLatency = nullptr,
+                                 OcctInputPredictor* thePredictor = nullptr);
+
+  //! Queue Qt touch event to OCCT listener with points converted by specified device pixel ratio;
+  //! this variant doesn't access V3d_View, which might be owned by another (rendering) thread.
+  static bool qtHandleTouchEvent(Aspect_WindowInputListener& theListener,
+                                 double theDevicePixelRatio,
+                                 const QTouchEvent* theEvent,
+                                 OcctInputLatency* theLatency = nullptr,
+                                 OcctInputPredictor* thePredictor = nullptr);
 
   //! Map Qt buttons bitmask to virtual keys.
   static Aspect_VKeyMouse qtMouseButtons2VKeys(Qt::MouseButtons theButtons);
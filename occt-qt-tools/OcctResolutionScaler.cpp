@@ -0,0 +1,245 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctResolutionScaler.h"
+
+#include <OpenGl_Context.hxx>
+#include <OpenGl_View.hxx>
+#include <OpenGl_Window.hxx>
+#include <V3d_View.hxx>
+
+#ifndef GL_TIME_ELAPSED
+  #define GL_TIME_ELAPSED 0x88BF
+#endif
+
+namespace
+{
+  //! Return OpenGL context of the view, or NULL.
+  static Handle(OpenGl_Context) viewGlContext(const Handle(V3d_View)& theView)
+  {
+    Handle(OpenGl_View) aGlView = !theView.IsNull() ? Handle(OpenGl_View)::DownCast(theView->View()) : Handle(OpenGl_View)();
+    return !aGlView.IsNull() && !aGlView->GlWindow().IsNull() ? aGlView->GlWindow()->GetGlContext() : Handle(OpenGl_Context)();
+  }
+}
+
+// ================================================================
+// Function : OcctResolutionScaler
+// ================================================================
+OcctResolutionScaler::OcctResolutionScaler()
+{
+  myClock.Start();
+}
+
+// ================================================================
+// Function : MinScale
+// ================================================================
+double OcctResolutionScaler::MinScale() const
+{
+  return Min(1.0, Max(myParams.MinScale, myParams.MinLogicalDensity / myDevicePixelRatio));
+}
+
+// ================================================================
+// Function : SetDevicePixelRatio
+// ================================================================
+void OcctResolutionScaler::SetDevicePixelRatio(double theRatio)
+{
+  myDevicePixelRatio = theRatio > 0.0 ? theRatio : 1.0;
+  myScale = Max(myScale, MinScale());
+}
+
+// ================================================================
+// Function : Update
+// ================================================================
+double OcctResolutionScaler::Update(const Handle(V3d_View)& theView)
+{
+  if (theView.IsNull())
+    return -1.0;
+
+  // camera state changes on dragging, zooming, panning and animation
+  const double aTime = myClock.ElapsedTime();
+  const Graphic3d_WorldViewProjState aCamState = theView->Camera()->WorldViewProjState();
+  if (myCameraState.IsValid()
+   && myCameraState.IsChanged(aCamState))
+  {
+    myLastMoveTime = aTime;
+  }
+  myCameraState = aCamState;
+
+  // remember value defined by application while rendering static frames
+  Graphic3d_RenderingParams& aParams = theView->ChangeRenderingParams();
+  if (myFrameScale < 0.0)
+    myBaseScale = aParams.RenderResolutionScale;
+
+  const double anIdleTime = aTime - myLastMoveTime;
+  const bool isInteractive = myIsEnabled
+                          && myLastMoveTime >= 0.0
+                          && anIdleTime < myParams.IdleTimeout;
+  myFrameScale = isInteractive ? myScale : -1.0;
+
+  const float aScale = float(isInteractive ? myBaseScale * myScale : myBaseScale);
+  if (aParams.RenderResolutionScale != aScale)
+  {
+    aParams.RenderResolutionScale = aScale;
+    theView->Invalidate();
+  }
+
+  // reduced frame should be followed by the full one even if nothing else asks for redraw
+  return isInteractive && myScale < 1.0 ? myParams.IdleTimeout - anIdleTime : -1.0;
+}
+
+// ================================================================
+// Function : Release
+// ================================================================
+void OcctResolutionScaler::Release(const Handle(V3d_View)& theView)
+{
+  const Handle(OpenGl_Context) aGlCtx = viewGlContext(theView);
+  if (!aGlCtx.IsNull()
+    && aGlCtx.get() == myQueryCtx
+    && aGlCtx->core33 != nullptr)
+  {
+    if (!aGlCtx->IsCurrent())
+      aGlCtx->MakeCurrent();
+
+    for (TimerQuery& aQueryIter : myQueries)
+    {
+      if (aQueryIter.Id != 0)
+        aGlCtx->core33->glDeleteQueries(1, &aQueryIter.Id);
+    }
+  }
+
+  for (TimerQuery& aQueryIter : myQueries)
+    aQueryIter = TimerQuery();
+
+  myQueryCtx    = nullptr;
+  myActiveQuery = -1;
+  mySamples.clear();
+}
+
+// ================================================================
+// Function : BeginFrame
+// ================================================================
+void OcctResolutionScaler::BeginFrame(const Handle(V3d_View)& theView)
+{
+  myActiveQuery = -1;
+  const Handle(OpenGl_Context) aGlCtx = viewGlContext(theView);
+  if (aGlCtx.IsNull())
+    return;
+
+  // timer queries are part of desktop OpenGL 3.3
+  if (aGlCtx->core33 == nullptr)
+  {
+    myCpuTimer.Reset();
+    myCpuTimer.Start();
+    return;
+  }
+
+  if (!aGlCtx->IsCurrent())
+    aGlCtx->MakeCurrent();
+
+  if (myQueryCtx != aGlCtx.get())
+  {
+    // query objects of previous context have been released together with it
+    for (TimerQuery& aQueryIter : myQueries)
+      aQueryIter = TimerQuery();
+
+    myQueryCtx = aGlCtx.get();
+  }
+
+  fetchQueries(aGlCtx);
+  for (int aQueryIter = 0; aQueryIter < 3; ++aQueryIter)
+  {
+    if (!myQueries[aQueryIter].IsPending)
+    {
+      myActiveQuery = aQueryIter;
+      break;
+    }
+  }
+  if (myActiveQuery < 0)
+    return; // all queries are still in flight - skip measuring this frame
+
+  TimerQuery& aQuery = myQueries[myActiveQuery];
+  if (aQuery.Id == 0)
+    aGlCtx->core33->glGenQueries(1, &aQuery.Id);
+
+  aQuery.FrameScale = myFrameScale;
+  aGlCtx->core33->glBeginQuery(GL_TIME_ELAPSED, aQuery.Id);
+}
+
+// ================================================================
+// Function : EndFrame
+// ================================================================
+void OcctResolutionScaler::EndFrame(const Handle(V3d_View)& theView)
+{
+  if (myActiveQuery >= 0)
+  {
+    // result is fetched by one of the next frames to avoid waiting for GPU
+    const Handle(OpenGl_Context) aGlCtx = viewGlContext(theView);
+    aGlCtx->core33->glEndQuery(GL_TIME_ELAPSED);
+    myQueries[myActiveQuery].IsPending = true;
+    myActiveQuery = -1;
+  }
+  else if (myCpuTimer.IsStarted())
+  {
+    myCpuTimer.Stop();
+    addSample(myCpuTimer.ElapsedTime(), myFrameScale);
+  }
+}
+
+// ================================================================
+// Function : fetchQueries
+// ================================================================
+void OcctResolutionScaler::fetchQueries(const Handle(OpenGl_Context)& theGlCtx)
+{
+  for (TimerQuery& aQueryIter : myQueries)
+  {
+    if (!aQueryIter.IsPending)
+      continue;
+
+    GLint isAvailable = GL_FALSE;
+    theGlCtx->core33->glGetQueryObjectiv(aQueryIter.Id, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+    if (isAvailable == GL_FALSE)
+      continue;
+
+    GLuint64 aNanoSeconds = 0;
+    theGlCtx->core33->glGetQueryObjectui64v(aQueryIter.Id, GL_QUERY_RESULT, &aNanoSeconds);
+    aQueryIter.IsPending = false;
+    addSample(double(aNanoSeconds) * 1.0e-9, aQueryIter.FrameScale);
+  }
+}
+
+// ================================================================
+// Function : addSample
+// ================================================================
+void OcctResolutionScaler::addSample(double theFrameTime, double theFrameScale)
+{
+  myLastFrameTime = theFrameTime;
+
+  // static frames and frames rendered before the last adjustment do not describe current cost
+  if (!myIsEnabled
+    || theFrameScale != myScale)
+    return;
+
+  mySamples.push_back(theFrameTime);
+  if (int(mySamples.size()) < Max(myParams.NbSamples, 1))
+    return;
+
+  double aMeanTime = 0.0;
+  for (double aSampleIter : mySamples)
+    aMeanTime += aSampleIter;
+
+  aMeanTime /= double(mySamples.size());
+  mySamples.clear();
+
+  // no adjustment within hysteresis band; pixel cost is proportional to square of the scale
+  const double aTarget = myParams.TargetFrameTime;
+  double aNewScale = myScale;
+  if (aMeanTime > aTarget * myParams.UpperThreshold)
+    aNewScale = myScale * Sqrt(aTarget / aMeanTime);
+  else if (aMeanTime < aTarget * myParams.LowerThreshold)
+    aNewScale = Min(myScale * Sqrt(aTarget / Max(aMeanTime, 1.0e-6)), myScale * myParams.MaxScaleUp);
+
+  myScale = Max(MinScale(), Min(aNewScale, 1.0));
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctResolutionScaler_HeaderFile
+#define _OcctResolutionScaler_HeaderFile
+
+#include <Graphic3d_WorldViewProjState.hxx>
+#include <OSD_Timer.hxx>
+#include <Standard_Handle.hxx>
+
+#include <vector>
+
+class OpenGl_Context;
+class V3d_View;
+
+//! Dynamic resolution controller adjusting Graphic3d_RenderingParams::RenderResolutionScale
+//! to hold the target frame time during interaction.
+//!
+//! Frame time is measured by GL_TIME_ELAPSED queries read back with a few frames of latency
+//! (without stalling the pipeline), or by CPU wall-clock time on OpenGL ES / old desktop GL.
+//! GPU time is used as only this part of the frame cost depends on resolution.
+//! Scale is adjusted once per window of several frames only if average frame time leaves
+//! the hysteresis band around the target; pixel cost is assumed to be proportional to the area.
+//! Frames are considered interactive while camera moves (tracked by controller itself,
+//! independently from OcctInteractionLod), and static frames are always rendered
+//! at the full resolution defined by application once camera remains idle for a configurable time.
+//!
+//! Expected usage within AIS_ViewController::handleViewRedraw():
+//! @code
+//!   const double aRedrawDelay = myResolutionScaler.Update(theView); // schedule redraw at full resolution if non-negative
+//!   myResolutionScaler.BeginFrame(theView);
+//!   AIS_ViewController::handleViewRedraw(theCtx, theView);
+//!   myResolutionScaler.EndFrame(theView);
+//! @endcode
+//! Query objects should be released by Release() before releasing the view.
+class OcctResolutionScaler
+{
+public:
+  //! Scaling parameters.
+  struct Params
+  {
+    double TargetFrameTime   = 0.016; //!< target frame time in seconds
+    double UpperThreshold    = 1.15;  //!< reduce scale when frame time exceeds target by this factor
+    double LowerThreshold    = 0.70;  //!< increase scale when frame time falls below target by this factor
+    double MaxScaleUp        = 1.10;  //!< maximal relative scale increase per adjustment
+    double MinScale          = 0.25;  //!< absolute lower limit of the scale
+    double MinLogicalDensity = 0.75;  //!< lower limit of rendered pixels per logical (device-independent) pixel
+    int    NbSamples         = 8;     //!< number of measured frames per adjustment
+    double IdleTimeout       = 0.3;   //!< idle time of camera in seconds to restore full resolution
+  };
+
+public:
+  //! Empty constructor.
+  OcctResolutionScaler();
+
+  //! Return TRUE if controller is enabled; TRUE by default.
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable/disable controller; full resolution is restored on the next Update() when disabled.
+  void SetEnabled(bool theIsEnabled) { myIsEnabled = theIsEnabled; }
+
+  //! Return scaling parameters.
+  const Params& ScaleParams() const { return myParams; }
+
+  //! Return scaling parameters for modification.
+  Params& ChangeScaleParams() { return myParams; }
+
+  //! Return resolution scale used for interactive frames relative to the scale defined by application.
+  double Scale() const { return myScale; }
+
+  //! Return lower limit of the scale for the current screen.
+  double MinScale() const;
+
+  //! Set device pixel ratio of the screen the view is displayed on;
+  //! high-density screens allow lower scale for the same visual quality.
+  void SetDevicePixelRatio(double theRatio);
+
+  //! Return last measured frame time in seconds, or negative value if unknown.
+  double LastFrameTime() const { return myLastFrameTime; }
+
+  //! Apply resolution scale to the view for the frame to be rendered.
+  //! @param[in] theView  view to be redrawn
+  //! @return delay in seconds to redraw the view for restoring full resolution, or negative value if not needed
+  double Update(const Handle(V3d_View)& theView);
+
+  //! Release GPU timer queries; should be called before releasing the view.
+  void Release(const Handle(V3d_View)& theView);
+
+  //! Start measuring frame; should be called right before redrawing the view.
+  void BeginFrame(const Handle(V3d_View)& theView);
+
+  //! Finish measuring frame; should be called right after redrawing the view.
+  void EndFrame(const Handle(V3d_View)& theView);
+
+private:
+  //! Collect results of finished GPU timer queries.
+  void fetchQueries(const Handle(OpenGl_Context)& theGlCtx);
+
+  //! Add measured frame time and adjust scale once enough samples have been collected.
+  //! @param[in] theFrameTime   measured frame time in seconds
+  //! @param[in] theFrameScale  relative scale the frame has been rendered with, or negative for static frame
+  void addSample(double theFrameTime, double theFrameScale);
+
+private:
+  //! GPU timer query slot.
+  struct TimerQuery
+  {
+    unsigned int Id         = 0;     //!< query object
+    bool         IsPending  = false; //!< query has been issued but result is not yet fetched
+    double       FrameScale = -1.0;  //!< relative scale of measured frame, or negative for static frame
+  };
+
+private:
+  Params                myParams;
+  std::vector<double>   mySamples;
+  OSD_Timer             myClock;
+  Graphic3d_WorldViewProjState myCameraState;
+  double                myLastMoveTime = -1.0;
+  TimerQuery            myQueries[3];          //!< ring of GPU timer queries
+  const OpenGl_Context* myQueryCtx = nullptr;  //!< context owning query objects
+  int                   myActiveQuery = -1;    //!< query measuring current frame
+  OSD_Timer             myCpuTimer;            //!< fallback timer when GPU queries are unavailable
+  double                myScale = 1.0;         //!< relative scale for interactive frames
+  double                myBaseScale = 1.0;     //!< scale of static frames defined by application
+  double                myFrameScale = -1.0;   //!< relative scale of current frame, or negative for static frame
+  double                myDevicePixelRatio = 1.0;
+  double                myLastFrameTime = -1.0;
+  bool                  myIsEnabled = true;
+};
+
+#endif // _OcctResolutionScaler_HeaderFile
@@ -0,0 +1,152 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctSharedViewer.h"
+
+#include <AIS_ListOfInteractive.hxx>
+#include <Graphic3d_GraphicDriver.hxx>
+
+// ================================================================
+// Function : OcctSharedViewer
+// ================================================================
+OcctSharedViewer::OcctSharedViewer(const Handle(Graphic3d_GraphicDriver)& theDriver)
+{
+  // create viewer
+  myViewer = new V3d_Viewer(theDriver);
+  myViewer->SetDefaultBackgroundColor(Quantity_NOC_BLACK);
+  myViewer->SetDefaultLights();
+  myViewer->SetLightOn();
+  myViewer->ActivateGrid(Aspect_GT_Rectangular, Aspect_GDM_Lines);
+
+  // create AIS context;
+  // shapes are meshed in advance by OcctTessellator - never mesh them within rendering thread
+  myContext = new AIS_InteractiveContext(myViewer);
+  myContext->DefaultDrawer()->SetAutoTriangulation(false);
+}
+
+// ================================================================
+// Function : ~OcctSharedViewer
+// ================================================================
+OcctSharedViewer::~OcctSharedViewer()
+{
+  //
+}
+
+// ================================================================
+// Function : AddView
+// ================================================================
+void OcctSharedViewer::AddView(const Handle(V3d_View)& theView,
+                               const Handle(AIS_InteractiveObject)& theViewCube,
+                               const std::function<void()>& theRedrawFunc)
+{
+  ViewEntry anEntry;
+  anEntry.View       = theView;
+  anEntry.ViewCube   = theViewCube;
+  anEntry.RedrawFunc = theRedrawFunc;
+  myViews.push_back(anEntry);
+  myPicker.AddView(theView, theRedrawFunc);
+  updateViewAffinity();
+}
+
+// ================================================================
+// Function : RemoveView
+// ================================================================
+void OcctSharedViewer::RemoveView(const Handle(V3d_View)& theView)
+{
+  myPicker.RemoveView(theView);
+  for (std::vector<ViewEntry>::iterator anEntryIter = myViews.begin(); anEntryIter != myViews.end(); ++anEntryIter)
+  {
+    if (anEntryIter->View != theView)
+      continue;
+
+    if (!anEntryIter->ViewCube.IsNull())
+      myContext->Remove(anEntryIter->ViewCube, false);
+
+    myViews.erase(anEntryIter);
+    break;
+  }
+
+  if (myViews.empty())
+  {
+    // release presentations while the last OpenGL context is still alive
+    myContext->RemoveAll(false);
+    myHasSampleModel = false;
+  }
+  theView->Remove();
+}
+
+// ================================================================
+// Function : DisplayViewCube
+// ================================================================
+void OcctSharedViewer::DisplayViewCube(const Handle(V3d_View)& theView)
+{
+  for (const ViewEntry& anEntry : myViews)
+  {
+    if (anEntry.View == theView
+    && !anEntry.ViewCube.IsNull())
+    {
+      myContext->Display(anEntry.ViewCube, 0, 0, false);
+    }
+  }
+  updateViewAffinity();
+}
+
+// ================================================================
+// Function : RemoveModel
+// ================================================================
+void OcctSharedViewer::RemoveModel()
+{
+  AIS_ListOfInteractive anObjects;
+  myContext->ObjectsInside(anObjects);
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    bool isViewCube = false;
+    for (const ViewEntry& anEntry : myViews)
+    {
+      isViewCube = isViewCube || anEntry.ViewCube == anObjIter.Value();
+    }
+    if (!isViewCube)
+      myContext->Remove(anObjIter.Value(), false);
+  }
+  InvalidateViews(Handle(V3d_View)());
+}
+
+// ================================================================
+// Function : InvalidateViews
+// ================================================================
+void OcctSharedViewer::InvalidateViews(const Handle(V3d_View)& theExceptView)
+{
+  InvalidateScene();
+  for (const ViewEntry& anEntry : myViews)
+  {
+    if (anEntry.View == theExceptView)
+      continue;
+
+    anEntry.View->Invalidate();
+    if (anEntry.RedrawFunc)
+      anEntry.RedrawFunc();
+  }
+}
+
+// ================================================================
+// Function : updateViewAffinity
+// ================================================================
+void OcctSharedViewer::updateViewAffinity()
+{
+  if (myViews.size() < 2)
+    return;
+
+  // affinity is defined only for displayed objects
+  for (const ViewEntry& aCubeEntry : myViews)
+  {
+    if (aCubeEntry.ViewCube.IsNull()
+    || !myContext->IsDisplayed(aCubeEntry.ViewCube))
+    {
+      continue;
+    }
+
+    for (const ViewEntry& aViewEntry : myViews)
+    {
+      myContext->SetViewAffinity(aCubeEntry.ViewCube, aViewEntry.View, aViewEntry.View == aCubeEntry.View);
+    }
+  }
+}
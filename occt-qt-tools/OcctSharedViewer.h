@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctSharedViewer_HeaderFile
+#define _OcctSharedViewer_HeaderFile
+
+#include "OcctAsyncPicker.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Standard_Transient.hxx>
+#include <V3d_View.hxx>
+#include <V3d_Viewer.hxx>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+class Graphic3d_GraphicDriver;
+
+//! Graphic driver, viewer and interactive context shared by several views (like MDI windows showing the same model).
+//!
+//! Views of one driver share a display connection and OpenGL resources (geometry buffers, shader programs, textures),
+//! so that presentations are computed and uploaded to GPU memory only once.
+//! OpenGL contexts of the views should belong to the same share group (Qt::AA_ShareOpenGLContexts),
+//! and all views should be rendered from the same thread.
+//!
+//! Every view registers its own view cube, which is displayed only within that view (view affinity),
+//! and a redraw function used to propagate changes of the shared context (displayed parts, selection).
+//! Dynamic highlighting is not propagated - other views will show it on their next redraw.
+//!
+//! Asynchronous picker (and its selection lock) is also shared, as all views traverse the same sensitive entities.
+class OcctSharedViewer : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctSharedViewer, Standard_Transient)
+public:
+  //! Create viewer and interactive context for the given graphic driver.
+  OcctSharedViewer(const Handle(Graphic3d_GraphicDriver)& theDriver);
+
+  //! Destructor.
+  virtual ~OcctSharedViewer();
+
+  //! Return viewer.
+  const Handle(V3d_Viewer)& Viewer() const { return myViewer; }
+
+  //! Return interactive context.
+  const Handle(AIS_InteractiveContext)& Context() const { return myContext; }
+
+  //! Return asynchronous picker shared by all views.
+  OcctAsyncPicker& Picker() { return myPicker; }
+
+  //! Return number of attached views.
+  int NbViews() const { return (int)myViews.size(); }
+
+  //! Attach a new view.
+  //! @param[in] theView        view created by Viewer()->CreateView()
+  //! @param[in] theViewCube    view cube to be displayed only within this view (might be NULL)
+  //! @param[in] theRedrawFunc  function requesting redraw of the view
+  //!                           (called from rendering thread and from picking thread)
+  void AddView(const Handle(V3d_View)& theView,
+               const Handle(AIS_InteractiveObject)& theViewCube,
+               const std::function<void()>& theRedrawFunc);
+
+  //! Detach and remove the view together with its view cube;
+  //! all objects are removed from context with the last view.
+  void RemoveView(const Handle(V3d_View)& theView);
+
+  //! Display view cube of the view and hide it within other views.
+  void DisplayViewCube(const Handle(V3d_View)& theView);
+
+  //! Remove all objects except view cubes.
+  void RemoveModel();
+
+  //! Return TRUE on the first call; used to display sample model only once for all views.
+  bool ToDisplaySampleModel()
+  {
+    const bool toDisplay = !myHasSampleModel;
+    myHasSampleModel = true;
+    return toDisplay;
+  }
+
+  //! Invalidate and request redraw of views other than specified one after modification of shared context;
+  //! increments scene revision.
+  void InvalidateViews(const Handle(V3d_View)& theExceptView);
+
+  //! Return scene revision - counter incremented on modification of displayed objects or their display modes;
+  //! used to repeat dynamic highlighting under still cursor.
+  size_t SceneRevision() const { return mySceneRevision.load(); }
+
+  //! Increment scene revision without redrawing other views.
+  void InvalidateScene() { ++mySceneRevision; }
+
+private:
+  //! Attached view.
+  struct ViewEntry
+  {
+    Handle(V3d_View)              View;
+    Handle(AIS_InteractiveObject) ViewCube;
+    std::function<void()>         RedrawFunc;
+  };
+
+private:
+  //! Make view cubes visible only within their own views.
+  void updateViewAffinity();
+
+private:
+  Handle(V3d_Viewer)             myViewer;
+  Handle(AIS_InteractiveContext) myContext;
+  std::vector<ViewEntry>         myViews;
+  OcctAsyncPicker                myPicker;
+  std::atomic<size_t>            mySceneRevision { 0 };
+  bool                           myHasSampleModel = false;
+};
+
+#endif // _OcctSharedViewer_HeaderFile
@@ -0,0 +1,256 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctTessellator.h"
+
+#include <BRepBndLib.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Timer.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <NCollection_DataMap.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <TopoDS.hxx>
+
+// ================================================================
+// Function : ToString
+// ================================================================
+TCollection_AsciiString OcctTessellator::Stats::ToString() const
+{
+  TCollection_AsciiString aText = TCollection_AsciiString() + int(NbParts) + " parts, " + int(NbFaces) + " faces, "
+                                + int(NbTriangles) + " triangles in " + ElapsedTime + " s ("
+                                + int(TrianglesPerSecond()) + " triangles/s)";
+  if (NbCached != 0)
+    aText += TCollection_AsciiString(", ") + int(NbCached) + " parts from cache";
+  if (NbFailed != 0)
+    aText += TCollection_AsciiString(", ") + int(NbFailed) + " parts failed";
+
+  return aText;
+}
+
+// ================================================================
+// Function : PartDeflection
+// ================================================================
+void OcctTessellator::PartDeflection(const TopoDS_Shape& thePart,
+                                     double& theLinDeflection,
+                                     double& theAngDeflection) const
+{
+  // ignore existing triangulation, so that deflection (and cache key) doesn't depend on whether part is meshed
+  Bnd_Box aBox;
+  BRepBndLib::Add(thePart, aBox, false);
+  const double aDiag = !aBox.IsVoid() ? Sqrt(aBox.SquareExtent()) : 0.0;
+
+  theLinDeflection = aDiag * myPolicy.RelDeflection;
+  theLinDeflection = Max(theLinDeflection, myPolicy.MinDeflection > 0.0 ? myPolicy.MinDeflection : Precision::Confusion());
+  if (myPolicy.MaxDeflection > 0.0)
+    theLinDeflection = Min(theLinDeflection, myPolicy.MaxDeflection);
+
+  theAngDeflection = myPolicy.SmallPartSize > 0.0 && aDiag < myPolicy.SmallPartSize
+                   ? myPolicy.SmallAngDeflection
+                   : myPolicy.AngDeflection;
+}
+
+// ================================================================
+// Function : MeshPart
+// ================================================================
+bool OcctTessellator::MeshPart(const TopoDS_Shape& thePart, bool* theIsCached) const
+{
+  return meshPart(thePart, myPolicy.InParallel, theIsCached);
+}
+
+// ================================================================
+// Function : meshPart
+// ================================================================
+bool OcctTessellator::meshPart(const TopoDS_Shape& thePart, bool theInParallel, bool* theIsCached) const
+{
+  if (theIsCached != nullptr)
+    *theIsCached = false;
+
+  if (thePart.IsNull())
+    return true;
+
+  double aLinDefl = 0.0, anAngDefl = 0.0;
+  PartDeflection(thePart, aLinDefl, anAngDefl);
+  if (!myCache.IsNull()
+    && myCache->Restore(thePart, aLinDefl, anAngDefl))
+  {
+    if (theIsCached != nullptr)
+      *theIsCached = true;
+
+    return true;
+  }
+
+  try
+  {
+    BRepMesh_IncrementalMesh aMesher(thePart, aLinDefl, false, anAngDefl, theInParallel);
+  }
+  catch (const Standard_Failure& theEx)
+  {
+    Message::SendWarning() << "Warning: part meshing failed: " << theEx;
+    return false;
+  }
+
+  if (!myCache.IsNull())
+    myCache->Store(thePart, aLinDefl, anAngDefl);
+
+  return true;
+}
+
+// ================================================================
+// Function : Perform
+// ================================================================
+bool OcctTessellator::Perform(const std::vector<TopoDS_Shape>& theParts,
+                              const PartCallback& theCallback,
+                              const Message_ProgressRange& theRange)
+{
+  myStats = Stats();
+  OSD_Timer aTimer;
+  aTimer.Start();
+
+  // instances share the same TShape and should be meshed once
+  TopTools_IndexedMapOfShape aUniqueParts;
+  std::vector<int> aPartToUnique(theParts.size(), -1);
+  for (size_t aPartIter = 0; aPartIter < theParts.size(); ++aPartIter)
+  {
+    if (!theParts[aPartIter].IsNull())
+      aPartToUnique[aPartIter] = aUniqueParts.Add(theParts[aPartIter].Located(TopLoc_Location())) - 1;
+  }
+
+  const int aNbUnique = aUniqueParts.Extent();
+  std::vector<std::vector<size_t>> aUniqueToParts(size_t(aNbUnique));
+  for (size_t aPartIter = 0; aPartIter < theParts.size(); ++aPartIter)
+  {
+    if (aPartToUnique[aPartIter] >= 0)
+      aUniqueToParts[size_t(aPartToUnique[aPartIter])].push_back(aPartIter);
+  }
+
+  // unique parts sharing edges (and thus faces) with each other are meshed sequentially,
+  // as mesher writes polygons into shared BRep_TEdge
+  std::vector<char> aToMeshAlone(size_t(aNbUnique), 0);
+  {
+    NCollection_DataMap<TopoDS_Shape, int, TopTools_ShapeMapHasher> anEdgeOwners;
+    for (int aUniqueIter = 0; aUniqueIter < aNbUnique; ++aUniqueIter)
+    {
+      for (TopExp_Explorer anEdgeIter(aUniqueParts(aUniqueIter + 1), TopAbs_EDGE); anEdgeIter.More(); anEdgeIter.Next())
+      {
+        const TopoDS_Shape anEdge = anEdgeIter.Current().Located(TopLoc_Location());
+        if (const int* anOwner = anEdgeOwners.Seek(anEdge))
+        {
+          if (*anOwner != aUniqueIter)
+          {
+            aToMeshAlone[size_t(*anOwner)]    = 1;
+            aToMeshAlone[size_t(aUniqueIter)] = 1;
+          }
+        }
+        else
+        {
+          anEdgeOwners.Bind(anEdge, aUniqueIter);
+        }
+      }
+    }
+  }
+
+  std::vector<int> aParallelParts, aSerialParts;
+  for (int aUniqueIter = 0; aUniqueIter < aNbUnique; ++aUniqueIter)
+  {
+    if (aToMeshAlone[size_t(aUniqueIter)] != 0)
+      aSerialParts.push_back(aUniqueIter);
+    else
+      aParallelParts.push_back(aUniqueIter);
+  }
+
+  // sub-ranges should be created sequentially, while their closing is thread-safe
+  Message_ProgressScope aPS(theRange, "Meshing", double(Max(aNbUnique, 1)));
+  std::vector<Message_ProgressRange> aRanges(size_t(aNbUnique));
+  for (Message_ProgressRange& aRangeIter : aRanges)
+    aRangeIter = aPS.Next();
+
+  // per-part results are gathered without locks and summed up at the end
+  std::vector<size_t> aNbTris (size_t(aNbUnique), 0);
+  std::vector<size_t> aNbFaces(size_t(aNbUnique), 0);
+  std::vector<char>   aStates (size_t(aNbUnique), 0); // 0 - skipped, 1 - meshed, 2 - failed, 3 - cached
+  const auto aMeshUnique = [&](int theUnique, bool theInParallel)
+  {
+    Message_ProgressScope aPartPS(aRanges[theUnique], nullptr, 1);
+    if (aPartPS.UserBreak())
+      return;
+
+    const TopoDS_Shape& aPart = aUniqueParts(theUnique + 1);
+    bool isCached = false;
+    if (meshPart(aPart, theInParallel, &isCached))
+    {
+      aNbTris[theUnique] = NbTriangles(aPart, &aNbFaces[theUnique]);
+      aStates[theUnique] = isCached ? 3 : 1;
+    }
+    else
+    {
+      aStates[theUnique] = 2;
+    }
+
+    if (theCallback && !aPartPS.UserBreak())
+    {
+      for (size_t aPartIndex : aUniqueToParts[theUnique])
+        theCallback(aPartIndex);
+    }
+  };
+
+  // faces are meshed in parallel only by a part meshed alone
+  const bool toMeshFacesInParallel = myPolicy.InParallel && aParallelParts.size() <= 1;
+  OSD_Parallel::For(0, int(aParallelParts.size()), [&](int theIndex)
+  {
+    aMeshUnique(aParallelParts[theIndex], toMeshFacesInParallel);
+  });
+  for (int aUniqueIter : aSerialParts)
+    aMeshUnique(aUniqueIter, myPolicy.InParallel);
+
+  for (size_t aPartIter = 0; aPartIter < theParts.size(); ++aPartIter)
+  {
+    const int aUnique = aPartToUnique[aPartIter];
+    const char aState = aUnique >= 0 ? aStates[size_t(aUnique)] : 0;
+    if (aState == 2)
+      ++myStats.NbFailed;
+    else if (aState == 3)
+      ++myStats.NbCached;
+
+    if (aState != 1 && aState != 3)
+      continue;
+
+    ++myStats.NbParts;
+    myStats.NbFaces     += aNbFaces[size_t(aUnique)];
+    myStats.NbTriangles += aNbTris[size_t(aUnique)];
+  }
+  for (int aUniqueIter = 0; aUniqueIter < aNbUnique; ++aUniqueIter)
+  {
+    // each unique part is meshed once, regardless of the number of instances
+    if (aStates[size_t(aUniqueIter)] == 1)
+      myStats.NbMeshedTriangles += aNbTris[size_t(aUniqueIter)];
+  }
+  myStats.ElapsedTime = aTimer.ElapsedTime();
+  return !aPS.UserBreak();
+}
+
+// ================================================================
+// Function : NbTriangles
+// ================================================================
+size_t OcctTessellator::NbTriangles(const TopoDS_Shape& theShape, size_t* theNbFaces)
+{
+  size_t aNbTris = 0, aNbFaces = 0;
+  for (TopExp_Explorer aFaceIter(theShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Current()), aLoc);
+    ++aNbFaces;
+    if (!aTris.IsNull())
+      aNbTris += size_t(aTris->NbTriangles());
+  }
+  if (theNbFaces != nullptr)
+    *theNbFaces = aNbFaces;
+
+  return aNbTris;
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctTessellator_HeaderFile
+#define _OcctTessellator_HeaderFile
+
+#include <Message_ProgressRange.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Transient.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <functional>
+#include <vector>
+
+//! Interface of triangulation cache consulted by OcctTessellator before meshing a part.
+//! Methods are called from multiple working threads concurrently.
+class OcctTessellatorCache : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctTessellatorCache, Standard_Transient)
+public:
+  //! Restore triangulation of the part meshed with specified parameters.
+  //! @return FALSE on cache miss
+  virtual bool Restore(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection) = 0;
+
+  //! Store triangulation of the meshed part.
+  virtual void Store(const TopoDS_Shape& thePart, double theLinDeflection, double theAngDeflection) = 0;
+};
+
+//! Tessellation service meshing shapes in advance (e.g. within a working thread) with BRepMesh_IncrementalMesh,
+//! so that presentations (AIS_Shape) never mesh shapes on their own within rendering thread.
+//!
+//! Parts are meshed in parallel. Instances sharing the same TShape (e.g. repeated within STEP assembly)
+//! are meshed once, while unique parts sharing faces with other parts are meshed sequentially,
+//! so that triangulation of the same face is never written by two threads.
+//! Faces within a part are meshed in parallel only when the part is meshed alone (no nested parallelism).
+//! Deflection is defined by a policy depending on part dimensions.
+//! Optional cache is consulted before meshing each part.
+class OcctTessellator
+{
+public:
+  //! Deflection policy.
+  struct Policy
+  {
+    double RelDeflection      = 0.001; //!< linear deflection relative to the part bounding box diagonal
+    double MinDeflection      = 0.0;   //!< lower limit of linear deflection; 0 means Precision::Confusion()
+    double MaxDeflection      = 0.0;   //!< upper limit of linear deflection; 0 means unlimited
+    double AngDeflection      = 20.0 * M_PI / 180.0; //!< angular deflection (same as Prs3d_Drawer default)
+    double SmallPartSize      = 0.0;   //!< parts with diagonal below this size use SmallAngDeflection; 0 to disable
+    double SmallAngDeflection = 40.0 * M_PI / 180.0; //!< angular deflection for small parts
+    bool   InParallel         = true;  //!< mesh faces within the part in parallel, when parts themselves are not
+  };
+
+  //! Statistics of the last Perform() call.
+  struct Stats
+  {
+    size_t NbParts           = 0;   //!< number of meshed parts
+    size_t NbFaces           = 0;   //!< number of faces
+    size_t NbTriangles       = 0;   //!< number of triangles
+    size_t NbMeshedTriangles = 0;   //!< number of triangles in unique parts actually meshed (not restored from cache)
+    size_t NbFailed          = 0;   //!< number of parts failed to be meshed
+    size_t NbCached          = 0;   //!< number of parts restored from cache
+    double ElapsedTime       = 0.0; //!< wall-clock meshing time in seconds
+
+    //! Return meshing throughput; parts restored from cache are not counted.
+    double TrianglesPerSecond() const { return ElapsedTime > 0.0 ? double(NbMeshedTriangles) / ElapsedTime : 0.0; }
+
+    //! Format statistics into string.
+    TCollection_AsciiString ToString() const;
+  };
+
+  //! Callback called from working threads once part has been meshed.
+  typedef std::function<void(size_t thePartIndex)> PartCallback;
+
+public:
+  //! Empty constructor.
+  OcctTessellator() {}
+
+  //! Return deflection policy.
+  const Policy& MeshPolicy() const { return myPolicy; }
+
+  //! Return deflection policy for modification.
+  Policy& ChangeMeshPolicy() { return myPolicy; }
+
+  //! Return statistics of the last Perform() call.
+  const Stats& LastStats() const { return myStats; }
+
+  //! Return triangulation cache.
+  const Handle(OcctTessellatorCache)& Cache() const { return myCache; }
+
+  //! Set triangulation cache; NULL by default.
+  void SetCache(const Handle(OcctTessellatorCache)& theCache) { myCache = theCache; }
+
+  //! Compute linear and angular deflection for the part according to the policy.
+  void PartDeflection(const TopoDS_Shape& thePart,
+                      double& theLinDeflection,
+                      double& theAngDeflection) const;
+
+  //! Mesh single part or restore its triangulation from cache (thread-safe, statistics are not updated).
+  //! @param[in]  thePart      part to mesh
+  //! @param[out] theIsCached  set to TRUE if triangulation has been restored from cache
+  //! @return FALSE on meshing failure
+  bool MeshPart(const TopoDS_Shape& thePart, bool* theIsCached = nullptr) const;
+
+  //! Mesh parts in parallel; statistics count each instance of shared part.
+  //! @param[in] theParts     parts to mesh
+  //! @param[in] theCallback  optional callback called from working threads for each meshed part (including every instance)
+  //! @param[in] theRange     progress range; cancellation is checked before meshing each part
+  //! @return FALSE if meshing has been cancelled
+  bool Perform(const std::vector<TopoDS_Shape>& theParts,
+               const PartCallback& theCallback = PartCallback(),
+               const Message_ProgressRange& theRange = Message_ProgressRange());
+
+  //! Return number of triangles of meshed shape.
+  static size_t NbTriangles(const TopoDS_Shape& theShape, size_t* theNbFaces = nullptr);
+
+private:
+  //! Mesh single part or restore its triangulation from cache.
+  bool meshPart(const TopoDS_Shape& thePart, bool theInParallel, bool* theIsCached) const;
+
+private:
+  Handle(OcctTessellatorCache) myCache;
+  Policy                       myPolicy;
+  Stats                        myStats;
+};
+
+#endif // _OcctTessellator_HeaderFile
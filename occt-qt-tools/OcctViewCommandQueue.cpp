@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#include "OcctViewCommandQueue.h"
+
+#include <OSD_Timer.hxx>
+
+// ================================================================
+// Function : Lock
+// ================================================================
+void OcctLockWaitStats::Lock(Standard_Mutex& theMutex)
+{
+  ++NbLocks;
+  if (theMutex.TryLock())
+    return;
+
+  OSD_Timer aTimer;
+  aTimer.Start();
+  theMutex.Lock();
+  const double aWait = aTimer.ElapsedTime();
+  ++NbContended;
+  TotalWait += aWait;
+  MaxWait = Max(MaxWait, aWait);
+}
+
+// ================================================================
+// Function : ToString
+// ================================================================
+TCollection_AsciiString OcctLockWaitStats::ToString() const
+{
+  return TCollection_AsciiString() + NbLocks + " locks, " + NbContended + " contended, "
+       + "total wait " + (TotalWait * 1000.0) + " ms, max wait " + (MaxWait * 1000.0) + " ms";
+}
+
+// ================================================================
+// Function : Push
+// ================================================================
+void OcctViewCommandQueue::Push(const Command& theCommand)
+{
+  myPushWait.Lock(myMutex);
+  myFront.push_back(theCommand);
+  myMutex.Unlock();
+}
+
+// ================================================================
+// Function : Swap
+// ================================================================
+bool OcctViewCommandQueue::Swap()
+{
+  mySwapWait.Lock(myMutex);
+  // append rather than replace to keep commands not yet executed
+  if (myBack.empty())
+  {
+    myBack.swap(myFront);
+  }
+  else
+  {
+    myBack.insert(myBack.end(), myFront.begin(), myFront.end());
+    myFront.clear();
+  }
+  myMutex.Unlock();
+  return !myBack.empty();
+}
+
+// ================================================================
+// Function : Execute
+// ================================================================
+void OcctViewCommandQueue::Execute()
+{
+  for (const Command& aCmdIter : myBack)
+    aCmdIter();
+
+  myBack.clear();
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctViewCommandQueue_HeaderFile
+#define _OcctViewCommandQueue_HeaderFile
+
+#include <Standard_Mutex.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <functional>
+#include <vector>
+
+//! Lock-wait time counters.
+//! Counters are updated by the locking thread and might be read from another thread only for reporting.
+struct OcctLockWaitStats
+{
+  int    NbLocks     = 0;   //!< number of lock acquisitions
+  int    NbContended = 0;   //!< number of lock acquisitions which had to wait
+  double TotalWait   = 0.0; //!< total wait time in seconds
+  double MaxWait     = 0.0; //!< maximum wait time in seconds
+
+  //! Lock the mutex and account wait time.
+  void Lock(Standard_Mutex& theMutex);
+
+  //! Reset counters.
+  void Reset() { *this = OcctLockWaitStats(); }
+
+  //! Format counters into string.
+  TCollection_AsciiString ToString() const;
+};
+
+//! Double-buffered queue of commands passed from GUI thread to rendering thread.
+//!
+//! GUI thread appends commands to the front buffer, while rendering thread swaps buffers
+//! (e.g. within QQuickFramebufferObject::Renderer::synchronize()) and executes the back buffer
+//! without holding any lock, so that GUI thread never waits for a frame in progress.
+//! The lock is held only for appending a command or swapping two vectors.
+class OcctViewCommandQueue
+{
+public:
+  //! Command to be executed by rendering thread.
+  typedef std::function<void()> Command;
+
+public:
+  //! Empty constructor.
+  OcctViewCommandQueue() {}
+
+  //! Append command to be executed by rendering thread (called from GUI thread).
+  void Push(const Command& theCommand);
+
+  //! Swap buffers (called from rendering thread);
+  //! commands pushed after this call will be executed next time.
+  //! @return TRUE if there are commands to execute
+  bool Swap();
+
+  //! Execute commands taken by the last Swap() (called from rendering thread).
+  void Execute();
+
+  //! Return lock-wait counters of pushing (GUI) side.
+  const OcctLockWaitStats& PushWaitStats() const { return myPushWait; }
+
+  //! Return lock-wait counters of swapping (rendering) side.
+  const OcctLockWaitStats& SwapWaitStats() const { return mySwapWait; }
+
+private:
+  Standard_Mutex       myMutex;
+  std::vector<Command> myFront;
+  std::vector<Command> myBack;
+  OcctLockWaitStats    myPushWait;
+  OcctLockWaitStats    mySwapWait;
+};
+
+#endif // _OcctViewCommandQueue_HeaderFile
@@ -9,6 +9,7 @@
 #include "OcctQQuickFramebufferViewer.h"
 
 #include "../occt-qt-tools/OcctGlTools.h"
+#include "../occt-qt-tools/OcctTessellator.h"
 
 #include <Standard_WarningsDisable.hxx>
 #include <QApplication>
@@ -16,6 +17,7 @@
 #include <QMouseEvent>
 #include <QOpenGLFramebufferObject>
 #include <QQuickWindow>
+#include <QVector3D>
 #include <Standard_WarningsRestore.hxx>
 
 #include <AIS_Shape.hxx>
@@ -24,6 +26,10 @@
 #include <BRepPrimAPI_MakeBox.hxx>
 #include <Message.hxx>
 #include <OpenGl_GraphicDriver.hxx>
+#include <StdSelect_BRepOwner.hxx>
+#include <TopAbs.hxx>
+
+#include <map>
 
 #if !defined(__APPLE__) && !defined(_WIN32) && defined(__has_include)
   #if __has_include(<Xw_DisplayConnection.hxx>)
@@ -35,47 +41,62 @@
 typedef Aspect_DisplayConnection Xw_DisplayConnection;
 #endif
 
+namespace
+{
+  //! Convert frame timings into QML map of phase names to milliseconds.
+  static QVariantMap frameTimingsMap(const OcctFrameTimings::Record& theRecord)
+  {
+    QVariantMap aMap;
+    aMap["frame"] = QVariant::fromValue<qulonglong>(theRecord.FrameIndex);
+    aMap["total"] = theRecord.TotalTime * 1000.0;
+    for (int aPhaseIter = 0; aPhaseIter < OcctFramePhase_NB; ++aPhaseIter)
+      aMap[OcctFrameTimings::PhaseName((OcctFramePhase)aPhaseIter)] = theRecord.Phases[aPhaseIter] * 1000.0;
+
+    return aMap;
+  }
+
+  //! Create graphic driver and viewer for QtQuick items.
+  static Handle(OcctSharedViewer) createSharedViewer()
+  {
+    Handle(Aspect_DisplayConnection) aDisp   = new Xw_DisplayConnection();
+    Handle(OpenGl_GraphicDriver)     aDriver = new OpenGl_GraphicDriver(aDisp, false);
+    // lets QtQuick to manage buffer swap
+    aDriver->ChangeOptions().buffersNoSwap = true;
+    // don't write into alpha channel
+    aDriver->ChangeOptions().buffersOpaqueAlpha = true;
+    // offscreen FBOs should be always used
+    aDriver->ChangeOptions().useSystemBuffer = false;
+    return new OcctSharedViewer(aDriver);
+  }
+
+  //! Viewers shared by named groups of items (accessed from GUI thread).
+  static std::map<QString, Handle(OcctSharedViewer)>& sharedViewerGroups()
+  {
+    static std::map<QString, Handle(OcctSharedViewer)> THE_GROUPS;
+    return THE_GROUPS;
+  }
+}
+
 // ================================================================
 // Function : OcctQQuickFramebufferViewer
 // ================================================================
 OcctQQuickFramebufferViewer::OcctQQuickFramebufferViewer(QQuickItem* theParent)
     : QQuickFramebufferObject(theParent)
 {
-  Handle(Aspect_DisplayConnection) aDisp   = new Xw_DisplayConnection();
-  Handle(OpenGl_GraphicDriver)     aDriver = new OpenGl_GraphicDriver(aDisp, false);
-  // lets QtQuick to manage buffer swap
-  aDriver->ChangeOptions().buffersNoSwap = true;
-  // don't write into alpha channel
-  aDriver->ChangeOptions().buffersOpaqueAlpha = true;
-  // offscreen FBOs should be always used
-  aDriver->ChangeOptions().useSystemBuffer = false;
-
-  // create viewer
-  myViewer = new V3d_Viewer(aDriver);
-  myViewer->SetDefaultBackgroundColor(Quantity_NOC_BLACK);
-  myViewer->SetDefaultLights();
-  myViewer->SetLightOn();
-  myViewer->ActivateGrid(Aspect_GT_Rectangular, Aspect_GDM_Lines);
-
-  // create AIS context
-  myContext = new AIS_InteractiveContext(myViewer);
-
   myViewCube = new AIS_ViewCube();
   myViewCube->SetViewAnimation(myViewAnimation);
   myViewCube->SetFixedAnimationLoop(false);
   myViewCube->SetAutoStartAnimation(true);
   myViewCube->TransformPersistence()->SetOffset2d(Graphic3d_Vec2i(100, 150));
 
-  // note - window will be created later within initializeGL() callback!
-  myView = myViewer->CreateView();
-  myView->SetImmediateUpdate(false);
-#ifndef __APPLE__
-  myView->ChangeRenderingParams().NbMsaaSamples = 4; // warning - affects performance
-#endif
-  myView->ChangeRenderingParams().ToShowStats = true;
-  // NOLINTNEXTLINE
-  myView->ChangeRenderingParams().CollectedStats = (Graphic3d_RenderingParams::PerfCounters)(
-    Graphic3d_RenderingParams::PerfCounters_FrameRate | Graphic3d_RenderingParams::PerfCounters_Triangles);
+  // own viewer is created by default and replaced by shared one on viewerGroup property assignment
+  mySharedViewer = createSharedViewer();
+  createView();
+
+  // input events are stamped to measure input-to-photon latency,
+  // while dragged pointers are extrapolated to expected presentation time
+  myInputAccum.SetInputLatency(&myInputLatency);
+  myInputAccum.SetInputPredictor(&myInputPredictor);
 
   // QtQuick item setup
   setAcceptedMouseButtons(Qt::AllButtons);
@@ -83,6 +104,54 @@ OcctQQuickFramebufferViewer::OcctQQuickFramebufferViewer(QQuickItem* theParent)
   setAcceptHoverEvents(true);
   setMirrorVertically(true);
 
+  // redraw requests are throttled by presentation of previous frame;
+  // QQuickWindow::frameSwapped() is emitted from GL rendering thread - make queued connection
+  connect(&myFrameScheduler, &OcctQtFrameScheduler::frameRequested, this, &QQuickItem::update);
+  connect(this, &QQuickItem::windowChanged, this, [this](QQuickWindow* theWindow)
+  {
+    // previous window should no more drive this item
+    for (const QMetaObject::Connection& aConnIter : myConnections)
+      disconnect(aConnIter);
+
+    myConnections.clear();
+    if (theWindow == nullptr)
+      return;
+
+    myConnections.push_back(connect(theWindow, &QQuickWindow::frameSwapped,
+                                    &myFrameScheduler, &OcctQtFrameScheduler::FramePresented, Qt::QueuedConnection));
+
+    // composition time is measured within GL rendering thread, QML is notified through queued call
+    myConnections.push_back(connect(theWindow, &QQuickWindow::frameSwapped, this, [this]()
+    {
+      myFrameTimings.FramePresented();
+      myInputLatency.FramePresented(); // input events have been flushed by synchronize() of this frame
+      QMetaObject::invokeMethod(this, "frameTimingsChanged", Qt::QueuedConnection);
+    }, Qt::DirectConnection));
+  });
+
+  // full quality is restored by redrawing idle view
+  myLodTimer.setSingleShot(true);
+  connect(&myLodTimer, &QTimer::timeout, this, [this]() { updateView(); });
+
+  // loader signals are emitted from working threads and queued to GUI thread;
+  // loaded parts are displayed by rendering thread
+  connect(&myModelLoader, &OcctQtModelLoader::partsLoaded, this, [this]() { updateView(); });
+  connect(&myModelLoader, &OcctQtModelLoader::progressChanged, this, [this](double thePercent, const QString& theStep)
+  {
+    myLoadingProgress = thePercent;
+    myLoadingStatus   = theStep;
+    emit loadingChanged();
+  });
+  connect(&myModelLoader, &OcctQtModelLoader::loadingFinished, this, [this](bool , const QString& theMessage)
+  {
+    myLoadingProgress = 100.0;
+    myLoadingStatus   = theMessage;
+    emit loadingChanged();
+  });
+
+  // frames are captured by rendering thread
+  myFrameCapture.SetFrameRequester([this]() { updateView(); });
+
   // GUI elements cannot be created from GL rendering thread - make queued connection
   connect(this, &OcctQQuickFramebufferViewer::glCriticalError, this, [this](QString theMsg)
   {
@@ -96,22 +165,102 @@ OcctQQuickFramebufferViewer::OcctQQuickFramebufferViewer(QQuickItem* theParent)
 // ================================================================
 OcctQQuickFramebufferViewer::~OcctQQuickFramebufferViewer()
 {
+  for (const QMetaObject::Connection& aConnIter : myConnections)
+    disconnect(aConnIter);
+
+  myConnections.clear();
+
+  // stop background loading
+  myModelLoader.Cancel();
+
   // hold on X11 display connection till making another connection active by glXMakeCurrent()
   // to workaround sudden crash in QOpenGLWidget destructor
   Handle(Aspect_DisplayConnection) aDisp = myViewer->Driver()->GetDisplayConnection();
 
-  // release OCCT viewer
-  myContext->RemoveAll(false);
-  myContext.Nullify();
-  myView->Remove();
-  myView.Nullify();
-  myViewer.Nullify();
+  // release OCCT view; shared viewer is released with the last view
+  releaseView();
 
   // make active OpenGL context created by Qt
   //makeCurrent();
   aDisp.Nullify();
 }
 
+// ================================================================
+// Function : createView
+// ================================================================
+void OcctQQuickFramebufferViewer::createView()
+{
+  myViewer  = mySharedViewer->Viewer();
+  myContext = mySharedViewer->Context();
+
+  // note - window will be created later within initializeGL() callback!
+  myView = myViewer->CreateView();
+  myView->SetImmediateUpdate(false);
+#ifndef __APPLE__
+  myView->ChangeRenderingParams().NbMsaaSamples = 4; // warning - affects performance (disabled during interaction)
+#endif
+  myView->ChangeRenderingParams().ToShowStats = true;
+  // NOLINTNEXTLINE
+  myView->ChangeRenderingParams().CollectedStats = (Graphic3d_RenderingParams::PerfCounters)(
+    Graphic3d_RenderingParams::PerfCounters_FrameRate | Graphic3d_RenderingParams::PerfCounters_Triangles);
+
+  // other items of the group request redraw from rendering thread
+  mySharedViewer->AddView(myView, myViewCube, [this]() { QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater)); });
+}
+
+// ================================================================
+// Function : releaseView
+// ================================================================
+void OcctQQuickFramebufferViewer::releaseView()
+{
+  myFrameCapture.Release(OcctGlTools::GetGlContext(myView));
+  myResolutionScaler.Release(myView);
+  mySharedViewer->RemoveView(myView);
+  if (!myViewerGroup.isEmpty()
+   && mySharedViewer->NbViews() == 0)
+  {
+    sharedViewerGroups().erase(myViewerGroup);
+  }
+  myContext.Nullify();
+  myView.Nullify();
+  myViewer.Nullify();
+  mySharedViewer.Nullify();
+}
+
+// ================================================================
+// Function : setViewerGroup
+// ================================================================
+void OcctQQuickFramebufferViewer::setViewerGroup(const QString& theGroup)
+{
+  if (myViewerGroup == theGroup)
+    return;
+
+  // one-time setup - rendering thread might be already alive
+  Standard_Mutex::Sentry aLock(myViewerMutex);
+  if (!myView->Window().IsNull())
+  {
+    Message::SendWarning() << "Warning: viewerGroup cannot be changed after the first frame";
+    return;
+  }
+
+  releaseView();
+  myViewerGroup = theGroup;
+  if (!myViewerGroup.isEmpty())
+  {
+    Handle(OcctSharedViewer)& aGroupViewer = sharedViewerGroups()[myViewerGroup];
+    if (aGroupViewer.IsNull())
+      aGroupViewer = createSharedViewer();
+
+    mySharedViewer = aGroupViewer;
+  }
+  else
+  {
+    mySharedViewer = createSharedViewer();
+  }
+  createView();
+  updateView();
+}
+
 // ================================================================
 // Function : event
 // ================================================================
@@ -122,7 +271,7 @@ bool OcctQQuickFramebufferViewer::event(QEvent* theEvent)
 
   if (theEvent->type() == QEvent::UpdateLater)
   {
-    update();
+    updateView();
     theEvent->accept();
     return true;
   }
@@ -133,7 +282,7 @@ bool OcctQQuickFramebufferViewer::event(QEvent* theEvent)
   {
     theEvent->accept();
     myHasTouchInput = true;
-    if (OcctQtTools::qtHandleTouchEvent(*this, myView, static_cast<QTouchEvent*>(theEvent)))
+    if (OcctQtTools::qtHandleTouchEvent(*this, window()->devicePixelRatio(), static_cast<QTouchEvent*>(theEvent), &myInputLatency, &myInputPredictor))
       updateView();
 
     return true;
@@ -160,11 +309,8 @@ void OcctQQuickFramebufferViewer::keyPressEvent(QKeyEvent* theEvent)
     }
     case Aspect_VKey_F:
     {
-      {
-        Standard_Mutex::Sentry aLock(myViewerMutex);
-        myView->FitAll(0.01, false);
-      }
-      update();
+      pushViewCommand([this]() { myView->FitAll(0.01, false); });
+      updateView();
       theEvent->accept();
       return;
     }
@@ -185,7 +331,7 @@ void OcctQQuickFramebufferViewer::mousePressEvent(QMouseEvent* theEvent)
     return; // skip mouse events emulated by system from screen touches
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
     updateView();
 }
 
@@ -199,7 +345,7 @@ void OcctQQuickFramebufferViewer::mouseReleaseEvent(QMouseEvent* theEvent)
     return;
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
     updateView();
 
   // take keyboard focus on mouse click
@@ -219,7 +365,7 @@ void OcctQQuickFramebufferViewer::mouseMoveEvent(QMouseEvent* theEvent)
     return; // skip mouse events emulated by system from screen touches
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
     updateView();
 }
 
@@ -233,7 +379,7 @@ void OcctQQuickFramebufferViewer::wheelEvent(QWheelEvent* theEvent)
     return;
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleWheelEvent(*this, myView, theEvent))
+  if (myInputAccum.AddWheelEvent(window()->devicePixelRatio(), theEvent))
     updateView();
 }
 
@@ -271,7 +417,7 @@ void OcctQQuickFramebufferViewer::hoverMoveEvent(QHoverEvent* theEvent)
     return;
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleHoverEvent(*this, myView, theEvent))
+  if (myInputAccum.AddHoverEvent(window()->devicePixelRatio(), theEvent))
     updateView();
 }
 
@@ -280,7 +426,284 @@ void OcctQQuickFramebufferViewer::hoverMoveEvent(QHoverEvent* theEvent)
 // =======================================================================
 void OcctQQuickFramebufferViewer::updateView()
 {
-  update();
+  myFrameScheduler.RequestFrame();
+}
+
+// =======================================================================
+// Function : pushViewCommand
+// =======================================================================
+void OcctQQuickFramebufferViewer::pushViewCommand(const OcctViewCommandQueue::Command& theCommand)
+{
+  if (myIsBlockingHandoff)
+  {
+    // legacy behavior - wait for rendering thread to finish the frame
+    myGuiLockWait.Lock(myViewerMutex);
+    theCommand();
+    myViewerMutex.Unlock();
+    return;
+  }
+
+  myViewCommands.Push(theCommand);
+}
+
+// ================================================================
+// Function : setBackgroundColor
+// ================================================================
+void OcctQQuickFramebufferViewer::setBackgroundColor(const QColor& theColor)
+{
+  myBackColor = theColor;
+  const Quantity_Color aColor = OcctQtTools::qtColorToOcct(theColor);
+  pushViewCommand([this, aColor]()
+  {
+    myView->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
+    myView->Invalidate();
+  });
+  updateView();
+}
+
+// ================================================================
+// Function : captureToFile
+// ================================================================
+void OcctQQuickFramebufferViewer::captureToFile(const QUrl& theUrl)
+{
+  const QString aFilePath = theUrl.isLocalFile() ? theUrl.toLocalFile() : theUrl.toString();
+  myFrameCapture.RequestFile(aFilePath, [this](const QString& theFilePath, bool theIsSaved)
+  {
+    // called from encoder thread
+    QMetaObject::invokeMethod(this, "frameCaptured", Qt::QueuedConnection,
+                              Q_ARG(QString, theFilePath), Q_ARG(bool, theIsSaved));
+  });
+}
+
+// ================================================================
+// Function : pickAt
+// ================================================================
+int OcctQQuickFramebufferViewer::pickAt(qreal theX, qreal theY)
+{
+  return pickRect(theX, theY, theX, theY);
+}
+
+// ================================================================
+// Function : pickRect
+// ================================================================
+int OcctQQuickFramebufferViewer::pickRect(qreal theX1, qreal theY1, qreal theX2, qreal theY2)
+{
+  const double aDevPixelRatio = window() != nullptr ? window()->devicePixelRatio() : 1.0;
+  const Graphic3d_Vec2i aPnt1(Graphic3d_Vec2d(theX1, theY1) * aDevPixelRatio);
+  const Graphic3d_Vec2i aPnt2(Graphic3d_Vec2d(theX2, theY2) * aDevPixelRatio);
+  const OcctAsyncPicker::Callback aCallback = [this](const OcctAsyncPicker::Result& theResult)
+  {
+    // called from rendering thread
+    QVariantList aResults;
+    for (size_t anOwnerIter = 0; anOwnerIter < theResult.Owners.size(); ++anOwnerIter)
+    {
+      const Handle(SelectMgr_EntityOwner)& anOwner = theResult.Owners[anOwnerIter];
+      const gp_Pnt& aPnt = theResult.Points[anOwnerIter];
+      QVariantMap anItem;
+      anItem["depth"] = theResult.Depths[anOwnerIter];
+      anItem["point"] = QVector3D(float(aPnt.X()), float(aPnt.Y()), float(aPnt.Z()));
+      if (anOwner->Selectable() != nullptr)
+        anItem["object"] = QString(anOwner->Selectable()->DynamicType()->Name());
+
+      Handle(StdSelect_BRepOwner) aBRepOwner = Handle(StdSelect_BRepOwner)::DownCast(anOwner);
+      if (!aBRepOwner.IsNull() && aBRepOwner->HasShape())
+        anItem["shapeType"] = QString(TopAbs::ShapeTypeToString(aBRepOwner->Shape().ShapeType()));
+
+      aResults.append(anItem);
+    }
+    QMetaObject::invokeMethod(this, "picked", Qt::QueuedConnection,
+                              Q_ARG(int, theResult.RequestId), Q_ARG(QVariantList, aResults));
+  };
+  return aPnt1 == aPnt2
+       ? mySharedViewer->Picker().PickPoint(myView, aPnt1, aCallback)
+       : mySharedViewer->Picker().PickRect(myView, aPnt1, aPnt2, aCallback);
+}
+
+// ================================================================
+// Function : startRecording
+// ================================================================
+bool OcctQQuickFramebufferViewer::startRecording(const QUrl& theUrl, int theFps)
+{
+  OcctQtFrameRecorder::Params aParams;
+  aParams.FilePath = theUrl.isLocalFile() ? theUrl.toLocalFile() : theUrl.toString();
+  aParams.Fps      = theFps;
+  myFrameCapture.SetFrameListener(OcctQtFrameCapture::FrameCallback());
+  if (!myFrameRecorder.Start(aParams))
+    return false;
+
+  myFrameCapture.SetFrameListener([this](const uint8_t* theData, int theSizeX, int theSizeY, int theRowBytes, double theTime)
+  {
+    // called from rendering thread
+    myFrameRecorder.PushFrame(theData, theSizeX, theSizeY, theRowBytes, theTime);
+  }, 1.0 / double(theFps));
+  return true;
+}
+
+// ================================================================
+// Function : stopRecording
+// ================================================================
+void OcctQQuickFramebufferViewer::stopRecording()
+{
+  myFrameCapture.SetFrameListener(OcctQtFrameCapture::FrameCallback());
+  myFrameRecorder.Stop();
+}
+
+// ================================================================
+// Function : recordingStats
+// ================================================================
+QVariantMap OcctQQuickFramebufferViewer::recordingStats() const
+{
+  const OcctQtFrameRecorder::Stats aStats = myFrameRecorder.Statistics();
+  QVariantMap aMap;
+  aMap["recording"]     = myFrameRecorder.IsRecording();
+  aMap["pushed"]        = qulonglong(aStats.NbPushed);
+  aMap["encoded"]       = qulonglong(aStats.NbEncoded);
+  aMap["dropped"]       = qulonglong(aStats.NbDropped + aStats.NbMismatched);
+  aMap["decimated"]     = qulonglong(aStats.NbDecimated);
+  aMap["duplicated"]    = qulonglong(aStats.NbDuplicated);
+  aMap["failed"]        = qulonglong(aStats.NbFailed);
+  aMap["queueDepth"]    = aStats.QueueDepth;
+  aMap["maxQueueDepth"] = aStats.MaxQueueDepth;
+  aMap["encodeTime"]    = aStats.EncodeTime * 1000.0;
+  aMap["error"]         = myFrameRecorder.LastError();
+  return aMap;
+}
+
+// ================================================================
+// Function : openModel
+// ================================================================
+void OcctQQuickFramebufferViewer::openModel(const QUrl& theUrl)
+{
+  const QString aFilePath = theUrl.isLocalFile() ? theUrl.toLocalFile() : theUrl.toString();
+  myModelLoader.Cancel();
+  pushViewCommand([this]()
+  {
+    mySharedViewer->RemoveModel();
+  });
+  myLoadingProgress = 0.0;
+  myLoadingStatus.clear();
+  myModelLoader.Load(aFilePath);
+  emit loadingChanged();
+  updateView();
+}
+
+// ================================================================
+// Function : getInputLatency
+// ================================================================
+QVariantMap OcctQQuickFramebufferViewer::getInputLatency() const
+{
+  return OcctQtTools::qtInputLatencyMap(myInputLatency);
+}
+
+// ================================================================
+// Function : getFrameTimings
+// ================================================================
+QVariantMap OcctQQuickFramebufferViewer::getFrameTimings() const
+{
+  OcctFrameTimings::Record aRecord;
+  return myFrameTimings.LastRecord(aRecord) ? frameTimingsMap(aRecord) : QVariantMap();
+}
+
+// ================================================================
+// Function : frameTimingsHistory
+// ================================================================
+QVariantList OcctQQuickFramebufferViewer::frameTimingsHistory(int theNbFrames) const
+{
+  QVariantList aList;
+  for (const OcctFrameTimings::Record& aRecIter : myFrameTimings.Records(size_t(qMax(theNbFrames, 0))))
+    aList.append(frameTimingsMap(aRecIter));
+
+  return aList;
+}
+
+// ================================================================
+// Function : contextLazyMoveTo
+// ================================================================
+void OcctQQuickFramebufferViewer::contextLazyMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                                                    const Handle(V3d_View)& theView,
+                                                    const Graphic3d_Vec2i& thePnt)
+{
+  // selection structures are shared with asynchronous picking - postpone hover detection instead of waiting;
+  // click selects detected owner right after this call, so that its detection cannot be postponed or skipped
+  const bool isClickPending = myGL.Selection.Tool == AIS_ViewSelectionTool_Picking
+                          && !myGL.Selection.Points.IsEmpty();
+  std::unique_lock<std::mutex> aSelLock(mySharedViewer->Picker().SelectionMutex(), std::defer_lock);
+  if (isClickPending)
+  {
+    aSelLock.lock();
+  }
+  else if (!aSelLock.try_lock())
+  {
+    myHoverThrottle.Postpone(thePnt);
+    return;
+  }
+
+  if (!myHoverThrottle.ToDetect(thePnt, theView, mySharedViewer->SceneRevision(), isClickPending))
+    return;
+
+  // base implementation skips the same point, while detection is also needed on camera change
+  myPrevMoveTo.SetValues(-1, -1);
+  AIS_ViewController::contextLazyMoveTo(theCtx, theView, thePnt);
+}
+
+// ================================================================
+// Function : handleSelectionPoly
+// ================================================================
+void OcctQQuickFramebufferViewer::handleSelectionPoly(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)
+{
+  if (!myGL.Selection.ToApplyTool)
+  {
+    AIS_ViewController::handleSelectionPoly(theCtx, theView);
+    return;
+  }
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (myGL.Selection.Tool == AIS_ViewSelectionTool_RubberBand
+   && myGL.Selection.Points.Size() == 2)
+  {
+    // heavy rectangle traversal is performed by working thread and applied once it is done;
+    // base implementation only removes rubber band without points
+    const Graphic3d_Vec2i aPnt1 = myGL.Selection.Points.First();
+    const Graphic3d_Vec2i aPnt2 = myGL.Selection.Points.Last();
+    const AIS_SelectionScheme aScheme = myGL.Selection.Scheme;
+    myGL.Selection.Points.Clear();
+    AIS_ViewController::handleSelectionPoly(theCtx, theView);
+    mySharedViewer->Picker().PickRect(myView, aPnt1, aPnt2, [this, aScheme](const OcctAsyncPicker::Result& theResult)
+    {
+      OcctAsyncPicker::ApplySelection(myContext, theResult, aScheme);
+      myView->Invalidate();
+      mySharedViewer->InvalidateViews(myView);
+    });
+    return;
+  }
+#endif
+
+  // other tools traverse the main selector within this thread
+  std::lock_guard<std::mutex> aSelLock(mySharedViewer->Picker().SelectionMutex());
+  AIS_ViewController::handleSelectionPoly(theCtx, theView);
+}
+
+// ================================================================
+// Function : PickPoint
+// ================================================================
+bool OcctQQuickFramebufferViewer::PickPoint(gp_Pnt& thePnt,
+                                            const Handle(AIS_InteractiveContext)& theCtx,
+                                            const Handle(V3d_View)& theView,
+                                            const Graphic3d_Vec2i& theCursor,
+                                            bool theToStickToPickRay)
+{
+  std::lock_guard<std::mutex> aSelLock(mySharedViewer->Picker().SelectionMutex());
+  return AIS_ViewController::PickPoint(thePnt, theCtx, theView, theCursor, theToStickToPickRay);
+}
+
+// ================================================================
+// Function : OnSelectionChanged
+// ================================================================
+void OcctQQuickFramebufferViewer::OnSelectionChanged(const Handle(AIS_InteractiveContext)& ,
+                                                     const Handle(V3d_View)& )
+{
+  // selection is highlighted within all items of viewer group
+  mySharedViewer->InvalidateViews(myView);
 }
 
 // ================================================================
@@ -289,9 +712,40 @@ void OcctQQuickFramebufferViewer::updateView()
 void OcctQQuickFramebufferViewer::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
                                                    const Handle(V3d_View)&               theView)
 {
+  // animate camera for expected presentation time of this frame
+  myFrameScheduler.SyncAnimationTimer(myViewAnimation, myNextPresentTime);
+
+  // degrade quality while camera moves; viewer-level settings are kept for views of shared viewer
+  myInteractionLod.SetViewerShared(mySharedViewer->NbViews() > 1);
+  const bool wasDegraded = myInteractionLod.IsDegraded();
+  double aRedrawDelay = myInteractionLod.Update(*this, theCtx, theView);
+  if (myInteractionLod.IsDegraded() != wasDegraded)
+    mySharedViewer->InvalidateScene(); // display modes might have been switched
+
+  // deliver asynchronous picking results and dispatch the next pick
+  mySharedViewer->Picker().Perform(theCtx, theView);
+
+  // perform dynamic highlighting postponed by rate cap or invalidated by scene modification
+  myHoverThrottle.CheckSceneRevision(mySharedViewer->SceneRevision());
+  const double aHoverDelay = myHoverThrottle.PendingDelay();
+  if (aHoverDelay == 0.0)
+    contextLazyMoveTo(theCtx, theView, myHoverThrottle.PendingPoint());
+  else if (aHoverDelay > 0.0)
+    aRedrawDelay = aRedrawDelay >= 0.0 ? std::min(aRedrawDelay, aHoverDelay) : aHoverDelay;
+
+  // reduce resolution during interaction to hold frame time budget
+  const double aScaleDelay = myResolutionScaler.Update(theView);
+  if (aScaleDelay >= 0.0)
+    aRedrawDelay = aRedrawDelay >= 0.0 ? std::min(aRedrawDelay, aScaleDelay) : aScaleDelay;
+  myResolutionScaler.BeginFrame(theView);
   AIS_ViewController::handleViewRedraw(theCtx, theView);
+  myResolutionScaler.EndFrame(theView);
   if (myToAskNextFrame)
     QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater)); // ask more frames for animation
+
+  // timer belongs to GUI thread - start it through queued call
+  if (aRedrawDelay >= 0.0)
+    QMetaObject::invokeMethod(&myLodTimer, "start", Qt::QueuedConnection, Q_ARG(int, int(aRedrawDelay * 1000.0) + 1));
 }
 
 // =======================================================================
@@ -363,28 +817,29 @@ void OcctQQuickFramebufferViewer::Renderer::render()
 // ================================================================
 // Function : dumpGlInfo
 // ================================================================
-void OcctQQuickFramebufferViewer::dumpGlInfo(bool theIsBasic, bool theToPrint)
+void OcctQQuickFramebufferViewer::dumpGlInfo()
 {
-  TColStd_IndexedDataMapOfStringString aGlCapsDict;
-  myView->DiagnosticInformation(aGlCapsDict,
-                                theIsBasic ? Graphic3d_DiagnosticInfo_Basic : Graphic3d_DiagnosticInfo_Complete);
-  TCollection_AsciiString anInfo;
-  for (TColStd_IndexedDataMapOfStringString::Iterator aValueIter(aGlCapsDict); aValueIter.More(); aValueIter.Next())
-  {
-    if (!aValueIter.Value().IsEmpty())
-    {
-      if (!anInfo.IsEmpty())
-        anInfo += "\n";
+  // basic info is fetched once per OpenGL context, while complete one - on demand
+  myGlInfo.Invalidate();
+  myGlInfo.UpdateBasic(myView);
+  myGlInfo.UpdateSize(myView);
+  Message::SendInfo(myGlInfo.Text());
+  Q_EMIT glInfoChanged();
+}
 
-      anInfo += aValueIter.Key() + ": " + aValueIter.Value();
-    }
+// ================================================================
+// Function : getGlInfo
+// ================================================================
+QString OcctQQuickFramebufferViewer::getGlInfo()
+{
+  if (!myGlInfo.HasComplete() && myGlInfo.HasBasic())
+  {
+    // extensions list is queried within rendering thread only when info is actually requested;
+    // glInfoChanged() will be emitted once it is fetched
+    myToFetchGlInfo = true;
+    updateView();
   }
-
-  if (theToPrint)
-    Message::SendInfo(anInfo);
-
-  myGlInfo = QString::fromUtf8(anInfo.ToCString());
-  Q_EMIT glInfoChanged();
+  return QString::fromUtf8(myGlInfo.Text().ToCString());
 }
 
 // ================================================================
@@ -394,13 +849,19 @@ void OcctQQuickFramebufferViewer::synchronize(QOpenGLFramebufferObject* )
 {
   // this method will be called from GL rendering thread while GUI thread is locked,
   // the place to synchronize GUI / GL rendering states
-  if (myGlBackColor.first)
+  myFrameScheduler.FrameStarted();
+  myNextPresentTime = myFrameScheduler.NextPresentationTime();
+  if (!myView.IsNull())
   {
-    myGlBackColor.first = false;
-    const Quantity_Color aColor = OcctQtTools::qtColorToOcct(myGlBackColor.second);
-    myView->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
-    myView->Invalidate();
+    myInputAccum.Flush(*this); // pass input events accumulated by GUI thread to AIS_ViewController
+    if (myInputPredictor.Apply(*this, myNextPresentTime - myFrameScheduler.CurrentTime()))
+      QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater)); // settle extrapolated pointer by the next frame
   }
+
+  // take commands written by GUI thread, to be executed within render();
+  // commands might display or remove objects
+  if (myViewCommands.Swap())
+    mySharedViewer->InvalidateScene();
 }
 
 // ================================================================
@@ -429,13 +890,18 @@ void OcctQQuickFramebufferViewer::initializeGL(QOpenGLFramebufferObject* theFbo)
   }
 
   theFbo->bind(); // rebind offscreen FBO
-  dumpGlInfo(true, true);
+  myResolutionScaler.SetDevicePixelRatio(aQWindow->devicePixelRatio());
+  dumpGlInfo();
+  myFrameCapture.InvalidateGl();
   if (isFirstInit)
   {
-    myContext->Display(myViewCube, 0, 0, false);
+    mySharedViewer->DisplayViewCube(myView);
+    if (!mySharedViewer->ToDisplaySampleModel())
+      return;
 
     // dummy shape for testing
     TopoDS_Shape      aBox   = BRepPrimAPI_MakeBox(100.0, 50.0, 90.0).Shape();
+    OcctTessellator().MeshPart(aBox);
     Handle(AIS_Shape) aShape = new AIS_Shape(aBox);
     myContext->Display(aShape, AIS_Shaded, 0, false);
   }
@@ -453,6 +919,7 @@ void OcctQQuickFramebufferViewer::render(QOpenGLFramebufferObject* theFbo)
   if (theFbo == nullptr || myView.IsNull() || aQWindow == nullptr)
     return;
 
+  OcctFrameTimings::FrameSentry aFrameSentry(myFrameTimings);
   const Aspect_Drawable aNativeWin = OcctGlTools::GetGlNativeWindow((Aspect_Drawable)aQWindow->winId());
   if (myView->Window().IsNull()
    || myView->Window()->NativeHandle() != aNativeWin)
@@ -467,27 +934,69 @@ void OcctQQuickFramebufferViewer::render(QOpenGLFramebufferObject* theFbo)
   if (aDevPixelRatioOld != aQWindow->devicePixelRatio())
     initializeGL(theFbo);
 
-  // wrap FBO created by QOpenGLFramebufferObject
-  if (!OcctGlTools::InitializeGlFbo(myView))
+  // execute commands passed from GUI thread
+  myViewCommands.Execute();
+
+  // display parts loaded in background within a few milliseconds per frame
+  const size_t aNbDisplayedOld = myModelLoader.NbDisplayed();
+  if (myModelLoader.DisplayLoadedParts(myContext, myView, 0.005))
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
+  if (myModelLoader.NbDisplayed() != aNbDisplayedOld)
+    mySharedViewer->InvalidateViews(myView);
+
+  // wrap FBO created by QOpenGLFramebufferObject (skipped when Qt FBO is unchanged)
+  bool isFboWrapped = false;
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_InitFbo);
+    isFboWrapped = OcctGlTools::InitializeGlFbo(myView, theFbo->handle(), Graphic3d_Vec2i(theFbo->width(), theFbo->height()),
+                                                int(theFbo->format().internalTextureFormat()));
+  }
+  if (!isFboWrapped)
   {
     Q_EMIT glCriticalError("Default FBO wrapper creation failed");
     return;
   }
 
   Graphic3d_Vec2i aViewSizeNew; myView->Window()->Size(aViewSizeNew.x(), aViewSizeNew.y());
-  if (aViewSizeNew != aViewSizeOld || myView->Window()->DevicePixelRatio() != aDevPixelRatioOld)
-    dumpGlInfo(true, false);
+  if ((aViewSizeNew != aViewSizeOld || myView->Window()->DevicePixelRatio() != aDevPixelRatioOld)
+   && myGlInfo.UpdateSize(myView)) // cheap, without GL queries
+  {
+    Q_EMIT glInfoChanged();
+  }
+  if (myToFetchGlInfo.exchange(false)
+   && myGlInfo.UpdateComplete(myView))
+  {
+    Q_EMIT glInfoChanged();
+  }
 
   // reset global GL state from Qt before redrawing OCCT
-  OcctGlTools::ResetGlStateBeforeOcct(myView);
+  // (Qt Quick scene graph renders into the same OpenGL context)
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_ResetGlBefore);
+    OcctGlTools::InvalidateGlState(myView);
+    OcctGlTools::ResetGlStateBeforeOcct(myView);
+  }
 
   // flush pending input events and redraw the viewer
-  myView->InvalidateImmediate();
-  AIS_ViewController::FlushViewEvents(myContext, myView, true);
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_FlushView);
+    myView->InvalidateImmediate();
+    AIS_ViewController::FlushViewEvents(myContext, myView, true);
+
+    // read back the frame for capture requests (asynchronously through PBO ring)
+    myFrameCapture.Perform(myView);
+  }
 
   // reset global GL state after OCCT before redrawing Qt
   // (alternative to QQuickOpenGLUtils::resetOpenGLState())
-  OcctGlTools::ResetGlStateAfterOcct(myView);
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_ResetGlAfter);
+    OcctGlTools::ResetGlStateAfterOcct(myView);
+  }
+
+  // keep rendering frames till captured frames are delivered
+  if (myFrameCapture.HasPending())
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
 /*#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
   QQuickOpenGLUtils::resetOpenGLState()
 #else
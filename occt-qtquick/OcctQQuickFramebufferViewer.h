@@ -3,10 +3,30 @@
 #ifndef _OcctQQuickFramebufferViewer_HeaderFile
 #define _OcctQQuickFramebufferViewer_HeaderFile
 
+#include "../occt-qt-tools/OcctAsyncPicker.h"
+#include "../occt-qt-tools/OcctFrameTimings.h"
+#include "../occt-qt-tools/OcctGlInfo.h"
+#include "../occt-qt-tools/OcctHoverThrottle.h"
+#include "../occt-qt-tools/OcctInputLatency.h"
+#include "../occt-qt-tools/OcctInputPredictor.h"
+#include "../occt-qt-tools/OcctInteractionLod.h"
+#include "../occt-qt-tools/OcctQtFrameCapture.h"
+#include "../occt-qt-tools/OcctQtFrameRecorder.h"
+#include "../occt-qt-tools/OcctQtFrameScheduler.h"
+#include "../occt-qt-tools/OcctQtInputAccumulator.h"
+#include "../occt-qt-tools/OcctQtModelLoader.h"
+#include "../occt-qt-tools/OcctResolutionScaler.h"
+#include "../occt-qt-tools/OcctSharedViewer.h"
 #include "../occt-qt-tools/OcctQtTools.h"
+#include "../occt-qt-tools/OcctViewCommandQueue.h"
 
 #include <Standard_WarningsDisable.hxx>
+#include <QMetaObject>
 #include <QQuickFramebufferObject>
+#include <QTimer>
+#include <QUrl>
+#include <QVariantList>
+#include <QVariantMap>
 #include <Standard_WarningsRestore.hxx>
 
 #include <AIS_InteractiveContext.hxx>
@@ -14,6 +34,9 @@
 #include <V3d_View.hxx>
 #include <Standard_Version.hxx>
 
+#include <atomic>
+#include <vector>
+
 class AIS_ViewCube;
 
 //! OpenGL QtQuick framebuffer control holding OCCT 3D View.
@@ -31,6 +54,12 @@ class OcctQQuickFramebufferViewer : public QQuickFramebufferObject, public AIS_V
   // QML properties
   Q_PROPERTY(QColor  backgroundColor READ getBackgroundColor WRITE setBackgroundColor)
   Q_PROPERTY(QString glInfo READ getGlInfo NOTIFY glInfoChanged)
+  Q_PROPERTY(bool    loading READ isLoading NOTIFY loadingChanged)
+  Q_PROPERTY(double  loadingProgress READ getLoadingProgress NOTIFY loadingChanged)
+  Q_PROPERTY(QString loadingStatus READ getLoadingStatus NOTIFY loadingChanged)
+  Q_PROPERTY(QVariantMap frameTimings READ getFrameTimings NOTIFY frameTimingsChanged)
+  Q_PROPERTY(QVariantMap inputLatency READ getInputLatency NOTIFY frameTimingsChanged)
+  Q_PROPERTY(QString viewerGroup READ getViewerGroup WRITE setViewerGroup)
 public:
   //! Main constructor.
   OcctQQuickFramebufferViewer(QQuickItem* theParent = nullptr);
@@ -47,22 +76,125 @@ public:
   //! Return AIS context.
   const Handle(AIS_InteractiveContext)& Context() const { return myContext; }
 
+  //! Return viewer shared with other items of the same viewer group.
+  const Handle(OcctSharedViewer)& SharedViewer() const { return mySharedViewer; }
+
 public: // QML accessors
-  //! Return OpenGL info.
-  const QString& getGlInfo() const { return myGlInfo; }
+  //! Return OpenGL info; complete info (including extensions) is fetched on first request.
+  QString getGlInfo();
 
   //! Return background color.
-  QColor getBackgroundColor() { return myGlBackColor.first; }
-
+  QColor getBackgroundColor() const { return myBackColor; }
+
   //! Set background color.
-  void setBackgroundColor(const QColor& theColor)
-  {
-    myGlBackColor = std::make_pair(true, theColor);
-    update();
-  }
+  void setBackgroundColor(const QColor& theColor);
+
+  //! Return name of the group of items sharing one viewer; empty by default (own viewer).
+  const QString& getViewerGroup() const { return myViewerGroup; }
+
+  //! Set name of the group of items sharing one viewer and interactive context (same model shown by several items).
+  //! Should be set before the first frame; items of one group should belong to the same window (same rendering thread).
+  //! Legacy blocking handoff should not be used by shared items.
+  void setViewerGroup(const QString& theGroup);
+
+  //! Return TRUE if model is being loaded.
+  bool isLoading() const { return myModelLoader.IsLoading(); }
+
+  //! Return model loading progress in percents.
+  double getLoadingProgress() const { return myLoadingProgress; }
+
+  //! Return model loading status message.
+  const QString& getLoadingStatus() const { return myLoadingStatus; }
+
+  //! Start asynchronous loading of STEP/BREP file replacing displayed shapes;
+  //! parts are displayed progressively as soon as they are meshed.
+  Q_INVOKABLE void openModel(const QUrl& theUrl);
+
+  //! Cancel model loading.
+  Q_INVOKABLE void cancelLoading() { myModelLoader.Cancel(); }
+
+  //! Capture the next frame into image file asynchronously; frameCaptured() is emitted once the file is written.
+  Q_INVOKABLE void captureToFile(const QUrl& theUrl);
+
+  //! Pick objects under the point (in item coordinates) asynchronously;
+  //! picked() is emitted with returned request identifier once traversal is done.
+  Q_INVOKABLE int pickAt(qreal theX, qreal theY);
+
+  //! Pick objects within rectangle (in item coordinates) asynchronously;
+  //! picked() is emitted with returned request identifier once traversal is done.
+  Q_INVOKABLE int pickRect(qreal theX1, qreal theY1, qreal theX2, qreal theY2);
+
+  //! Start recording of rendered frames into video file (.y4m, .png sequence or FFmpeg-supported container).
+  Q_INVOKABLE bool startRecording(const QUrl& theUrl, int theFps = 30);
+
+  //! Stop video recording, waiting for queued frames to be encoded.
+  Q_INVOKABLE void stopRecording();
+
+  //! Return video recording statistics (pushed, encoded, dropped, decimated and duplicated frames, queue depth, encoding time in milliseconds).
+  Q_INVOKABLE QVariantMap recordingStats() const;
+
+  //! Return timings of the last presented frame as map of phase names to milliseconds
+  //! (including "frame" index and "total" time).
+  QVariantMap getFrameTimings() const;
+
+  //! Return input-to-photon latency of mouse events as map of "p50", "p95", "p99", "max" milliseconds
+  //! and number of "samples".
+  QVariantMap getInputLatency() const;
+
+  //! Return timings of the most recent frames from oldest to newest (same format as frameTimings property).
+  Q_INVOKABLE QVariantList frameTimingsHistory(int theNbFrames) const;
+
+  //! Return model loader.
+  OcctQtModelLoader& ModelLoader() { return myModelLoader; }
+
+  //! Return interaction level-of-detail controller (should be modified only from rendering thread).
+  OcctInteractionLod& InteractionLod() { return myInteractionLod; }
+
+  //! Return dynamic highlighting throttle (should be modified only from rendering thread).
+  OcctHoverThrottle& HoverThrottle() { return myHoverThrottle; }
+
+  //! Return dynamic resolution controller.
+  OcctResolutionScaler& ResolutionScaler() { return myResolutionScaler; }
+
+  //! Return per-phase frame timings.
+  const OcctFrameTimings& FrameTimings() const { return myFrameTimings; }
+
+  //! Return input-to-photon latency histogram.
+  OcctInputLatency& InputLatency() { return myInputLatency; }
+
+  //! Return predictor extrapolating dragged pointers to expected presentation time.
+  OcctInputPredictor& InputPredictor() { return myInputPredictor; }
+
+  //! Return asynchronous frame capture; requests should be pushed from GUI thread,
+  //! while callbacks are called from rendering thread.
+  OcctQtFrameCapture& FrameCapture() { return myFrameCapture; }
+
+  //! Return asynchronous picker; callbacks are called from rendering thread.
+  OcctAsyncPicker& Picker() { return mySharedViewer->Picker(); }
+
+  //! Return video recorder.
+  const OcctQtFrameRecorder& FrameRecorder() const { return myFrameRecorder; }
+
+public: // GUI / rendering thread handoff
+  //! Return TRUE if GUI thread executes view commands immediately
+  //! while locking the viewer (legacy behavior, for comparison); FALSE by default.
+  bool IsBlockingHandoff() const { return myIsBlockingHandoff; }
+
+  //! Set if GUI thread should execute view commands immediately while locking the viewer.
+  void SetBlockingHandoff(bool theIsBlocking) { myIsBlockingHandoff = theIsBlocking; }
+
+  //! Return lock-wait counters of GUI thread.
+  const OcctLockWaitStats& GuiLockWaitStats() const
+  {
+    return myIsBlockingHandoff ? myGuiLockWait : myViewCommands.PushWaitStats();
+  }
 
 signals:
-  void glInfoChanged();
+  void glInfoChanged();
+  void loadingChanged();
+  void frameTimingsChanged();
+  void frameCaptured(QString theFilePath, bool theIsSaved);
+  void picked(int theRequestId, QVariantList theResults);
   void glCriticalError(QString theMsg);
 
 protected:
@@ -101,27 +233,81 @@ protected: // user input events
   //virtual void touchEvent(QTouchEvent* theEvent) override;
 
 private:
-  //! Dump OpenGL info.
-  void dumpGlInfo(bool theIsBasic, bool theToPrint);
+  //! Fetch and print basic OpenGL info of new OpenGL context.
+  void dumpGlInfo();
 
-  //! Request 3D viewer redrawing from GUI thread.
+  //! Request 3D viewer redrawing from GUI thread through frame scheduler.
   void updateView();
 
+  //! Create a new view of shared viewer.
+  void createView();
+
+  //! Remove the view from shared viewer; viewer group is released with the last view.
+  void releaseView();
+
+  //! Pass command to rendering thread (called from GUI thread).
+  //! The command will be executed within the next frame, so that GUI thread never waits for a frame in progress.
+  void pushViewCommand(const OcctViewCommandQueue::Command& theCommand);
+
   //! Handle view redraw.
   virtual void handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
 
+  //! Perform dynamic highlighting unless skipped or postponed by hover throttle.
+  virtual void contextLazyMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theView,
+                                 const Graphic3d_Vec2i& thePnt) override;
+
+  //! Handle selection tools; rubber-band selection is picked asynchronously.
+  virtual void handleSelectionPoly(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
+
+  //! Pick point for zooming at cursor or rotation around picked point,
+  //! traversing the main selector under the same lock as asynchronous picking.
+  virtual bool PickPoint(gp_Pnt& thePnt,
+                         const Handle(AIS_InteractiveContext)& theCtx,
+                         const Handle(V3d_View)& theView,
+                         const Graphic3d_Vec2i& theCursor,
+                         bool theToStickToPickRay) override;
+
+  //! Propagate selection change to other items of viewer group.
+  virtual void OnSelectionChanged(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView) override;
+
 private:
+  Handle(OcctSharedViewer)       mySharedViewer;
+  QString                        myViewerGroup;
   Handle(V3d_Viewer)             myViewer;
   Handle(V3d_View)               myView;
   Handle(AIS_InteractiveContext) myContext;
   Handle(AIS_ViewCube)           myViewCube;
 
-  Standard_Mutex myViewerMutex;
+  Standard_Mutex       myViewerMutex;  //!< lock for rendering thread (and legacy blocking handoff)
+  OcctViewCommandQueue myViewCommands; //!< commands passed from GUI thread to rendering thread
+  OcctLockWaitStats    myGuiLockWait;  //!< GUI thread waits for myViewerMutex in blocking handoff mode
+  bool                 myIsBlockingHandoff = false;
+
+  OcctQtInputAccumulator myInputAccum;
+  OcctQtFrameScheduler   myFrameScheduler;
+  double                 myNextPresentTime = 0.0; //!< expected presentation time of the frame being rendered
+  OcctInteractionLod     myInteractionLod;
+  OcctHoverThrottle      myHoverThrottle;
+  OcctResolutionScaler   myResolutionScaler;
+  OcctFrameTimings       myFrameTimings;
+  OcctInputLatency       myInputLatency;
+  OcctInputPredictor     myInputPredictor;
+  OcctQtFrameRecorder    myFrameRecorder; //!< video recorder fed by frame capture (should outlive it)
+  OcctQtFrameCapture     myFrameCapture;
+  QTimer                 myLodTimer; //!< timer redrawing the view to restore full quality or to perform postponed highlighting (GUI thread)
+  std::vector<QMetaObject::Connection> myConnections; //!< connections to signals of the window
+
+  QColor myBackColor = QColor(0, 0, 0);
 
-  std::pair<bool, QColor> myGlBackColor = std::make_pair(false, QColor(0, 0, 0));
+  OcctQtModelLoader myModelLoader;
+  double            myLoadingProgress = 0.0;
+  QString           myLoadingStatus;
 
-  QString myGlInfo;
-  bool    myHasTouchInput = false;
+  OcctGlInfo        myGlInfo;
+  std::atomic<bool> myToFetchGlInfo { false }; //!< complete OpenGL info has been requested by GUI thread
+  bool              myHasTouchInput = false;
 };
 
 #endif // _OcctQQuickFramebufferViewer_HeaderFile
@@ -0,0 +1,739 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifdef _WIN32
+  // should be included before other headers to avoid missing definitions
+  #include <windows.h>
+#endif
+#include <OpenGl_Context.hxx>
+
+#include "OcctQQuickTextureViewer.h"
+
+#include "../occt-qt-tools/OcctGlTools.h"
+#include "../occt-qt-tools/OcctTessellator.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QApplication>
+#include <QMessageBox>
+#include <QMouseEvent>
+#include <QOpenGLContext>
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+#if (QT_VERSION_MAJOR >= 6)
+  #include <QSGRendererInterface>
+  #include <QtQuick/qsgtexture_platform.h>
+#endif
+#include <Standard_WarningsRestore.hxx>
+
+#include <AIS_Shape.hxx>
+#include <AIS_ViewCube.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Message.hxx>
+#include <OpenGl_GraphicDriver.hxx>
+
+#include <map>
+
+#if !defined(__APPLE__) && !defined(_WIN32) && defined(__has_include)
+  #if __has_include(<Xw_DisplayConnection.hxx>)
+    #include <Xw_DisplayConnection.hxx>
+    #define USE_XW_DISPLAY
+  #endif
+#endif
+#ifndef USE_XW_DISPLAY
+typedef Aspect_DisplayConnection Xw_DisplayConnection;
+#endif
+
+namespace
+{
+  //! Convert frame timings into QML map of phase names to milliseconds.
+  static QVariantMap frameTimingsMap(const OcctFrameTimings::Record& theRecord)
+  {
+    QVariantMap aMap;
+    aMap["frame"] = QVariant::fromValue<qulonglong>(theRecord.FrameIndex);
+    aMap["total"] = theRecord.TotalTime * 1000.0;
+    for (int aPhaseIter = 0; aPhaseIter < OcctFramePhase_NB; ++aPhaseIter)
+      aMap[OcctFrameTimings::PhaseName((OcctFramePhase)aPhaseIter)] = theRecord.Phases[aPhaseIter] * 1000.0;
+
+    return aMap;
+  }
+
+  //! Scene graph node showing textures of OcctGlTextureRing.
+  //! Texture wrappers are cached per GL texture and released on resize.
+  class OcctQQuickTextureNode : public QSGSimpleTextureNode
+  {
+  public:
+    //! Main constructor.
+    OcctQQuickTextureNode()
+    {
+      // OpenGL texture is stored bottom-up
+      setTextureCoordinatesTransform(QSGSimpleTextureNode::MirrorVertically);
+    }
+
+    //! Destructor.
+    virtual ~OcctQQuickTextureNode()
+    {
+      releaseTextures();
+    }
+
+    //! Show new frame.
+    void SetFrame(QQuickWindow* theWindow, const OcctGlTextureRing::Frame& theFrame)
+    {
+      if (theFrame.Size != mySize)
+      {
+        // textures have been reallocated - old wrappers are deleted after replacing current texture
+        std::map<unsigned int, QSGTexture*> anOldTextures;
+        anOldTextures.swap(myTextures);
+        mySize = theFrame.Size;
+        setTexture(wrapTexture(theWindow, theFrame));
+        for (const auto& aTexIter : anOldTextures)
+          delete aTexIter.second;
+
+        return;
+      }
+
+      std::map<unsigned int, QSGTexture*>::const_iterator aTexIter = myTextures.find(theFrame.TextureId);
+      setTexture(aTexIter != myTextures.end() ? aTexIter->second : wrapTexture(theWindow, theFrame));
+    }
+
+  private:
+    //! Create scene graph texture wrapping OCCT texture.
+    QSGTexture* wrapTexture(QQuickWindow* theWindow, const OcctGlTextureRing::Frame& theFrame)
+    {
+      const QSize aSize(theFrame.Size.x(), theFrame.Size.y());
+    #if (QT_VERSION_MAJOR >= 6)
+      QSGTexture* aTexture = QNativeInterface::QSGOpenGLTexture::fromNative(theFrame.TextureId, theWindow, aSize);
+    #else
+      QSGTexture* aTexture = theWindow->createTextureFromId(theFrame.TextureId, aSize);
+    #endif
+      myTextures[theFrame.TextureId] = aTexture;
+      return aTexture;
+    }
+
+    //! Release texture wrappers.
+    void releaseTextures()
+    {
+      for (const auto& aTexIter : myTextures)
+        delete aTexIter.second;
+
+      myTextures.clear();
+    }
+
+  private:
+    std::map<unsigned int, QSGTexture*> myTextures;
+    Graphic3d_Vec2i mySize;
+  };
+}
+
+// ================================================================
+// Function : OcctQQuickTextureViewer
+// ================================================================
+OcctQQuickTextureViewer::OcctQQuickTextureViewer(QQuickItem* theParent)
+    : QQuickItem(theParent)
+{
+  Handle(Aspect_DisplayConnection) aDisp   = new Xw_DisplayConnection();
+  Handle(OpenGl_GraphicDriver)     aDriver = new OpenGl_GraphicDriver(aDisp, false);
+  // offscreen context - nothing to swap
+  aDriver->ChangeOptions().buffersNoSwap = true;
+  // don't write into alpha channel
+  aDriver->ChangeOptions().buffersOpaqueAlpha = true;
+  mySharedViewer = new OcctSharedViewer(aDriver);
+  myViewer  = mySharedViewer->Viewer();
+  myContext = mySharedViewer->Context();
+
+  myViewCube = new AIS_ViewCube();
+  myViewCube->SetViewAnimation(myViewAnimation);
+  myViewCube->SetFixedAnimationLoop(false);
+  myViewCube->SetAutoStartAnimation(true);
+  myViewCube->TransformPersistence()->SetOffset2d(Graphic3d_Vec2i(100, 150));
+
+  // note - window will be created later within initializeGL() callback!
+  myView = myViewer->CreateView();
+  myView->SetImmediateUpdate(false);
+  myView->ChangeRenderingParams().NbMsaaSamples = 4; // warning - affects performance
+  myView->ChangeRenderingParams().ToShowStats = true;
+  // NOLINTNEXTLINE
+  myView->ChangeRenderingParams().CollectedStats = (Graphic3d_RenderingParams::PerfCounters)(
+    Graphic3d_RenderingParams::PerfCounters_FrameRate | Graphic3d_RenderingParams::PerfCounters_Triangles);
+  mySharedViewer->AddView(myView, myViewCube, [this]()
+  {
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
+  });
+
+  // input events are stamped to measure input-to-photon latency,
+  // while dragged pointers are extrapolated to expected presentation time
+  myInputAccum.SetInputLatency(&myInputLatency);
+  myInputAccum.SetInputPredictor(&myInputPredictor);
+
+  // QtQuick item setup
+  setFlag(QQuickItem::ItemHasContents, true);
+  setAcceptedMouseButtons(Qt::AllButtons);
+  setAcceptHoverEvents(true);
+
+  // OCCT thread is woken up at most once per published frame
+  connect(&myFrameScheduler, &OcctQtFrameScheduler::frameRequested, this, &OcctQQuickTextureViewer::requestOcctFrame);
+  connect(this, &QQuickItem::windowChanged, this, [this](QQuickWindow* theWindow)
+  {
+    // previous window should no more drive this item
+    for (const QMetaObject::Connection& aConnIter : myConnections)
+      disconnect(aConnIter);
+
+    myConnections.clear();
+    if (theWindow == nullptr)
+      return;
+
+    update(); // OCCT context is created within the first updatePaintNode()
+
+    // input events are reflected by OCCT frame once its texture has been shown by scene graph
+    // (QQuickWindow::frameSwapped() is emitted from GL rendering thread, like updatePaintNode())
+    myConnections.push_back(connect(theWindow, &QQuickWindow::frameSwapped, this, [this]()
+    {
+      myInputLatency.FramePresented(myShownBatch);
+    }, Qt::DirectConnection));
+
+    // OCCT thread might reuse the shown texture only after GPU has finished the scene graph rendering
+    myConnections.push_back(connect(theWindow, &QQuickWindow::afterRendering, this, [this]()
+    {
+      myRenderThread.FenceShownFrame();
+    }, Qt::DirectConnection));
+  });
+
+  // loader signals are emitted from working threads and queued to GUI thread;
+  // loaded parts are displayed by OCCT thread
+  connect(&myModelLoader, &OcctQtModelLoader::partsLoaded, this, [this]() { updateView(); });
+  connect(&myModelLoader, &OcctQtModelLoader::progressChanged, this, [this](double thePercent, const QString& theStep)
+  {
+    myLoadingProgress = thePercent;
+    myLoadingStatus   = theStep;
+    emit loadingChanged();
+  });
+  connect(&myModelLoader, &OcctQtModelLoader::loadingFinished, this, [this](bool , const QString& theMessage)
+  {
+    myLoadingProgress = 100.0;
+    myLoadingStatus   = theMessage;
+    emit loadingChanged();
+  });
+
+  // GUI elements cannot be created from GL rendering thread - make queued connection
+  connect(this, &OcctQQuickTextureViewer::glCriticalError, this, [this](QString theMsg)
+  {
+    QMessageBox::critical(0, "Critical error", theMsg);
+    QApplication::exit(1);
+  }, Qt::QueuedConnection);
+}
+
+// ================================================================
+// Function : ~OcctQQuickTextureViewer
+// ================================================================
+OcctQQuickTextureViewer::~OcctQQuickTextureViewer()
+{
+  for (const QMetaObject::Connection& aConnIter : myConnections)
+    disconnect(aConnIter);
+
+  myConnections.clear();
+
+  // stop background loading
+  myModelLoader.Cancel();
+
+  // stop OCCT thread, which releases OCCT viewer within its OpenGL context
+  myRenderThread.Stop();
+  if (!myView.IsNull())
+  {
+    // OCCT thread has never been started
+    mySharedViewer->RemoveView(myView);
+    myContext.Nullify();
+    myView.Nullify();
+    myViewer.Nullify();
+    mySharedViewer.Nullify();
+  }
+}
+
+// ================================================================
+// Function : event
+// ================================================================
+bool OcctQQuickTextureViewer::event(QEvent* theEvent)
+{
+  if (myView.IsNull())
+    return QQuickItem::event(theEvent);
+
+  if (theEvent->type() == QEvent::UpdateLater)
+  {
+    updateView();
+    theEvent->accept();
+    return true;
+  }
+  return QQuickItem::event(theEvent);
+}
+
+// ================================================================
+// Function : keyPressEvent
+// ================================================================
+void OcctQQuickTextureViewer::keyPressEvent(QKeyEvent* theEvent)
+{
+  if (myView.IsNull())
+    return;
+
+  const Aspect_VKey aKey = OcctQtTools::qtKey2VKey(theEvent->key());
+  switch (aKey)
+  {
+    case Aspect_VKey_Escape:
+    {
+      QApplication::exit();
+      return;
+    }
+    case Aspect_VKey_F:
+    {
+      myViewCommands.Push([this]() { myView->FitAll(0.01, false); });
+      updateView();
+      theEvent->accept();
+      return;
+    }
+  }
+  QQuickItem::keyPressEvent(theEvent);
+}
+
+// ================================================================
+// Function : mousePressEvent
+// ================================================================
+void OcctQQuickTextureViewer::mousePressEvent(QMouseEvent* theEvent)
+{
+  QQuickItem::mousePressEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// ================================================================
+// Function : mouseReleaseEvent
+// ================================================================
+void OcctQQuickTextureViewer::mouseReleaseEvent(QMouseEvent* theEvent)
+{
+  QQuickItem::mouseReleaseEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+
+  // take keyboard focus on mouse click
+  setFocus(true);
+}
+
+// ================================================================
+// Function : mouseMoveEvent
+// ================================================================
+void OcctQQuickTextureViewer::mouseMoveEvent(QMouseEvent* theEvent)
+{
+  QQuickItem::mouseMoveEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// ==============================================================================
+// function : wheelEvent
+// ==============================================================================
+void OcctQQuickTextureViewer::wheelEvent(QWheelEvent* theEvent)
+{
+  QQuickItem::wheelEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddWheelEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// ================================================================
+// Function : hoverMoveEvent
+// ================================================================
+void OcctQQuickTextureViewer::hoverMoveEvent(QHoverEvent* theEvent)
+{
+  QQuickItem::hoverMoveEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddHoverEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// ================================================================
+// Function : geometryChange
+// ================================================================
+#if (QT_VERSION_MAJOR >= 6)
+void OcctQQuickTextureViewer::geometryChange(const QRectF& theNewGeom, const QRectF& theOldGeom)
+{
+  QQuickItem::geometryChange(theNewGeom, theOldGeom);
+#else
+void OcctQQuickTextureViewer::geometryChanged(const QRectF& theNewGeom, const QRectF& theOldGeom)
+{
+  QQuickItem::geometryChanged(theNewGeom, theOldGeom);
+#endif
+  if (theNewGeom.size() != theOldGeom.size())
+  {
+    updateView();
+    update(); // stretch the last frame till the new one is ready
+  }
+}
+
+// =======================================================================
+// Function : updateView
+// =======================================================================
+void OcctQQuickTextureViewer::updateView()
+{
+  myFrameScheduler.RequestFrame();
+}
+
+// ================================================================
+// Function : requestOcctFrame
+// ================================================================
+void OcctQQuickTextureViewer::requestOcctFrame()
+{
+  const QQuickWindow* aQWindow = window();
+  if (aQWindow == nullptr)
+    return;
+
+  myFrameScheduler.FrameStarted();
+  {
+    // pass input events accumulated by GUI thread to AIS_ViewController;
+    // OCCT thread takes them within flushBuffers()
+    std::lock_guard<std::mutex> anInputLock(myInputMutex);
+    myInputAccum.Flush(*this);
+    if (myInputPredictor.Apply(*this, myFrameScheduler.NextPresentationTime() - myFrameScheduler.CurrentTime()))
+      updateView(); // settle extrapolated pointer by the next frame
+  }
+  myRequestedBatch = myInputLatency.LastBatch();
+
+  OcctQtRenderThread::FrameRequest aRequest;
+  aRequest.DevicePixelRatio = aQWindow->devicePixelRatio();
+  aRequest.Size = Graphic3d_Vec2i(Graphic3d_Vec2d(width(), height()) * aRequest.DevicePixelRatio + Graphic3d_Vec2d(0.5));
+  aRequest.PresentTime = myFrameScheduler.NextPresentationTime();
+  myRenderThread.RequestFrame(aRequest);
+}
+
+// ================================================================
+// Function : handleFramePublished
+// ================================================================
+void OcctQQuickTextureViewer::handleFramePublished()
+{
+  // frame scheduler might request the next frame right away
+  myPublishedBatch = myRequestedBatch;
+  myFrameScheduler.FramePresented();
+  update(); // show the new texture within next scene graph frame
+  emit frameTimingsChanged();
+}
+
+// ================================================================
+// Function : setBackgroundColor
+// ================================================================
+void OcctQQuickTextureViewer::setBackgroundColor(const QColor& theColor)
+{
+  myBackColor = theColor;
+  const Quantity_Color aColor = OcctQtTools::qtColorToOcct(theColor);
+  myViewCommands.Push([this, aColor]()
+  {
+    myView->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
+    myView->Invalidate();
+  });
+  updateView();
+}
+
+// ================================================================
+// Function : openModel
+// ================================================================
+void OcctQQuickTextureViewer::openModel(const QUrl& theUrl)
+{
+  const QString aFilePath = theUrl.isLocalFile() ? theUrl.toLocalFile() : theUrl.toString();
+  myModelLoader.Cancel();
+  myViewCommands.Push([this]()
+  {
+    mySharedViewer->RemoveModel();
+  });
+  myLoadingProgress = 0.0;
+  myLoadingStatus.clear();
+  myModelLoader.Load(aFilePath);
+  emit loadingChanged();
+  updateView();
+}
+
+// ================================================================
+// Function : getInputLatency
+// ================================================================
+QVariantMap OcctQQuickTextureViewer::getInputLatency() const
+{
+  return OcctQtTools::qtInputLatencyMap(myInputLatency);
+}
+
+// ================================================================
+// Function : getFrameTimings
+// ================================================================
+QVariantMap OcctQQuickTextureViewer::getFrameTimings() const
+{
+  OcctFrameTimings::Record aRecord;
+  return myFrameTimings.LastRecord(aRecord) ? frameTimingsMap(aRecord) : QVariantMap();
+}
+
+// ================================================================
+// Function : dumpGlInfo
+// ================================================================
+void OcctQQuickTextureViewer::dumpGlInfo()
+{
+  // basic info is fetched once per OpenGL context, while complete one - on demand
+  myGlInfo.Invalidate();
+  myGlInfo.UpdateBasic(myView);
+  myGlInfo.UpdateSize(myView);
+  Message::SendInfo(myGlInfo.Text());
+  Q_EMIT glInfoChanged();
+}
+
+// ================================================================
+// Function : getGlInfo
+// ================================================================
+QString OcctQQuickTextureViewer::getGlInfo()
+{
+  if (!myGlInfo.HasComplete() && myGlInfo.HasBasic())
+  {
+    // extensions list is queried within OCCT thread only when info is actually requested;
+    // glInfoChanged() will be emitted once it is fetched
+    myToFetchGlInfo = true;
+    updateView();
+  }
+  return QString::fromUtf8(myGlInfo.Text().ToCString());
+}
+
+// ================================================================
+// Function : updatePaintNode
+// ================================================================
+QSGNode* OcctQQuickTextureViewer::updatePaintNode(QSGNode* theOldNode, UpdatePaintNodeData* )
+{
+  // this method is called from scene graph thread while GUI thread is blocked
+  QQuickWindow* aQWindow = window();
+  if (myRenderThread.Context() == nullptr
+   && !myView.IsNull()
+   && aQWindow != nullptr)
+  {
+    // create OCCT context sharing resources with scene graph context
+  #if (QT_VERSION_MAJOR >= 6)
+    QOpenGLContext* aSgContext = static_cast<QOpenGLContext*>(
+      aQWindow->rendererInterface()->getResource(aQWindow, QSGRendererInterface::OpenGLContextResource));
+  #else
+    QOpenGLContext* aSgContext = QOpenGLContext::currentContext();
+  #endif
+    if (aSgContext == nullptr)
+    {
+      Q_EMIT glCriticalError("OpenGL scene graph backend is required");
+      delete theOldNode;
+      return nullptr;
+    }
+
+    if (!myRenderThread.CreateContext(aSgContext))
+    {
+      Q_EMIT glCriticalError("Unable to create OpenGL context for OCCT thread");
+      delete theOldNode;
+      return nullptr;
+    }
+
+    // OffscreenSurface should be created within GUI thread
+    QMetaObject::invokeMethod(this, "startRenderThread", Qt::QueuedConnection);
+  }
+
+  OcctQQuickTextureNode* aNode = static_cast<OcctQQuickTextureNode*>(theOldNode);
+  OcctGlTextureRing::Frame aFrame;
+  if (myRenderThread.TextureRing().AcquireLatest(aFrame))
+  {
+    if (aNode == nullptr)
+      aNode = new OcctQQuickTextureNode();
+
+    aNode->SetFrame(aQWindow, aFrame);
+    myShownBatch = myPublishedBatch; // GUI thread is blocked
+  }
+  if (aNode != nullptr)
+    aNode->setRect(boundingRect());
+
+  return aNode;
+}
+
+// ================================================================
+// Function : startRenderThread
+// ================================================================
+void OcctQQuickTextureViewer::startRenderThread()
+{
+  if (myRenderThread.isRunning())
+    return;
+
+  if (!myRenderThread.Start(this))
+  {
+    Q_EMIT glCriticalError("Unable to start OCCT thread");
+    return;
+  }
+  updateView();
+}
+
+// ================================================================
+// Function : PollFrames
+// ================================================================
+bool OcctQQuickTextureViewer::PollFrames()
+{
+  if (myView->Window().IsNull())
+    return false;
+
+  if (myRenderThread.TextureRing().Poll(myView))
+    framePublished();
+
+  return myRenderThread.TextureRing().HasPending();
+}
+
+// ================================================================
+// Function : initializeGL
+// ================================================================
+bool OcctQQuickTextureViewer::initializeGL(const Graphic3d_Vec2i& theSize, double theDevPixelRatio)
+{
+  Handle(OpenGl_GraphicDriver) aDriver = Handle(OpenGl_GraphicDriver)::DownCast(myViewer->Driver());
+  OcctQtTools::qtGlCapsFromSurfaceFormat(aDriver->ChangeOptions(), myRenderThread.Context()->format());
+
+  const bool isFirstInit = myView->Window().IsNull();
+  if (!OcctGlTools::InitializeGlWindow(myView, 0, theSize, theDevPixelRatio))
+  {
+    Q_EMIT glCriticalError("OpenGl_Context is unable to wrap OpenGL context");
+    return false;
+  }
+
+  dumpGlInfo();
+  if (isFirstInit)
+  {
+    mySharedViewer->DisplayViewCube(myView);
+    if (!mySharedViewer->ToDisplaySampleModel())
+      return true;
+
+    // dummy shape for testing
+    TopoDS_Shape      aBox   = BRepPrimAPI_MakeBox(100.0, 50.0, 90.0).Shape();
+    OcctTessellator().MeshPart(aBox);
+    Handle(AIS_Shape) aShape = new AIS_Shape(aBox);
+    myContext->Display(aShape, AIS_Shaded, 0, false);
+  }
+  return true;
+}
+
+// ================================================================
+// Function : RenderFrame
+// ================================================================
+void OcctQQuickTextureViewer::RenderFrame(const OcctQtRenderThread::FrameRequest& theRequest)
+{
+  if (theRequest.Size.x() <= 0
+   || theRequest.Size.y() <= 0)
+  {
+    return;
+  }
+
+  if (myView->Window().IsNull()
+   || myView->Window()->DevicePixelRatio() != theRequest.DevicePixelRatio)
+  {
+    if (!initializeGL(theRequest.Size, theRequest.DevicePixelRatio))
+      return;
+  }
+
+  myFramePresentTime = theRequest.PresentTime;
+
+  myFrameTimings.BeginFrame();
+
+  // execute commands passed from GUI thread
+  myViewCommands.Swap();
+  myViewCommands.Execute();
+
+  // display parts loaded in background within a few milliseconds per frame
+  if (myModelLoader.DisplayLoadedParts(myContext, myView, 0.005))
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
+
+  bool isTargetReady = false;
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_InitFbo);
+    isTargetReady = myRenderThread.TextureRing().BeginFrame(myView, theRequest.Size);
+  }
+  if (!isTargetReady)
+  {
+    myFrameTimings.EndFrame();
+    Q_EMIT glCriticalError("OCCT is unable to allocate texture ring");
+    return;
+  }
+
+  if (myGlInfo.UpdateSize(myView)) // cheap, without GL queries
+    Q_EMIT glInfoChanged();
+  if (myToFetchGlInfo.exchange(false)
+   && myGlInfo.UpdateComplete(myView))
+  {
+    Q_EMIT glInfoChanged();
+  }
+
+  // each texture of the ring keeps an older frame - the whole view is redrawn;
+  // OpenGL context is not shared with Qt, so that GL state reset is unnecessary
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_FlushView);
+    myView->Invalidate();
+    AIS_ViewController::FlushViewEvents(myContext, myView, true);
+  }
+
+  const bool isPublished = myRenderThread.TextureRing().EndFrame(myView);
+  myFrameTimings.EndFrame();
+  if (isPublished)
+    framePublished();
+}
+
+// ================================================================
+// Function : framePublished
+// ================================================================
+void OcctQQuickTextureViewer::framePublished()
+{
+  myFrameTimings.FramePresented();
+  QMetaObject::invokeMethod(this, "handleFramePublished", Qt::QueuedConnection);
+}
+
+// ================================================================
+// Function : ReleaseGl
+// ================================================================
+void OcctQQuickTextureViewer::ReleaseGl()
+{
+  myRenderThread.TextureRing().Release(myView);
+
+  // hold on X11 display connection till making another connection active by glXMakeCurrent()
+  Handle(Aspect_DisplayConnection) aDisp = myViewer->Driver()->GetDisplayConnection();
+
+  // release OCCT viewer while its OpenGL context is current
+  mySharedViewer->RemoveView(myView);
+  myContext.Nullify();
+  myView.Nullify();
+  myViewer.Nullify();
+  mySharedViewer.Nullify();
+  aDisp.Nullify();
+}
+
+// ================================================================
+// Function : flushBuffers
+// ================================================================
+void OcctQQuickTextureViewer::flushBuffers(const Handle(AIS_InteractiveContext)& theCtx,
+                                           const Handle(V3d_View)&               theView)
+{
+  std::lock_guard<std::mutex> anInputLock(myInputMutex);
+  AIS_ViewController::flushBuffers(theCtx, theView);
+}
+
+// ================================================================
+// Function : handleViewRedraw
+// ================================================================
+void OcctQQuickTextureViewer::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
+                                               const Handle(V3d_View)&               theView)
+{
+  // animate camera for expected presentation time of this frame
+  myFrameScheduler.SyncAnimationTimer(myViewAnimation, myFramePresentTime);
+
+  AIS_ViewController::handleViewRedraw(theCtx, theView);
+  if (myToAskNextFrame)
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater)); // ask more frames for animation
+}
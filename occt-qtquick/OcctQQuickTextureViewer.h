@@ -0,0 +1,223 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQQuickTextureViewer_HeaderFile
+#define _OcctQQuickTextureViewer_HeaderFile
+
+#include "../occt-qt-tools/OcctFrameTimings.h"
+#include "../occt-qt-tools/OcctGlInfo.h"
+#include "../occt-qt-tools/OcctInputLatency.h"
+#include "../occt-qt-tools/OcctInputPredictor.h"
+#include "../occt-qt-tools/OcctQtFrameScheduler.h"
+#include "../occt-qt-tools/OcctQtInputAccumulator.h"
+#include "../occt-qt-tools/OcctQtModelLoader.h"
+#include "../occt-qt-tools/OcctQtRenderThread.h"
+#include "../occt-qt-tools/OcctQtTools.h"
+#include "../occt-qt-tools/OcctSharedViewer.h"
+#include "../occt-qt-tools/OcctViewCommandQueue.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QColor>
+#include <QMetaObject>
+#include <QQuickItem>
+#include <QUrl>
+#include <QVariantMap>
+#include <Standard_WarningsRestore.hxx>
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_ViewController.hxx>
+#include <V3d_View.hxx>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+class AIS_ViewCube;
+
+//! QtQuick item displaying OCCT 3D View rendered on a dedicated thread.
+//!
+//! OCCT renders within its own thread and OpenGL context (OcctQtRenderThread) sharing resources with Qt Quick scene graph context
+//! into a ring of 3 textures (OcctGlTextureRing), and the item shows the newest completed texture
+//! through QSGSimpleTextureNode. Scene graph never waits for OCCT - a heavy model redrawn at low frame rate
+//! doesn't slow down QML animations and controls, which keep presenting the last completed OCCT frame.
+//!
+//! Threads:
+//! - GUI thread queues input events and view commands, and wakes up OCCT thread once per frame;
+//! - OCCT thread flushes input into AIS_ViewController, redraws the view and publishes the texture;
+//! - scene graph thread acquires the newest published texture within updatePaintNode().
+//! Requires OpenGL scene graph backend.
+class OcctQQuickTextureViewer : public QQuickItem, public AIS_ViewController, private OcctQtRenderThread::Renderer
+{
+  Q_OBJECT
+
+  // QML properties
+  Q_PROPERTY(QColor  backgroundColor READ getBackgroundColor WRITE setBackgroundColor)
+  Q_PROPERTY(QString glInfo READ getGlInfo NOTIFY glInfoChanged)
+  Q_PROPERTY(bool    loading READ isLoading NOTIFY loadingChanged)
+  Q_PROPERTY(double  loadingProgress READ getLoadingProgress NOTIFY loadingChanged)
+  Q_PROPERTY(QString loadingStatus READ getLoadingStatus NOTIFY loadingChanged)
+  Q_PROPERTY(QVariantMap frameTimings READ getFrameTimings NOTIFY frameTimingsChanged)
+  Q_PROPERTY(QVariantMap inputLatency READ getInputLatency NOTIFY frameTimingsChanged)
+public:
+  //! Main constructor.
+  OcctQQuickTextureViewer(QQuickItem* theParent = nullptr);
+
+  //! Destructor, stopping OCCT rendering thread.
+  virtual ~OcctQQuickTextureViewer();
+
+  //! Return Viewer.
+  const Handle(V3d_Viewer)& Viewer() const { return myViewer; }
+
+  //! Return View.
+  const Handle(V3d_View)& View() const { return myView; }
+
+  //! Return AIS context.
+  const Handle(AIS_InteractiveContext)& Context() const { return myContext; }
+
+  //! Return statistics of texture ring (rendered, displayed and dropped OCCT frames).
+  OcctGlTextureRing::Stats TextureRingStats() const { return myRenderThread.TextureRing().Statistics(); }
+
+public: // QML accessors
+  //! Return OpenGL info; complete info (including extensions) is fetched on first request.
+  QString getGlInfo();
+
+  //! Return background color.
+  QColor getBackgroundColor() const { return myBackColor; }
+
+  //! Set background color.
+  void setBackgroundColor(const QColor& theColor);
+
+  //! Return TRUE if model is being loaded.
+  bool isLoading() const { return myModelLoader.IsLoading(); }
+
+  //! Return model loading progress in percents.
+  double getLoadingProgress() const { return myLoadingProgress; }
+
+  //! Return model loading status message.
+  const QString& getLoadingStatus() const { return myLoadingStatus; }
+
+  //! Start asynchronous loading of STEP/BREP file replacing displayed shapes;
+  //! parts are displayed progressively as soon as they are meshed.
+  Q_INVOKABLE void openModel(const QUrl& theUrl);
+
+  //! Cancel model loading.
+  Q_INVOKABLE void cancelLoading() { myModelLoader.Cancel(); }
+
+  //! Return timings of the last OCCT frame as map of phase names to milliseconds
+  //! (including "frame" index and "total" time); composition is a time till GPU completion.
+  QVariantMap getFrameTimings() const;
+
+  //! Return input-to-photon latency of mouse events as map of "p50", "p95", "p99", "max" milliseconds
+  //! and number of "samples".
+  QVariantMap getInputLatency() const;
+
+  //! Return model loader.
+  OcctQtModelLoader& ModelLoader() { return myModelLoader; }
+
+  //! Return per-phase frame timings.
+  const OcctFrameTimings& FrameTimings() const { return myFrameTimings; }
+
+  //! Return input-to-photon latency histogram.
+  OcctInputLatency& InputLatency() { return myInputLatency; }
+
+  //! Return predictor extrapolating dragged pointers to expected presentation time.
+  OcctInputPredictor& InputPredictor() { return myInputPredictor; }
+
+signals:
+  void glInfoChanged();
+  void loadingChanged();
+  void frameTimingsChanged();
+  void glCriticalError(QString theMsg);
+
+protected: // user input events
+  virtual bool event(QEvent* theEvent) override;
+  virtual void keyPressEvent(QKeyEvent* theEvent) override;
+  virtual void mousePressEvent(QMouseEvent* theEvent) override;
+  virtual void mouseReleaseEvent(QMouseEvent* theEvent) override;
+  virtual void mouseMoveEvent(QMouseEvent* theEvent) override;
+  virtual void wheelEvent(QWheelEvent* theEvent) override;
+  virtual void hoverMoveEvent(QHoverEvent* theEvent) override;
+
+protected:
+  //! Show the newest OCCT frame (scene graph thread, GUI thread is blocked).
+  virtual QSGNode* updatePaintNode(QSGNode* theOldNode, UpdatePaintNodeData* theData) override;
+
+  //! Request OCCT frame of a new size.
+#if (QT_VERSION_MAJOR >= 6)
+  virtual void geometryChange(const QRectF& theNewGeom, const QRectF& theOldGeom) override;
+#else
+  virtual void geometryChanged(const QRectF& theNewGeom, const QRectF& theOldGeom) override;
+#endif
+
+  //! Lock input buffers while they are flushed by OCCT thread.
+  virtual void flushBuffers(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
+
+  //! Handle view redraw.
+  virtual void handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
+
+private slots:
+  //! Start OCCT thread (GUI thread).
+  void startRenderThread();
+
+  //! Request the new frame from OCCT thread (GUI thread).
+  void requestOcctFrame();
+
+  //! Show the newest published frame (GUI thread).
+  void handleFramePublished();
+
+private: //! @name OcctQtRenderThread::Renderer interface (OCCT thread)
+  //! Redraw the view into the next texture of the ring.
+  virtual void RenderFrame(const OcctQtRenderThread::FrameRequest& theRequest) override;
+
+  //! Publish frames completed by GPU.
+  virtual bool PollFrames() override;
+
+  //! Release OCCT viewer.
+  virtual void ReleaseGl() override;
+
+private:
+  //! Initialize OCCT view for OCCT thread OpenGL context (OCCT thread).
+  bool initializeGL(const Graphic3d_Vec2i& theSize, double theDevPixelRatio);
+
+  //! Notify GUI thread about new published frame (OCCT thread).
+  void framePublished();
+
+  //! Fetch and print basic OpenGL info of new OpenGL context.
+  void dumpGlInfo();
+
+  //! Request OCCT redraw through frame scheduler (GUI thread).
+  void updateView();
+
+private:
+  Handle(OcctSharedViewer)       mySharedViewer;
+  Handle(V3d_Viewer)             myViewer;
+  Handle(V3d_View)               myView;
+  Handle(AIS_InteractiveContext) myContext;
+  Handle(AIS_ViewCube)           myViewCube;
+
+  OcctQtRenderThread myRenderThread; //!< OCCT thread and its context (created by scene graph thread)
+
+  std::mutex             myInputMutex;   //!< lock for AIS_ViewController input buffers
+  OcctViewCommandQueue   myViewCommands; //!< commands passed from GUI thread to OCCT thread
+  OcctQtInputAccumulator myInputAccum;
+  OcctQtFrameScheduler   myFrameScheduler;
+  OcctFrameTimings       myFrameTimings;
+  OcctInputLatency       myInputLatency;
+  OcctInputPredictor     myInputPredictor;
+
+  double                 myFramePresentTime = 0.0; //!< expected presentation time of frame being rendered (OCCT thread)
+  uint64_t               myRequestedBatch   = 0;   //!< input latency batch passed with the last frame request (GUI thread)
+  uint64_t               myPublishedBatch   = 0;   //!< input latency batch reflected by the last published frame (GUI thread)
+  uint64_t               myShownBatch       = 0;   //!< input latency batch reflected by the shown texture (scene graph thread)
+  std::vector<QMetaObject::Connection> myConnections; //!< connections to signals of the window
+
+  QColor myBackColor = QColor(0, 0, 0);
+
+  OcctQtModelLoader myModelLoader;
+  double            myLoadingProgress = 0.0;
+  QString           myLoadingStatus;
+
+  OcctGlInfo        myGlInfo;
+  std::atomic<bool> myToFetchGlInfo { false }; //!< complete OpenGL info has been requested by GUI thread
+};
+
+#endif // _OcctQQuickTextureViewer_HeaderFile
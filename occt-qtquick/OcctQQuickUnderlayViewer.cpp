@@ -0,0 +1,660 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifdef _WIN32
+  // should be included before other headers to avoid missing definitions
+  #include <windows.h>
+#endif
+#include <OpenGl_Context.hxx>
+
+#include "OcctQQuickUnderlayViewer.h"
+
+#include "../occt-qt-tools/OcctGlTools.h"
+#include "../occt-qt-tools/OcctTessellator.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QApplication>
+#include <QMessageBox>
+#include <QMouseEvent>
+#include <QQuickWindow>
+#include <QRunnable>
+#include <Standard_WarningsRestore.hxx>
+
+#include <AIS_Shape.hxx>
+#include <AIS_ViewCube.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Message.hxx>
+#include <OpenGl_GraphicDriver.hxx>
+
+#if !defined(__APPLE__) && !defined(_WIN32) && defined(__has_include)
+  #if __has_include(<Xw_DisplayConnection.hxx>)
+    #include <Xw_DisplayConnection.hxx>
+    #define USE_XW_DISPLAY
+  #endif
+#endif
+#ifndef USE_XW_DISPLAY
+typedef Aspect_DisplayConnection Xw_DisplayConnection;
+#endif
+
+namespace
+{
+  //! Convert frame timings into QML map of phase names to milliseconds.
+  static QVariantMap frameTimingsMap(const OcctFrameTimings::Record& theRecord)
+  {
+    QVariantMap aMap;
+    aMap["frame"] = QVariant::fromValue<qulonglong>(theRecord.FrameIndex);
+    aMap["total"] = theRecord.TotalTime * 1000.0;
+    for (int aPhaseIter = 0; aPhaseIter < OcctFramePhase_NB; ++aPhaseIter)
+      aMap[OcctFrameTimings::PhaseName((OcctFramePhase)aPhaseIter)] = theRecord.Phases[aPhaseIter] * 1000.0;
+
+    return aMap;
+  }
+
+  //! Render job releasing OCCT view within GL rendering thread, while OpenGL context of the window is current.
+  //! Job deleted without execution (window is no more renderable) releases the view from the calling thread.
+  class OcctViewReleaseJob : public QRunnable
+  {
+  public:
+    OcctViewReleaseJob(const Handle(OcctSharedViewer)& theViewer, const Handle(V3d_View)& theView)
+    : mySharedViewer(theViewer), myView(theView) {}
+
+    virtual ~OcctViewReleaseJob() { release(); }
+
+    virtual void run() override { release(); }
+
+  private:
+    //! Remove the view; presentations are released with the last view of the viewer.
+    void release()
+    {
+      if (myView.IsNull())
+        return;
+
+      // hold on X11 display connection till making another connection active by glXMakeCurrent()
+      Handle(Aspect_DisplayConnection) aDisp = mySharedViewer->Viewer()->Driver()->GetDisplayConnection();
+      mySharedViewer->RemoveView(myView);
+      myView.Nullify();
+      mySharedViewer.Nullify();
+    }
+
+  private:
+    Handle(OcctSharedViewer) mySharedViewer;
+    Handle(V3d_View)         myView;
+  };
+}
+
+// ================================================================
+// Function : OcctQQuickUnderlayViewer
+// ================================================================
+OcctQQuickUnderlayViewer::OcctQQuickUnderlayViewer(QQuickItem* theParent)
+    : QQuickItem(theParent)
+{
+  createViewer();
+
+  // input events are stamped to measure input-to-photon latency,
+  // while dragged pointers are extrapolated to expected presentation time
+  myInputAccum.SetInputLatency(&myInputLatency);
+  myInputAccum.SetInputPredictor(&myInputPredictor);
+
+  // QtQuick item setup; item has no content of its own
+  setFlag(QQuickItem::ItemHasContents, false);
+  setAcceptedMouseButtons(Qt::AllButtons);
+  setAcceptHoverEvents(true);
+
+  // redraw requests are throttled by presentation of previous frame
+  connect(&myFrameScheduler, &OcctQtFrameScheduler::frameRequested, this, [this]()
+  {
+    if (window() != nullptr)
+      window()->update();
+  });
+  connect(this, &QQuickItem::windowChanged, this, &OcctQQuickUnderlayViewer::handleWindowChanged);
+
+  // loader signals are emitted from working threads and queued to GUI thread;
+  // loaded parts are displayed by rendering thread
+  connect(&myModelLoader, &OcctQtModelLoader::partsLoaded, this, [this]() { updateView(); });
+  connect(&myModelLoader, &OcctQtModelLoader::progressChanged, this, [this](double thePercent, const QString& theStep)
+  {
+    myLoadingProgress = thePercent;
+    myLoadingStatus   = theStep;
+    emit loadingChanged();
+  });
+  connect(&myModelLoader, &OcctQtModelLoader::loadingFinished, this, [this](bool , const QString& theMessage)
+  {
+    myLoadingProgress = 100.0;
+    myLoadingStatus   = theMessage;
+    emit loadingChanged();
+  });
+
+  // GUI elements cannot be created from GL rendering thread - make queued connection
+  connect(this, &OcctQQuickUnderlayViewer::glCriticalError, this, [this](QString theMsg)
+  {
+    QMessageBox::critical(0, "Critical error", theMsg);
+    QApplication::exit(1);
+  }, Qt::QueuedConnection);
+}
+
+// ================================================================
+// Function : ~OcctQQuickUnderlayViewer
+// ================================================================
+OcctQQuickUnderlayViewer::~OcctQQuickUnderlayViewer()
+{
+  // stop background loading
+  myModelLoader.Cancel();
+
+  // stop rendering and wait for the frame in progress
+  for (const QMetaObject::Connection& aConnIter : myConnections)
+    disconnect(aConnIter);
+
+  myConnections.clear();
+  Standard_Mutex::Sentry aLock(myViewerMutex);
+
+  // OCCT view holds resources of OpenGL context of the window - release them within GL rendering thread
+  QRunnable* aReleaseJob = detachViewer();
+  if (QQuickWindow* aQWindow = window())
+    aQWindow->scheduleRenderJob(aReleaseJob, QQuickWindow::NoStage);
+  else
+    delete aReleaseJob;
+}
+
+// ================================================================
+// Function : createViewer
+// ================================================================
+void OcctQQuickUnderlayViewer::createViewer()
+{
+  Handle(Aspect_DisplayConnection) aDisp   = new Xw_DisplayConnection();
+  Handle(OpenGl_GraphicDriver)     aDriver = new OpenGl_GraphicDriver(aDisp, false);
+  // lets QtQuick to manage buffer swap
+  aDriver->ChangeOptions().buffersNoSwap = true;
+  // don't write into alpha channel
+  aDriver->ChangeOptions().buffersOpaqueAlpha = true;
+  // draw directly into render target of the window without offscreen FBO
+  aDriver->ChangeOptions().useSystemBuffer = true;
+  mySharedViewer = new OcctSharedViewer(aDriver);
+  myViewer  = mySharedViewer->Viewer();
+  myContext = mySharedViewer->Context();
+
+  myViewCube = new AIS_ViewCube();
+  myViewCube->SetViewAnimation(myViewAnimation);
+  myViewCube->SetFixedAnimationLoop(false);
+  myViewCube->SetAutoStartAnimation(true);
+  myViewCube->TransformPersistence()->SetOffset2d(Graphic3d_Vec2i(100, 150));
+
+  // note - window will be created later within initializeGL() callback!
+  myView = myViewer->CreateView();
+  myView->SetImmediateUpdate(false);
+  // MSAA is defined by window surface format - OCCT MSAA would require offscreen FBO
+  myView->ChangeRenderingParams().NbMsaaSamples = 0;
+  myView->ChangeRenderingParams().ToShowStats = true;
+  // NOLINTNEXTLINE
+  myView->ChangeRenderingParams().CollectedStats = (Graphic3d_RenderingParams::PerfCounters)(
+    Graphic3d_RenderingParams::PerfCounters_FrameRate | Graphic3d_RenderingParams::PerfCounters_Triangles);
+  mySharedViewer->AddView(myView, myViewCube, [this]()
+  {
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
+  });
+}
+
+// ================================================================
+// Function : detachViewer
+// ================================================================
+QRunnable* OcctQQuickUnderlayViewer::detachViewer()
+{
+  QRunnable* aReleaseJob = new OcctViewReleaseJob(mySharedViewer, myView);
+  myContext.Nullify();
+  myView.Nullify();
+  myViewer.Nullify();
+  myViewCube.Nullify();
+  mySharedViewer.Nullify();
+  return aReleaseJob;
+}
+
+// ================================================================
+// Function : restartViewer
+// ================================================================
+void OcctQQuickUnderlayViewer::restartViewer(QQuickWindow* theWindow)
+{
+  if (myView.IsNull()
+   || myView->Window().IsNull())
+  {
+    return; // view is not bound to OpenGL context
+  }
+
+  const Handle(V3d_View) anOldView = myView;
+  QRunnable* aReleaseJob = detachViewer();
+  createViewer();
+
+  // the new view will be initialized within OpenGL context of the next window
+  myView->Camera()->Copy(anOldView->Camera());
+  myView->SetBackgroundColor(anOldView->BackgroundColor());
+  Quantity_Color aGradColor1, aGradColor2;
+  anOldView->GradientBackground().Colors(aGradColor1, aGradColor2);
+  myView->SetBgGradientColors(aGradColor1, aGradColor2, anOldView->GradientBackground().BgGradientFillMethod());
+  if (theWindow != nullptr)
+  {
+    theWindow->scheduleRenderJob(aReleaseJob, QQuickWindow::NoStage);
+  }
+  else
+  {
+    aReleaseJob->run();
+    delete aReleaseJob;
+  }
+}
+
+// ================================================================
+// Function : releaseResources
+// ================================================================
+void OcctQQuickUnderlayViewer::releaseResources()
+{
+  // item is removed from the window (GUI thread)
+  QQuickWindow* aQWindow = window();
+  Standard_Mutex::Sentry aLock(myViewerMutex);
+  restartViewer(aQWindow);
+}
+
+// ================================================================
+// Function : handleWindowChanged
+// ================================================================
+void OcctQQuickUnderlayViewer::handleWindowChanged(QQuickWindow* theWindow)
+{
+  for (const QMetaObject::Connection& aConnIter : myConnections)
+    disconnect(aConnIter);
+
+  myConnections.clear();
+  if (theWindow == nullptr)
+    return;
+
+  // OCCT is drawn from GL rendering thread right before scene graph
+#if (QT_VERSION_MAJOR >= 6)
+  myConnections.push_back(connect(theWindow, &QQuickWindow::beforeRenderPassRecording,
+                                  this, &OcctQQuickUnderlayViewer::render, Qt::DirectConnection));
+#else
+  // keep OCCT frame within color buffer
+  theWindow->setClearBeforeRendering(false);
+  myConnections.push_back(connect(theWindow, &QQuickWindow::beforeRendering,
+                                  this, &OcctQQuickUnderlayViewer::render, Qt::DirectConnection));
+#endif
+  myConnections.push_back(connect(theWindow, &QQuickWindow::beforeSynchronizing,
+                                  this, &OcctQQuickUnderlayViewer::synchronize, Qt::DirectConnection));
+
+  // OpenGL context is about to be destroyed (GL rendering thread, context is current)
+  myConnections.push_back(connect(theWindow, &QQuickWindow::sceneGraphInvalidated, this, [this]()
+  {
+    Standard_Mutex::Sentry aLock(myViewerMutex);
+    restartViewer(nullptr);
+  }, Qt::DirectConnection));
+
+  // QQuickWindow::frameSwapped() is emitted from GL rendering thread - make queued connection
+  myConnections.push_back(connect(theWindow, &QQuickWindow::frameSwapped,
+                                  &myFrameScheduler, &OcctQtFrameScheduler::FramePresented, Qt::QueuedConnection));
+  myConnections.push_back(connect(theWindow, &QQuickWindow::frameSwapped, this, [this]()
+  {
+    myFrameTimings.FramePresented();
+    myInputLatency.FramePresented(); // input events have been flushed by synchronize() of this frame
+    QMetaObject::invokeMethod(this, "frameTimingsChanged", Qt::QueuedConnection);
+  }, Qt::DirectConnection));
+}
+
+// ================================================================
+// Function : event
+// ================================================================
+bool OcctQQuickUnderlayViewer::event(QEvent* theEvent)
+{
+  if (myView.IsNull())
+    return QQuickItem::event(theEvent);
+
+  if (theEvent->type() == QEvent::UpdateLater)
+  {
+    updateView();
+    theEvent->accept();
+    return true;
+  }
+  return QQuickItem::event(theEvent);
+}
+
+// ================================================================
+// Function : keyPressEvent
+// ================================================================
+void OcctQQuickUnderlayViewer::keyPressEvent(QKeyEvent* theEvent)
+{
+  if (myView.IsNull())
+    return;
+
+  const Aspect_VKey aKey = OcctQtTools::qtKey2VKey(theEvent->key());
+  switch (aKey)
+  {
+    case Aspect_VKey_Escape:
+    {
+      QApplication::exit();
+      return;
+    }
+    case Aspect_VKey_F:
+    {
+      myViewCommands.Push([this]() { myView->FitAll(0.01, false); });
+      updateView();
+      theEvent->accept();
+      return;
+    }
+  }
+  QQuickItem::keyPressEvent(theEvent);
+}
+
+// ================================================================
+// Function : mousePressEvent
+// ================================================================
+void OcctQQuickUnderlayViewer::mousePressEvent(QMouseEvent* theEvent)
+{
+  QQuickItem::mousePressEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// ================================================================
+// Function : mouseReleaseEvent
+// ================================================================
+void OcctQQuickUnderlayViewer::mouseReleaseEvent(QMouseEvent* theEvent)
+{
+  QQuickItem::mouseReleaseEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+
+  // take keyboard focus on mouse click
+  setFocus(true);
+}
+
+// ================================================================
+// Function : mouseMoveEvent
+// ================================================================
+void OcctQQuickUnderlayViewer::mouseMoveEvent(QMouseEvent* theEvent)
+{
+  QQuickItem::mouseMoveEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddMouseEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// ==============================================================================
+// function : wheelEvent
+// ==============================================================================
+void OcctQQuickUnderlayViewer::wheelEvent(QWheelEvent* theEvent)
+{
+  QQuickItem::wheelEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddWheelEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// ================================================================
+// Function : hoverMoveEvent
+// ================================================================
+void OcctQQuickUnderlayViewer::hoverMoveEvent(QHoverEvent* theEvent)
+{
+  QQuickItem::hoverMoveEvent(theEvent);
+  if (myView.IsNull())
+    return;
+
+  theEvent->accept();
+  if (myInputAccum.AddHoverEvent(window()->devicePixelRatio(), theEvent))
+    updateView();
+}
+
+// =======================================================================
+// Function : updateView
+// =======================================================================
+void OcctQQuickUnderlayViewer::updateView()
+{
+  myFrameScheduler.RequestFrame();
+}
+
+// ================================================================
+// Function : setBackgroundColor
+// ================================================================
+void OcctQQuickUnderlayViewer::setBackgroundColor(const QColor& theColor)
+{
+  myBackColor = theColor;
+  const Quantity_Color aColor = OcctQtTools::qtColorToOcct(theColor);
+  myViewCommands.Push([this, aColor]()
+  {
+    myView->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
+    myView->Invalidate();
+  });
+  updateView();
+}
+
+// ================================================================
+// Function : openModel
+// ================================================================
+void OcctQQuickUnderlayViewer::openModel(const QUrl& theUrl)
+{
+  const QString aFilePath = theUrl.isLocalFile() ? theUrl.toLocalFile() : theUrl.toString();
+  myModelLoader.Cancel();
+  myViewCommands.Push([this]()
+  {
+    mySharedViewer->RemoveModel();
+  });
+  myLoadingProgress = 0.0;
+  myLoadingStatus.clear();
+  myModelLoader.Load(aFilePath);
+  emit loadingChanged();
+  updateView();
+}
+
+// ================================================================
+// Function : getInputLatency
+// ================================================================
+QVariantMap OcctQQuickUnderlayViewer::getInputLatency() const
+{
+  return OcctQtTools::qtInputLatencyMap(myInputLatency);
+}
+
+// ================================================================
+// Function : getFrameTimings
+// ================================================================
+QVariantMap OcctQQuickUnderlayViewer::getFrameTimings() const
+{
+  OcctFrameTimings::Record aRecord;
+  return myFrameTimings.LastRecord(aRecord) ? frameTimingsMap(aRecord) : QVariantMap();
+}
+
+// ================================================================
+// Function : handleViewRedraw
+// ================================================================
+void OcctQQuickUnderlayViewer::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
+                                                const Handle(V3d_View)&               theView)
+{
+  // animate camera for expected presentation time of this frame
+  myFrameScheduler.SyncAnimationTimer(myViewAnimation, myNextPresentTime);
+
+  AIS_ViewController::handleViewRedraw(theCtx, theView);
+  if (myToAskNextFrame)
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater)); // ask more frames for animation
+}
+
+// ================================================================
+// Function : dumpGlInfo
+// ================================================================
+void OcctQQuickUnderlayViewer::dumpGlInfo()
+{
+  // basic info is fetched once per OpenGL context, while complete one - on demand
+  myGlInfo.Invalidate();
+  myGlInfo.UpdateBasic(myView);
+  myGlInfo.UpdateSize(myView);
+  Message::SendInfo(myGlInfo.Text());
+  Q_EMIT glInfoChanged();
+}
+
+// ================================================================
+// Function : getGlInfo
+// ================================================================
+QString OcctQQuickUnderlayViewer::getGlInfo()
+{
+  if (!myGlInfo.HasComplete() && myGlInfo.HasBasic())
+  {
+    // extensions list is queried within rendering thread only when info is actually requested;
+    // glInfoChanged() will be emitted once it is fetched
+    myToFetchGlInfo = true;
+    updateView();
+  }
+  return QString::fromUtf8(myGlInfo.Text().ToCString());
+}
+
+// ================================================================
+// Function : synchronize
+// ================================================================
+void OcctQQuickUnderlayViewer::synchronize()
+{
+  // this method will be called from GL rendering thread while GUI thread is locked,
+  // the place to synchronize GUI / GL rendering states
+  Standard_Mutex::Sentry aLock(myViewerMutex);
+  const QQuickWindow* aQWindow = window();
+  if (aQWindow == nullptr)
+    return;
+
+  myFrameScheduler.FrameStarted();
+  myNextPresentTime = myFrameScheduler.NextPresentationTime();
+  myDevPixelRatio = aQWindow->devicePixelRatio();
+  myWinSize = Graphic3d_Vec2i(Graphic3d_Vec2d(aQWindow->width(), aQWindow->height()) * myDevPixelRatio + Graphic3d_Vec2d(0.5));
+  if (!myView.IsNull())
+  {
+    myInputAccum.Flush(*this); // pass input events accumulated by GUI thread to AIS_ViewController
+    if (myInputPredictor.Apply(*this, myNextPresentTime - myFrameScheduler.CurrentTime()))
+      QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater)); // settle extrapolated pointer by the next frame
+  }
+
+  // take commands written by GUI thread, to be executed within render()
+  myViewCommands.Swap();
+}
+
+// ================================================================
+// Function : initializeGL
+// ================================================================
+bool OcctQQuickUnderlayViewer::initializeGL()
+{
+  const QQuickWindow* aQWindow = window();
+  Handle(OpenGl_GraphicDriver) aDriver = Handle(OpenGl_GraphicDriver)::DownCast(myViewer->Driver());
+  OcctQtTools::qtGlCapsFromSurfaceFormat(aDriver->ChangeOptions(), aQWindow->format());
+
+  const Aspect_Drawable aNativeWin = (Aspect_Drawable)aQWindow->winId();
+  const bool isFirstInit = myView->Window().IsNull();
+  if (!OcctGlTools::InitializeGlWindow(myView, aNativeWin, myWinSize, myDevPixelRatio))
+  {
+    Q_EMIT glCriticalError("OpenGl_Context is unable to wrap OpenGL context");
+    return false;
+  }
+
+  dumpGlInfo();
+  if (isFirstInit)
+  {
+    mySharedViewer->DisplayViewCube(myView);
+    if (!mySharedViewer->ToDisplaySampleModel())
+      return true;
+
+    // dummy shape for testing
+    TopoDS_Shape      aBox   = BRepPrimAPI_MakeBox(100.0, 50.0, 90.0).Shape();
+    OcctTessellator().MeshPart(aBox);
+    Handle(AIS_Shape) aShape = new AIS_Shape(aBox);
+    myContext->Display(aShape, AIS_Shaded, 0, false);
+  }
+  return true;
+}
+
+// ================================================================
+// Function : render
+// ================================================================
+void OcctQQuickUnderlayViewer::render()
+{
+  // this method is called from GL rendering thread;
+  // accessing GUI items is not allowed here!
+  Standard_Mutex::Sentry aLock(myViewerMutex);
+  QQuickWindow* aQWindow = window();
+  if (myView.IsNull() || aQWindow == nullptr)
+    return;
+
+#if (QT_VERSION_MAJOR >= 6)
+  // flush commands recorded by Qt Quick, so that render target of the window is bound
+  aQWindow->beginExternalCommands();
+#endif
+  myFrameTimings.BeginFrame();
+  const Aspect_Drawable aNativeWin = OcctGlTools::GetGlNativeWindow((Aspect_Drawable)aQWindow->winId());
+  bool isInitialized = !myView->Window().IsNull()
+                    && myView->Window()->NativeHandle() == aNativeWin
+                    && myView->Window()->DevicePixelRatio() == myDevPixelRatio;
+  if (!isInitialized)
+    isInitialized = initializeGL();
+
+  if (isInitialized)
+  {
+    // execute commands passed from GUI thread
+    myViewCommands.Execute();
+
+    // display parts loaded in background within a few milliseconds per frame
+    if (myModelLoader.DisplayLoadedParts(myContext, myView, 0.005))
+      QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
+
+    // render target is used as is (resized when needed)
+    bool isTargetReady = false;
+    {
+      OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_InitFbo);
+      isTargetReady = OcctGlTools::InitializeGlWindowBuffer(myView, myWinSize);
+    }
+    if (!isTargetReady)
+    {
+      Q_EMIT glCriticalError("Window render target cannot be used by OCCT");
+      isInitialized = false;
+    }
+  }
+
+  if (isInitialized)
+  {
+    if (myGlInfo.UpdateSize(myView)) // cheap, without GL queries
+      Q_EMIT glInfoChanged();
+    if (myToFetchGlInfo.exchange(false)
+     && myGlInfo.UpdateComplete(myView))
+    {
+      Q_EMIT glInfoChanged();
+    }
+
+    // reset global GL state from Qt before redrawing OCCT
+    // (Qt Quick scene graph renders into the same OpenGL context)
+    {
+      OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_ResetGlBefore);
+      OcctGlTools::InvalidateGlState(myView);
+      OcctGlTools::ResetGlStateBeforeOcct(myView);
+    }
+
+    // window buffer content is lost after swap - the whole view is drawn on every window frame,
+    // including frames requested by QML animations
+    {
+      OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_FlushView);
+      myView->Invalidate();
+      AIS_ViewController::FlushViewEvents(myContext, myView, true);
+    }
+
+    // reset global GL state after OCCT before drawing Qt Quick scene
+    {
+      OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_ResetGlAfter);
+#if (QT_VERSION_MAJOR >= 6)
+      // Qt 6 records scene graph into the same render pass right after OCCT
+      // (Qt 5 clears depth and stencil itself) - Qt Quick items should not be clipped by OCCT depth
+      OcctGlTools::ClearGlDepthStencil(myView);
+#endif
+      OcctGlTools::ResetGlStateAfterOcct(myView);
+    }
+  }
+  myFrameTimings.EndFrame();
+#if (QT_VERSION_MAJOR >= 6)
+  aQWindow->endExternalCommands();
+#endif
+}
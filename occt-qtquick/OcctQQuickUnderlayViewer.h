@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Kirill Gavrilov
+
+#ifndef _OcctQQuickUnderlayViewer_HeaderFile
+#define _OcctQQuickUnderlayViewer_HeaderFile
+
+#include "../occt-qt-tools/OcctFrameTimings.h"
+#include "../occt-qt-tools/OcctGlInfo.h"
+#include "../occt-qt-tools/OcctInputLatency.h"
+#include "../occt-qt-tools/OcctInputPredictor.h"
+#include "../occt-qt-tools/OcctQtFrameScheduler.h"
+#include "../occt-qt-tools/OcctQtInputAccumulator.h"
+#include "../occt-qt-tools/OcctQtModelLoader.h"
+#include "../occt-qt-tools/OcctQtTools.h"
+#include "../occt-qt-tools/OcctSharedViewer.h"
+#include "../occt-qt-tools/OcctViewCommandQueue.h"
+
+#include <Standard_WarningsDisable.hxx>
+#include <QColor>
+#include <QMetaObject>
+#include <QQuickItem>
+#include <QUrl>
+#include <QVariantMap>
+#include <Standard_WarningsRestore.hxx>
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_ViewController.hxx>
+#include <Standard_Mutex.hxx>
+#include <V3d_View.hxx>
+
+#include <atomic>
+#include <vector>
+
+class AIS_ViewCube;
+class QQuickWindow;
+class QRunnable;
+
+//! QtQuick item drawing OCCT 3D View directly into the window's framebuffer as an underlay of QML scene.
+//!
+//! Unlike OcctQQuickFramebufferViewer, there is no intermediate FBO sampled by scene graph
+//! and no OCCT offscreen FBO (driver option useSystemBuffer is enabled and MSAA is taken from window surface format):
+//! OCCT is drawn within QQuickWindow::beforeRenderPassRecording() (Qt 6) or QQuickWindow::beforeRendering() (Qt 5)
+//! right into the render target of the window, and QML items are blended on top.
+//! This saves at least one full-screen copy per frame, but the view always covers the whole window -
+//! the item is expected to fill the window (anchors.fill: parent) and serves as input receiver.
+//! Requires OpenGL scene graph backend.
+class OcctQQuickUnderlayViewer : public QQuickItem, public AIS_ViewController
+{
+  Q_OBJECT
+
+  // QML properties
+  Q_PROPERTY(QColor  backgroundColor READ getBackgroundColor WRITE setBackgroundColor)
+  Q_PROPERTY(QString glInfo READ getGlInfo NOTIFY glInfoChanged)
+  Q_PROPERTY(bool    loading READ isLoading NOTIFY loadingChanged)
+  Q_PROPERTY(double  loadingProgress READ getLoadingProgress NOTIFY loadingChanged)
+  Q_PROPERTY(QString loadingStatus READ getLoadingStatus NOTIFY loadingChanged)
+  Q_PROPERTY(QVariantMap frameTimings READ getFrameTimings NOTIFY frameTimingsChanged)
+  Q_PROPERTY(QVariantMap inputLatency READ getInputLatency NOTIFY frameTimingsChanged)
+public:
+  //! Main constructor.
+  OcctQQuickUnderlayViewer(QQuickItem* theParent = nullptr);
+
+  //! Destructor.
+  virtual ~OcctQQuickUnderlayViewer();
+
+  //! Return Viewer.
+  const Handle(V3d_Viewer)& Viewer() const { return myViewer; }
+
+  //! Return View.
+  const Handle(V3d_View)& View() const { return myView; }
+
+  //! Return AIS context.
+  const Handle(AIS_InteractiveContext)& Context() const { return myContext; }
+
+public: // QML accessors
+  //! Return OpenGL info; complete info (including extensions) is fetched on first request.
+  QString getGlInfo();
+
+  //! Return background color.
+  QColor getBackgroundColor() const { return myBackColor; }
+
+  //! Set background color.
+  void setBackgroundColor(const QColor& theColor);
+
+  //! Return TRUE if model is being loaded.
+  bool isLoading() const { return myModelLoader.IsLoading(); }
+
+  //! Return model loading progress in percents.
+  double getLoadingProgress() const { return myLoadingProgress; }
+
+  //! Return model loading status message.
+  const QString& getLoadingStatus() const { return myLoadingStatus; }
+
+  //! Start asynchronous loading of STEP/BREP file replacing displayed shapes;
+  //! parts are displayed progressively as soon as they are meshed.
+  Q_INVOKABLE void openModel(const QUrl& theUrl);
+
+  //! Cancel model loading.
+  Q_INVOKABLE void cancelLoading() { myModelLoader.Cancel(); }
+
+  //! Return timings of the last presented frame as map of phase names to milliseconds
+  //! (including "frame" index and "total" time).
+  QVariantMap getFrameTimings() const;
+
+  //! Return input-to-photon latency of mouse events as map of "p50", "p95", "p99", "max" milliseconds
+  //! and number of "samples".
+  QVariantMap getInputLatency() const;
+
+  //! Return model loader.
+  OcctQtModelLoader& ModelLoader() { return myModelLoader; }
+
+  //! Return per-phase frame timings.
+  const OcctFrameTimings& FrameTimings() const { return myFrameTimings; }
+
+  //! Return input-to-photon latency histogram.
+  OcctInputLatency& InputLatency() { return myInputLatency; }
+
+  //! Return predictor extrapolating dragged pointers to expected presentation time.
+  OcctInputPredictor& InputPredictor() { return myInputPredictor; }
+
+signals:
+  void glInfoChanged();
+  void loadingChanged();
+  void frameTimingsChanged();
+  void glCriticalError(QString theMsg);
+
+protected: // user input events
+  virtual bool event(QEvent* theEvent) override;
+  virtual void keyPressEvent(QKeyEvent* theEvent) override;
+  virtual void mousePressEvent(QMouseEvent* theEvent) override;
+  virtual void mouseReleaseEvent(QMouseEvent* theEvent) override;
+  virtual void mouseMoveEvent(QMouseEvent* theEvent) override;
+  virtual void wheelEvent(QWheelEvent* theEvent) override;
+  virtual void hoverMoveEvent(QHoverEvent* theEvent) override;
+
+  //! Release OCCT viewer within GL rendering thread when item is removed from the window.
+  virtual void releaseResources() override;
+
+private:
+  //! Create a new viewer with a view (not yet bound to OpenGL context).
+  void createViewer();
+
+  //! Detach viewer from the item; returned job releases the view and should be executed
+  //! within GL rendering thread, while OpenGL context of the window is current.
+  QRunnable* detachViewer();
+
+  //! Release the current viewer and replace it with a new one keeping camera and background
+  //! (caller should lock myViewerMutex).
+  //! @param[in] theWindow  window to schedule release job, or NULL to release immediately
+  //!                       (within GL rendering thread with current OpenGL context)
+  void restartViewer(QQuickWindow* theWindow);
+
+  //! Connect to rendering signals of the new window.
+  void handleWindowChanged(QQuickWindow* theWindow);
+
+  //! Synchronize GUI / GL rendering states (rendering thread, GUI thread is blocked).
+  void synchronize();
+
+  //! Redraw the view into window framebuffer before scene graph (rendering thread).
+  void render();
+
+  //! Initialize OCCT view for the window OpenGL context (rendering thread).
+  bool initializeGL();
+
+  //! Fetch and print basic OpenGL info of new OpenGL context.
+  void dumpGlInfo();
+
+  //! Request window redraw from GUI thread through frame scheduler.
+  void updateView();
+
+  //! Handle view redraw.
+  virtual void handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
+
+private:
+  Handle(OcctSharedViewer)       mySharedViewer;
+  Handle(V3d_Viewer)             myViewer;
+  Handle(V3d_View)               myView;
+  Handle(AIS_InteractiveContext) myContext;
+  Handle(AIS_ViewCube)           myViewCube;
+
+  Standard_Mutex         myViewerMutex;  //!< lock for rendering thread (released by destructor)
+  OcctViewCommandQueue   myViewCommands; //!< commands passed from GUI thread to rendering thread
+  OcctQtInputAccumulator myInputAccum;
+  OcctQtFrameScheduler   myFrameScheduler;
+  double                 myNextPresentTime = 0.0; //!< expected presentation time of the frame being rendered
+  OcctFrameTimings       myFrameTimings;
+  OcctInputLatency       myInputLatency;
+  OcctInputPredictor     myInputPredictor;
+
+  std::vector<QMetaObject::Connection> myConnections; //!< connections to signals of the window
+  Graphic3d_Vec2i myWinSize;              //!< window size in pixels (written within synchronization)
+  double          myDevPixelRatio = 1.0;  //!< window device pixel ratio (written within synchronization)
+
+  QColor myBackColor = QColor(0, 0, 0);
+
+  OcctQtModelLoader myModelLoader;
+  double            myLoadingProgress = 0.0;
+  QString           myLoadingStatus;
+
+  OcctGlInfo        myGlInfo;
+  std::atomic<bool> myToFetchGlInfo { false }; //!< complete OpenGL info has been requested by GUI thread
+};
+
+#endif // _OcctQQuickUnderlayViewer_HeaderFile
@@ -1,17 +1,22 @@
 // Copyright (c) 2025 Kirill Gavrilov
 
 #include "OcctQQuickFramebufferViewer.h"
+#include "OcctQQuickTextureViewer.h"
+#include "OcctQQuickUnderlayViewer.h"
 
 #include <Standard_WarningsDisable.hxx>
 #include <QApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QSurfaceFormat>
 #include <Standard_WarningsRestore.hxx>
 
 #include <Message.hxx>
 #include <Standard_Version.hxx>
 
+#include <cstring>
+
 int main(int theNbArgs, char** theArgVec)
 {
   //Message::DefaultMessenger()->Printers().First()->SetTraceLevel(Message_Trace);
@@ -33,6 +38,22 @@ int main(int theNbArgs, char** theArgVec)
     aQsgLoop.Build();
   }*/
 
+  // viewer item: "fbo" (QQuickFramebufferObject, default),
+  // "underlay" (--underlay, OCCT drawn directly into window framebuffer)
+  // or "texture" (--threaded, OCCT drawn on its own thread into a ring of textures)
+  QString aViewerMode = "fbo";
+  for (int anArgIter = 1; anArgIter < theNbArgs; ++anArgIter)
+  {
+    if (strcmp(theArgVec[anArgIter], "--underlay") == 0)
+      aViewerMode = "underlay";
+    else if (strcmp(theArgVec[anArgIter], "--threaded") == 0)
+      aViewerMode = "texture";
+  }
+#if (QT_VERSION_MAJOR >= 6)
+  // all viewer items require OpenGL scene graph backend (Qt6 might pick Direct3D/Vulkan/Metal by default)
+  QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGL);
+#endif
+
   QApplication aQApp(theNbArgs, theArgVec);
 
   QCoreApplication::setApplicationName("OCCT Qt/QtQuick Viewer sample");
@@ -40,10 +61,13 @@ int main(int theNbArgs, char** theArgVec)
   QCoreApplication::setApplicationVersion(OCC_VERSION_STRING_EXT);
 
   qmlRegisterType<OcctQQuickFramebufferViewer>("OcctQQuickFramebufferViewer", 1, 0, "OcctQQuickFramebufferViewer");
+  qmlRegisterType<OcctQQuickUnderlayViewer>   ("OcctQQuickFramebufferViewer", 1, 0, "OcctQQuickUnderlayViewer");
+  qmlRegisterType<OcctQQuickTextureViewer>    ("OcctQQuickFramebufferViewer", 1, 0, "OcctQQuickTextureViewer");
 
   QQmlApplicationEngine aQmlEngine;
   aQmlEngine.rootContext()->setContextProperty("QT_VERSION_STR", QString(QT_VERSION_STR));
   aQmlEngine.rootContext()->setContextProperty("OCC_VERSION_STRING_EXT", QString(OCC_VERSION_STRING_EXT));
+  aQmlEngine.rootContext()->setContextProperty("OCCT_VIEWER_MODE", aViewerMode);
 #if (QT_VERSION_MAJOR >= 6)
   aQmlEngine.load(QUrl(QStringLiteral("qrc:/main6.qml")));
 #else
@@ -16,17 +16,44 @@ ApplicationWindow {
   width:  720
   height: 480
 
-  // OCCT 3D Viewer item
-  OcctQQuickFramebufferViewer {
-    id: occt_view
+  // underlay viewer draws into window framebuffer before QML items - window background should not hide it
+  Component.onCompleted: if (OCCT_VIEWER_MODE === "underlay") { background = null; }
+
+  // OCCT 3D Viewer item (offscreen FBO, window underlay or texture rendered by OCCT thread)
+  readonly property var occt_view: occt_loader.item
+  Loader {
+    id: occt_loader
     anchors.fill: parent
     focus: true // to accept keyboard events
+    sourceComponent: OCCT_VIEWER_MODE === "underlay" ? occt_underlay_comp
+                   : (OCCT_VIEWER_MODE === "texture" ? occt_texture_comp : occt_fbo_comp)
+  }
+  Component {
+    id: occt_fbo_comp
+    OcctQQuickFramebufferViewer { focus: true }
+  }
+  Component {
+    id: occt_underlay_comp
+    OcctQQuickUnderlayViewer { focus: true }
+  }
+  Component {
+    id: occt_texture_comp
+    OcctQQuickTextureViewer { focus: true }
   }
 
   // Main menu bar
   MenuBar {
     Menu {
       title: qsTr("&File")
+      MenuItem {
+        text: qsTr("&Open...")
+        onTriggered: dlg_open.open();
+      }
+      MenuItem {
+        text: qsTr("&Cancel Loading")
+        enabled: occt_view.loading
+        onTriggered: occt_view.cancelLoading();
+      }
       MenuItem {
         text: qsTr("&Quit")
         onTriggered: Qt.quit();
@@ -48,6 +75,21 @@ ApplicationWindow {
     onMoved: occt_view.backgroundColor = Qt.rgba(value/255.0, value/255.0, value/255.0);
   }
 
+  // Model loading progress
+  ProgressBar {
+    id: bar_loading
+    anchors.bottom:       btn_about.top
+    anchors.bottomMargin: 5
+    anchors.left:         parent.left
+    anchors.leftMargin:   20
+    anchors.right:        parent.right
+    anchors.rightMargin:  20
+    visible: occt_view.loading
+    from:  0
+    to:    100
+    value: occt_view.loadingProgress
+  }
+
   // About button
   Rectangle {
     id: btn_about
@@ -83,6 +125,14 @@ ApplicationWindow {
     text:  qsTr("OCCT 3D Viewer sample embedded into QtQuick/QML.")
     informativeText: "Open CASCADE Technology v." + OCC_VERSION_STRING_EXT + "\n"
                    + "Qt v." + QT_VERSION_STR + "\n"
-                   + "\nOpenGL info:\n" + occt_view.glInfo;
+                   + "\nOpenGL info:\n" + (visible ? occt_view.glInfo : ""); // complete info is fetched on first read
+  }
+
+  // Open model dialog
+  FileDialog {
+    id: dlg_open
+    title: qsTr("Open Model")
+    nameFilters: [ "Models (*.step *.stp *.brep *.rle)", "All files (*)" ]
+    onAccepted: occt_view.openModel(selectedFile);
   }
 }
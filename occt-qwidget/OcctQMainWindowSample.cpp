@@ -8,21 +8,25 @@
 
 #include <Standard_WarningsDisable.hxx>
 #include <QAction>
+#include <QFileDialog>
 #include <QLabel>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QVBoxLayout>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QSlider>
+#include <QStatusBar>
 #include <Standard_WarningsRestore.hxx>
 
 // ================================================================
 // Function : OcctQMainWindowSample
 // ================================================================
-OcctQMainWindowSample::OcctQMainWindowSample()
+OcctQMainWindowSample::OcctQMainWindowSample(bool theIsThreaded)
 {
   // 3D Viewer widget as a central widget
   myViewer = new OcctQWidgetViewer();
+  myViewer->SetThreadedRendering(theIsThreaded);
   setCentralWidget(myViewer);
 
   // menu bar
@@ -30,6 +34,9 @@ OcctQMainWindowSample::OcctQMainWindowSample()
 
   // some controls on top of 3D Viewer
   createLayoutOverViewer();
+
+  // model loading progress
+  createStatusBar();
 }
 
 // ================================================================
@@ -39,6 +46,18 @@ void OcctQMainWindowSample::createMenuBar()
 {
   QMenuBar* aMenuBar    = new QMenuBar();
   QMenu*    aMenuWindow = aMenuBar->addMenu("&File");
+  {
+    QAction* anActionOpen = new QAction(aMenuWindow);
+    anActionOpen->setText("Open...");
+    aMenuWindow->addAction(anActionOpen);
+    connect(anActionOpen, &QAction::triggered, [this]() { openModel(); });
+  }
+  {
+    QAction* anActionCancel = new QAction(aMenuWindow);
+    anActionCancel->setText("Cancel Loading");
+    aMenuWindow->addAction(anActionCancel);
+    connect(anActionCancel, &QAction::triggered, [this]() { myViewer->ModelLoader().Cancel(); });
+  }
 #if (OCC_VERSION_HEX >= 0x070700)
   {
     QAction* anActionSplit = new QAction(aMenuWindow);
@@ -104,17 +123,19 @@ void OcctQMainWindowSample::createLayoutOverViewer()
       connect(aSlider, &QSlider::valueChanged, [this](int theValue) {
         const float          aVal = theValue / 255.0f;
         const Quantity_Color aColor(aVal, aVal, aVal, Quantity_TOC_sRGB);
+        // view is modified right before redraw (by OCCT thread in threaded mode)
+        myViewer->PushViewCommand([this, aColor]() {
 #if (OCC_VERSION_HEX >= 0x070700)
-        for (const Handle(V3d_View)& aSubviewIter : myViewer->View()->Subviews())
-        {
-          aSubviewIter->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
-          aSubviewIter->Invalidate();
-        }
+          for (const Handle(V3d_View)& aSubviewIter : myViewer->View()->Subviews())
+          {
+            aSubviewIter->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
+            aSubviewIter->Invalidate();
+          }
 #endif
-        // myViewer->View()->SetBackgroundColor(aColor);
-        myViewer->View()->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
-        myViewer->View()->Invalidate();
-        myViewer->update();
+          // myViewer->View()->SetBackgroundColor(aColor);
+          myViewer->View()->SetBgGradientColors(aColor, Quantity_NOC_BLACK, Aspect_GradientFillMethod_Elliptical);
+          myViewer->View()->Invalidate();
+        });
       });
     }
 
@@ -122,11 +143,60 @@ void OcctQMainWindowSample::createLayoutOverViewer()
   }
 }
 
+// ================================================================
+// Function : createStatusBar
+// ================================================================
+void OcctQMainWindowSample::createStatusBar()
+{
+  myProgressBar = new QProgressBar();
+  myProgressBar->setRange(0, 100);
+  myProgressBar->setVisible(false);
+  statusBar()->addPermanentWidget(myProgressBar);
+
+  // loader signals are emitted from working threads and queued to GUI thread
+  OcctQtModelLoader* aLoader = &myViewer->ModelLoader();
+  connect(aLoader, &OcctQtModelLoader::progressChanged, this, [this](double thePercent, const QString& theStep) {
+    myProgressBar->setVisible(true);
+    myProgressBar->setValue(int(thePercent));
+    statusBar()->showMessage(theStep);
+  });
+  connect(aLoader, &OcctQtModelLoader::loadingFinished, this, [this](bool , const QString& theMessage) {
+    myProgressBar->setVisible(false);
+    statusBar()->showMessage(theMessage, 10000);
+  });
+}
+
+// ================================================================
+// Function : openModel
+// ================================================================
+void OcctQMainWindowSample::openModel()
+{
+  const QString aFilePath = QFileDialog::getOpenFileName(this, "Open Model", QString(),
+                                                         "Models (*.step *.stp *.brep *.rle);;All files (*)");
+  if (aFilePath.isEmpty())
+    return;
+
+  myProgressBar->setValue(0);
+  myProgressBar->setVisible(true);
+  myViewer->OpenModel(aFilePath);
+}
+
 // ================================================================
 // Function : splitSubviews
 // ================================================================
 void OcctQMainWindowSample::splitSubviews()
 {
+#if (OCC_VERSION_HEX >= 0x070700)
+  // view is modified right before redraw (by OCCT thread in threaded mode)
+  myViewer->PushViewCommand([this]() { splitSubviewsNow(); });
+#endif
+}
+
+// ================================================================
+// Function : splitSubviewsNow
+// ================================================================
+void OcctQMainWindowSample::splitSubviewsNow()
+{
 #if (OCC_VERSION_HEX >= 0x070700)
   if (!myViewer->View()->Subviews().IsEmpty())
   {
@@ -160,6 +230,5 @@ void OcctQMainWindowSample::splitSubviews()
     myViewer->OnSubviewChanged(myViewer->Context(), nullptr, aSubView1);
   }
   myViewer->View()->Invalidate();
-  myViewer->update();
 #endif
 }
@@ -7,6 +7,7 @@
 #include <QMainWindow>
 #include <Standard_WarningsRestore.hxx>
 
+class QProgressBar;
 class OcctQWidgetViewer;
 
 //! Main window for sample application holding OCCT 3D Viewer.
@@ -14,7 +15,8 @@ class OcctQMainWindowSample : public QMainWindow
 {
 public:
   //! Window constructor.
-  OcctQMainWindowSample();
+  //! @param[in] theIsThreaded  render OCCT 3D Viewer on a dedicated thread
+  OcctQMainWindowSample(bool theIsThreaded = false);
 
 private:
   //! Define menu bar with Quit item.
@@ -23,11 +25,21 @@ private:
   //! Define controls over 3D viewer.
   void createLayoutOverViewer();
 
+  //! Define status bar with model loading progress.
+  void createStatusBar();
+
+  //! Ask user for a model file and start its loading.
+  void openModel();
+
   //! Advanced method splitting 3D Viewer into sub-views.
   void splitSubviews();
 
+  //! Split 3D Viewer into sub-views or remove them (called right before redraw).
+  void splitSubviewsNow();
+
 private:
-  OcctQWidgetViewer* myViewer = nullptr;
+  OcctQWidgetViewer* myViewer      = nullptr;
+  QProgressBar*      myProgressBar = nullptr;
 };
 
 #endif // _OcctQMainWindowSample_HeaderFile
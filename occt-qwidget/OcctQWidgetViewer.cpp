@@ -9,11 +9,13 @@
 
 #include "../occt-qt-tools/OcctQtTools.h"
 #include "../occt-qt-tools/OcctGlTools.h"
+#include "../occt-qt-tools/OcctTessellator.h"
 
 #include <Standard_WarningsDisable.hxx>
 #include <QApplication>
 #include <QMessageBox>
 #include <QMouseEvent>
+#include <QThread>
 #include <Standard_WarningsRestore.hxx>
 
 #include <AIS_Shape.hxx>
@@ -37,20 +39,32 @@ typedef Aspect_DisplayConnection Xw_DisplayConnection;
 // Function : OcctQWidgetViewer
 // ================================================================
 OcctQWidgetViewer::OcctQWidgetViewer(QWidget* theParent)
-    : QWidget(theParent)
+    : OcctQWidgetViewer(CreateSharedViewer(), theParent)
+{
+  //
+}
+
+// ================================================================
+// Function : CreateSharedViewer
+// ================================================================
+Handle(OcctSharedViewer) OcctQWidgetViewer::CreateSharedViewer()
 {
   Handle(Aspect_DisplayConnection) aDisp   = new Xw_DisplayConnection();
   Handle(OpenGl_GraphicDriver)     aDriver = new OpenGl_GraphicDriver(aDisp, false);
+  return new OcctSharedViewer(aDriver);
+}
 
-  // create viewer
-  myViewer = new V3d_Viewer(aDriver);
-  myViewer->SetDefaultBackgroundColor(Quantity_NOC_BLACK);
-  myViewer->SetDefaultLights();
-  myViewer->SetLightOn();
-  myViewer->ActivateGrid(Aspect_GT_Rectangular, Aspect_GDM_Lines);
-
-  // create AIS context
-  myContext = new AIS_InteractiveContext(myViewer);
+// ================================================================
+// Function : OcctQWidgetViewer
+// ================================================================
+OcctQWidgetViewer::OcctQWidgetViewer(const Handle(OcctSharedViewer)& theSharedViewer, QWidget* theParent)
+    : QWidget(theParent),
+      mySharedViewer(theSharedViewer)
+{
+  // viewer and context are shared with other widgets (if any);
+  // OpenGL contexts created by OCCT for views of the same driver share resources
+  myViewer  = mySharedViewer->Viewer();
+  myContext = mySharedViewer->Context();
 
   myViewCube = new AIS_ViewCube();
   myViewCube->SetViewAnimation(myViewAnimation);
@@ -62,12 +76,18 @@ OcctQWidgetViewer::OcctQWidgetViewer(QWidget* theParent)
   myView = myViewer->CreateView();
   myView->SetImmediateUpdate(false);
 #ifndef __APPLE__
-  myView->ChangeRenderingParams().NbMsaaSamples = 4; // warning - affects performance
+  myView->ChangeRenderingParams().NbMsaaSamples = 4; // warning - affects performance (disabled during interaction)
 #endif
   myView->ChangeRenderingParams().ToShowStats = true;
   // NOLINTNEXTLINE
   myView->ChangeRenderingParams().CollectedStats = (Graphic3d_RenderingParams::PerfCounters)(
     Graphic3d_RenderingParams::PerfCounters_FrameRate | Graphic3d_RenderingParams::PerfCounters_Triangles);
+  mySharedViewer->AddView(myView, myViewCube, [this]() { updateView(); });
+
+  // input events are stamped to measure input-to-photon latency,
+  // while dragged pointers are extrapolated to expected presentation time
+  myInputAccum.SetInputLatency(&myInputLatency);
+  myInputAccum.SetInputPredictor(&myInputPredictor);
 
   // Qt widget setup
   setAttribute(Qt::WA_PaintOnScreen);
@@ -79,7 +99,23 @@ OcctQWidgetViewer::OcctQWidgetViewer(QWidget* theParent)
   setFocusPolicy(Qt::StrongFocus);     // set focus policy to threat QContextMenuEvent from keyboard
   setUpdatesEnabled(true);
 
-  initializeGL();
+  // redraw requests are throttled by presentation of previous frame
+  connect(&myFrameScheduler, &OcctQtFrameScheduler::frameRequested, this, [this]()
+  {
+    if (myIsThreaded)
+      requestOcctFrame();
+    else
+      QWidget::update();
+  });
+
+  // full quality is restored by redrawing idle view
+  myLodTimer.setSingleShot(true);
+  connect(&myLodTimer, &QTimer::timeout, this, [this]() { updateView(); });
+
+  // loaded parts are displayed by paintEvent() or by OCCT thread
+  connect(&myModelLoader, &OcctQtModelLoader::partsLoaded, this, [this]() { updateView(); });
+
+  // note - OpenGL is initialized by the first frame within GUI thread or OCCT thread
 }
 
 // ================================================================
@@ -87,14 +123,23 @@ OcctQWidgetViewer::OcctQWidgetViewer(QWidget* theParent)
 // ================================================================
 OcctQWidgetViewer::~OcctQWidgetViewer()
 {
+  // stop background loading
+  myModelLoader.Cancel();
+
+  // stop OCCT thread, which releases OCCT view within its OpenGL context
+  myRenderThread.Stop();
+  if (myView.IsNull())
+    return;
+
   Handle(Aspect_DisplayConnection) aDisp = myViewer->Driver()->GetDisplayConnection();
 
-  // release OCCT viewer
-  myContext->RemoveAll(false);
+  // release OCCT view; shared viewer is released with the last view
+  myResolutionScaler.Release(myView);
+  mySharedViewer->RemoveView(myView);
   myContext.Nullify();
-  myView->Remove();
   myView.Nullify();
   myViewer.Nullify();
+  mySharedViewer.Nullify();
 
   aDisp.Nullify();
 }
@@ -107,13 +152,21 @@ bool OcctQWidgetViewer::event(QEvent* theEvent)
   if (myView.IsNull())
     return QWidget::event(theEvent);
 
+  if (theEvent->type() == QEvent::UpdateLater)
+  {
+    updateView();
+    theEvent->accept();
+    return true;
+  }
+
   if (theEvent->type() == QEvent::TouchBegin
    || theEvent->type() == QEvent::TouchUpdate
    || theEvent->type() == QEvent::TouchEnd)
   {
     theEvent->accept();
     myHasTouchInput = true;
-    if (OcctQtTools::qtHandleTouchEvent(*this, myView, static_cast<QTouchEvent*>(theEvent)))
+    std::lock_guard<std::mutex> anInputLock(myInputMutex);
+    if (OcctQtTools::qtHandleTouchEvent(*this, devicePixelRatioF(), static_cast<QTouchEvent*>(theEvent), &myInputLatency, &myInputPredictor))
       updateView();
 
     return true;
@@ -148,8 +201,7 @@ void OcctQWidgetViewer::keyPressEvent(QKeyEvent* theEvent)
     }
     case Aspect_VKey_F:
     {
-      myView->FitAll(0.01, false);
-      update();
+      PushViewCommand([this]() { myView->FitAll(0.01, false); });
       theEvent->accept();
       return;
     }
@@ -170,7 +222,7 @@ void OcctQWidgetViewer::mousePressEvent(QMouseEvent* theEvent)
     return; // skip mouse events emulated by system from screen touches
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
@@ -184,7 +236,7 @@ void OcctQWidgetViewer::mouseReleaseEvent(QMouseEvent* theEvent)
     return;
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
@@ -201,7 +253,7 @@ void OcctQWidgetViewer::mouseMoveEvent(QMouseEvent* theEvent)
     return; // skip mouse events emulated by system from screen touches
 
   theEvent->accept();
-  if (OcctQtTools::qtHandleMouseEvent(*this, myView, theEvent))
+  if (myInputAccum.AddMouseEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
@@ -221,9 +273,21 @@ void OcctQWidgetViewer::wheelEvent(QWheelEvent* theEvent)
 #else
   const Graphic3d_Vec2d aPnt2d(theEvent->pos().x(), theEvent->pos().y());
 #endif
-  const Graphic3d_Vec2i aPnt2i(myView->Window()->ConvertPointToBacking(aPnt2d) + Graphic3d_Vec2d(0.5));
-  if (!myView->Subviews().IsEmpty())
+  if (myIsThreaded)
+  {
+    // subviews are owned by OCCT thread - switch input focus right before the wheel event is handled
+    const Graphic3d_Vec2i aPnt2i(aPnt2d * devicePixelRatioF() + Graphic3d_Vec2d(0.5));
+    PushViewCommand([this, aPnt2i]()
+    {
+      Handle(V3d_View) aPickedView = !myView->Subviews().IsEmpty() ? myView->PickSubview(aPnt2i) : Handle(V3d_View)();
+      if (!aPickedView.IsNull() && aPickedView != myFocusView)
+        OnSubviewChanged(myContext, myFocusView, aPickedView);
+    });
+  }
+  else if (!myView->Window().IsNull()
+        && !myView->Subviews().IsEmpty())
   {
+    const Graphic3d_Vec2i aPnt2i(myView->Window()->ConvertPointToBacking(aPnt2d) + Graphic3d_Vec2d(0.5));
     Handle(V3d_View) aPickedView = myView->PickSubview(aPnt2i);
     if (!aPickedView.IsNull() && aPickedView != myFocusView)
     {
@@ -235,17 +299,66 @@ void OcctQWidgetViewer::wheelEvent(QWheelEvent* theEvent)
   }
 #endif
 
-  if (OcctQtTools::qtHandleWheelEvent(*this, myView, theEvent))
+  if (myInputAccum.AddWheelEvent(devicePixelRatioF(), theEvent))
     updateView();
 }
 
+// ================================================================
+// Function : OpenModel
+// ================================================================
+bool OcctQWidgetViewer::OpenModel(const QString& theFilePath)
+{
+  myModelLoader.Cancel();
+  PushViewCommand([this]() { mySharedViewer->RemoveModel(); });
+  return myModelLoader.Load(theFilePath);
+}
+
+// ================================================================
+// Function : SetThreadedRendering
+// ================================================================
+bool OcctQWidgetViewer::SetThreadedRendering(bool theToEnable)
+{
+  if (myIsThreaded == theToEnable)
+    return true;
+
+  if (myRenderThread.isRunning()
+  || !myView->Window().IsNull())
+  {
+    Message::SendWarning() << "Warning: threaded rendering should be set before showing the widget";
+    return false;
+  }
+  else if (theToEnable
+        && mySharedViewer->NbViews() > 1)
+  {
+    Message::SendWarning() << "Warning: threaded rendering is not supported for a viewer shared with other widgets";
+    return false;
+  }
+
+  myIsThreaded = theToEnable;
+  return true;
+}
+
+// ================================================================
+// Function : PushViewCommand
+// ================================================================
+void OcctQWidgetViewer::PushViewCommand(const OcctViewCommandQueue::Command& theCommand)
+{
+  myViewCommands.Push(theCommand);
+  updateView();
+}
+
 // =======================================================================
 // function : updateView
 // =======================================================================
 void OcctQWidgetViewer::updateView()
 {
-  QWidget::update();
-  // if (window() != NULL) { window()->update(); }
+  if (QThread::currentThread() != thread())
+  {
+    // frame scheduler lives in GUI thread
+    QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateLater));
+    return;
+  }
+  myFrameScheduler.RequestFrame();
 }
 
 // ================================================================
@@ -253,8 +366,47 @@ void OcctQWidgetViewer::updateView()
 // ================================================================
 void OcctQWidgetViewer::resizeEvent(QResizeEvent* )
 {
-  if (!myView.IsNull())
-    myView->MustBeResized();
+  // view is resized by the next frame
+  updateView();
+}
+
+// ================================================================
+// Function : viewSize
+// ================================================================
+Graphic3d_Vec2i OcctQWidgetViewer::viewSize() const
+{
+  const QRect  aRect        = rect();
+  const double aDevPixRatio = devicePixelRatioF();
+  return Graphic3d_Vec2i(Graphic3d_Vec2d(Round((aRect.right() - aRect.left()) * aDevPixRatio),
+                                         Round((aRect.bottom() - aRect.top()) * aDevPixRatio)));
+}
+
+// ================================================================
+// Function : contextLazyMoveTo
+// ================================================================
+void OcctQWidgetViewer::contextLazyMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                                          const Handle(V3d_View)& theView,
+                                          const Graphic3d_Vec2i& thePnt)
+{
+  // click selects detected owner right after this call, so that its detection cannot be skipped
+  const bool isClickPending = myGL.Selection.Tool == AIS_ViewSelectionTool_Picking
+                          && !myGL.Selection.Points.IsEmpty();
+  if (!myHoverThrottle.ToDetect(thePnt, theView, mySharedViewer->SceneRevision(), isClickPending))
+    return;
+
+  // base implementation skips the same point, while detection is also needed on camera change
+  myPrevMoveTo.SetValues(-1, -1);
+  AIS_ViewController::contextLazyMoveTo(theCtx, theView, thePnt);
+}
+
+// ================================================================
+// Function : OnSelectionChanged
+// ================================================================
+void OcctQWidgetViewer::OnSelectionChanged(const Handle(AIS_InteractiveContext)& ,
+                                           const Handle(V3d_View)& )
+{
+  // selection is highlighted within all views of shared viewer
+  mySharedViewer->InvalidateViews(myView);
 }
 
 // ================================================================
@@ -262,9 +414,40 @@ void OcctQWidgetViewer::resizeEvent(QResizeEvent* )
 // ================================================================
 void OcctQWidgetViewer::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)
 {
+  // animate camera for expected presentation time of this frame
+  myFrameScheduler.SyncAnimationTimer(myViewAnimation,
+                                      myIsThreaded ? myFramePresentTime : myFrameScheduler.NextPresentationTime());
+
+  // degrade quality while camera moves; viewer-level settings are kept for views of shared viewer
+  myInteractionLod.SetViewerShared(mySharedViewer->NbViews() > 1);
+  const bool wasDegraded = myInteractionLod.IsDegraded();
+  double aRedrawDelay = myInteractionLod.Update(*this, theCtx, theView);
+  if (myInteractionLod.IsDegraded() != wasDegraded)
+    mySharedViewer->InvalidateScene(); // display modes might have been switched
+
+  // perform dynamic highlighting postponed by rate cap or invalidated by scene modification
+  myHoverThrottle.CheckSceneRevision(mySharedViewer->SceneRevision());
+  const double aHoverDelay = myHoverThrottle.PendingDelay();
+  if (aHoverDelay == 0.0)
+    contextLazyMoveTo(theCtx, theView, myHoverThrottle.PendingPoint());
+  else if (aHoverDelay > 0.0)
+    aRedrawDelay = aRedrawDelay >= 0.0 ? std::min(aRedrawDelay, aHoverDelay) : aHoverDelay;
+
+  // reduce resolution during interaction to hold frame time budget
+  const double aScaleDelay = myResolutionScaler.Update(theView);
+  if (aScaleDelay >= 0.0)
+    aRedrawDelay = aRedrawDelay >= 0.0 ? std::min(aRedrawDelay, aScaleDelay) : aScaleDelay;
+  myResolutionScaler.BeginFrame(theView);
   AIS_ViewController::handleViewRedraw(theCtx, theView);
+  myResolutionScaler.EndFrame(theView);
   if (myToAskNextFrame)
     updateView(); // ask more frames for animation
+
+  if (aRedrawDelay >= 0.0)
+  {
+    // timer lives in GUI thread
+    QMetaObject::invokeMethod(&myLodTimer, "start", Qt::AutoConnection, Q_ARG(int, int(aRedrawDelay * 1000.0) + 1));
+  }
 }
 
 #if (OCC_VERSION_HEX >= 0x070700)
@@ -282,41 +465,44 @@ void OcctQWidgetViewer::OnSubviewChanged(const Handle(AIS_InteractiveContext)&,
 // ================================================================
 // Function : dumpGlInfo
 // ================================================================
-void OcctQWidgetViewer::dumpGlInfo(bool theIsBasic, bool theToPrint)
+void OcctQWidgetViewer::dumpGlInfo()
+{
+  // basic info is fetched once per OpenGL context, while complete one - on demand
+  myGlInfo.Invalidate();
+  myGlInfo.UpdateBasic(myView);
+  myGlInfo.UpdateSize(myView);
+  Message::SendInfo(myGlInfo.Text());
+}
+
+// ================================================================
+// Function : getGlInfo
+// ================================================================
+QString OcctQWidgetViewer::getGlInfo()
 {
-  TColStd_IndexedDataMapOfStringString aGlCapsDict;
-  myView->DiagnosticInformation(aGlCapsDict,
-                                theIsBasic ? Graphic3d_DiagnosticInfo_Basic : Graphic3d_DiagnosticInfo_Complete);
-  TCollection_AsciiString anInfo;
-  for (TColStd_IndexedDataMapOfStringString::Iterator aValueIter(aGlCapsDict); aValueIter.More(); aValueIter.Next())
+  if (myIsThreaded)
   {
-    if (!aValueIter.Value().IsEmpty())
+    // extensions list is queried within OCCT thread, so that it is shown by the next request
+    if (!myGlInfo.HasComplete() && myGlInfo.HasBasic())
     {
-      if (!anInfo.IsEmpty())
-        anInfo += "\n";
-
-      anInfo += aValueIter.Key() + ": " + aValueIter.Value();
+      myToFetchGlInfo = true;
+      updateView();
     }
+    return QString::fromUtf8(myGlInfo.Text().ToCString());
   }
 
-  if (theToPrint)
-    Message::SendInfo(anInfo);
-
-  myGlInfo = QString::fromUtf8(anInfo.ToCString());
+  if (!myGlInfo.HasComplete() && !myView->Window().IsNull())
+  {
+    // extensions list is queried only when info is actually requested
+    myGlInfo.UpdateComplete(myView);
+  }
+  return QString::fromUtf8(myGlInfo.Text().ToCString());
 }
 
 // ================================================================
 // Function : initializeGL
 // ================================================================
-void OcctQWidgetViewer::initializeGL()
+void OcctQWidgetViewer::initializeGL(const Graphic3d_Vec2i& theSize, double theDevPixelRatio, Aspect_Drawable theNativeWin)
 {
-  const QRect  aRect        = rect();
-  const double aDevPixRatio = devicePixelRatioF();
-  const Graphic3d_Vec2i aViewSize(Graphic3d_Vec2d(Round((aRect.right() - aRect.left()) * aDevPixRatio),
-                                                  Round((aRect.bottom() - aRect.top()) * aDevPixRatio)));
-
-  const Aspect_Drawable aNativeWin = (Aspect_Drawable)winId();
-
   Handle(OcctGlTools::OcctNeutralWindow) aWindow = Handle(OcctGlTools::OcctNeutralWindow)::DownCast(myView->Window());
   const bool isFirstInit = aWindow.IsNull();
   if (aWindow.IsNull())
@@ -324,11 +510,13 @@ void OcctQWidgetViewer::initializeGL()
     aWindow = new OcctGlTools::OcctNeutralWindow();
     aWindow->SetVirtual(true);
   }
-  aWindow->SetNativeHandle(aNativeWin);
-  aWindow->SetSize(aViewSize.x(), aViewSize.y());
-  aWindow->SetDevicePixelRatio(aDevPixRatio);
-  myView->SetWindow(aWindow);
-  dumpGlInfo(true, true);
+  aWindow->SetNativeHandle(theNativeWin);
+  aWindow->SetSize(theSize.x(), theSize.y());
+  aWindow->SetDevicePixelRatio(theDevPixelRatio);
+  myView->SetWindow(aWindow); // OpenGL context is created and bound to the calling thread
+  OcctGlTools::InvalidateGlState(myView); // nothing is known about GL state of the new context
+  dumpGlInfo();
+  myResolutionScaler.SetDevicePixelRatio(theDevPixelRatio);
 #if (OCC_VERSION_HEX >= 0x070700)
   for (const Handle(V3d_View)& aSubviewIter : myView->Subviews())
   {
@@ -339,62 +527,218 @@ void OcctQWidgetViewer::initializeGL()
 
   if (isFirstInit)
   {
-    myContext->Display(myViewCube, 0, 0, false);
+    mySharedViewer->DisplayViewCube(myView);
+    if (!mySharedViewer->ToDisplaySampleModel())
+      return;
 
     // dummy shape for testing
     TopoDS_Shape      aBox   = BRepPrimAPI_MakeBox(100.0, 50.0, 90.0).Shape();
+    OcctTessellator().MeshPart(aBox);
     Handle(AIS_Shape) aShape = new AIS_Shape(aBox);
     myContext->Display(aShape, AIS_Shaded, 0, false);
   }
 }
 
 // ================================================================
-// Function : paintEvent
+// Function : prepareWindow
 // ================================================================
-void OcctQWidgetViewer::paintEvent(QPaintEvent* )
+void OcctQWidgetViewer::prepareWindow(const Graphic3d_Vec2i& theSize, double theDevPixelRatio, Aspect_Drawable theNativeWin)
 {
-  if (myView.IsNull() || myView->Window().IsNull())
+  if (myView->Window().IsNull())
+  {
+    initializeGL(theSize, theDevPixelRatio, theNativeWin);
     return;
+  }
 
   const double aDevPixelRatioOld = myView->Window()->DevicePixelRatio();
-  const double aDevPixelRatioNew   = devicePixelRatioF();
-  if (myView->Window()->NativeHandle() != (Aspect_Drawable)winId())
+  if (myView->Window()->NativeHandle() != theNativeWin)
   {
     // workaround window recreation done by Qt on monitor (QScreen) disconnection
     Message::SendWarning() << "Native window handle has changed by QWidget!";
-    initializeGL();
+    initializeGL(theSize, theDevPixelRatio, theNativeWin);
+    return;
   }
-  else if (aDevPixelRatioNew != aDevPixelRatioOld)
+  else if (theDevPixelRatio != aDevPixelRatioOld)
   {
-    initializeGL();
+    initializeGL(theSize, theDevPixelRatio, theNativeWin);
+    return;
   }
-  else
-  {
-    Graphic3d_Vec2i aViewSizeOld; myView->Window()->Size(aViewSizeOld.x(), aViewSizeOld.y());
 
-    const QRect     aRect = rect();
-    Graphic3d_Vec2i aViewSizeNew(Graphic3d_Vec2d(Round((aRect.right() - aRect.left()) * aDevPixelRatioNew),
-                                                 Round((aRect.bottom() - aRect.top()) * aDevPixelRatioNew)));
-    if (aViewSizeNew != aViewSizeOld)
-    {
-      Handle(OcctGlTools::OcctNeutralWindow) aWindow = Handle(OcctGlTools::OcctNeutralWindow)::DownCast(myView->Window());
-      aWindow->SetSize(aViewSizeNew.x(), aViewSizeNew.y());
-      myView->MustBeResized();
-      myView->Invalidate();
-      dumpGlInfo(true, false);
+  Graphic3d_Vec2i aViewSizeOld; myView->Window()->Size(aViewSizeOld.x(), aViewSizeOld.y());
+  if (theSize == aViewSizeOld)
+    return;
+
+  Handle(OcctGlTools::OcctNeutralWindow) aWindow = Handle(OcctGlTools::OcctNeutralWindow)::DownCast(myView->Window());
+  aWindow->SetSize(theSize.x(), theSize.y());
+  myView->MustBeResized();
+  myView->Invalidate();
+  myGlInfo.UpdateSize(myView); // cheap, without GL queries
 
 #if (OCC_VERSION_HEX >= 0x070700)
-      for (const Handle(V3d_View)& aSubviewIter : myView->Subviews())
-      {
-        aSubviewIter->MustBeResized();
-        aSubviewIter->Invalidate();
-      }
+  for (const Handle(V3d_View)& aSubviewIter : myView->Subviews())
+  {
+    aSubviewIter->MustBeResized();
+    aSubviewIter->Invalidate();
+  }
 #endif
+}
+
+// ================================================================
+// Function : paintEvent
+// ================================================================
+void OcctQWidgetViewer::paintEvent(QPaintEvent* )
+{
+  if (myView.IsNull())
+    return;
+
+  if (myIsThreaded)
+  {
+    // OCCT thread presents frames on its own - just ask a new one on expose
+    if (!myRenderThread.isRunning())
+      myRenderThread.Start(this);
+
+    updateView();
+    return;
+  }
+
+  myFrameScheduler.FrameStarted();
+  myFrameTimings.BeginFrame();
+
+  prepareWindow(viewSize(), devicePixelRatioF(), (Aspect_Drawable)winId());
+  redrawView();
+  myFrameTimings.EndFrame();
+
+  // buffers have been swapped by OCCT
+  myInputLatency.FramePresented();
+  myFrameScheduler.FramePresented();
+}
+
+// ================================================================
+// Function : redrawView
+// ================================================================
+void OcctQWidgetViewer::redrawView()
+{
+  // execute commands passed from GUI thread
+  if (myViewCommands.Swap())
+  {
+    myViewCommands.Execute();
+    mySharedViewer->InvalidateScene(); // commands might display or remove objects
+  }
+
+  // display parts loaded in background within a few milliseconds per frame
+  const size_t aNbDisplayedOld = myModelLoader.NbDisplayed();
+  if (myModelLoader.DisplayLoadedParts(myContext, myView, 0.005))
+    updateView();
+  if (myModelLoader.NbDisplayed() != aNbDisplayedOld)
+    mySharedViewer->InvalidateViews(myView);
+
+  // flush pending input events and redraw the viewer;
+  // OCCT swaps buffers of native window on its own, so that composition is a part of this phase
+  {
+    OcctFrameTimings::PhaseSentry aPhase(myFrameTimings, OcctFramePhase_FlushView);
+    Handle(V3d_View) aView = !myFocusView.IsNull() ? myFocusView : myView;
+    aView->InvalidateImmediate();
+    if (!myIsThreaded)
+    {
+      // in threaded mode, passed by GUI thread within requestOcctFrame()
+      myInputAccum.Flush(*this);
+      if (myInputPredictor.Apply(*this, myFrameScheduler.NextPresentationTime() - myFrameScheduler.CurrentTime()))
+        updateView(); // settle extrapolated pointer by the next frame
     }
+
+    AIS_ViewController::FlushViewEvents(myContext, aView, true);
+  }
+}
+
+// ================================================================
+// Function : requestOcctFrame
+// ================================================================
+void OcctQWidgetViewer::requestOcctFrame()
+{
+  if (!myRenderThread.isRunning())
+    return;
+
+  myFrameScheduler.FrameStarted();
+  {
+    // pass input events accumulated by GUI thread to AIS_ViewController;
+    // OCCT thread takes them within flushBuffers()
+    std::lock_guard<std::mutex> anInputLock(myInputMutex);
+    myInputAccum.Flush(*this);
+    if (myInputPredictor.Apply(*this, myFrameScheduler.NextPresentationTime() - myFrameScheduler.CurrentTime()))
+      updateView(); // settle extrapolated pointer by the next frame
   }
 
-  // flush pending input events and redraw the viewer
-  Handle(V3d_View) aView = !myFocusView.IsNull() ? myFocusView : myView;
-  aView->InvalidateImmediate();
-  AIS_ViewController::FlushViewEvents(myContext, aView, true);
+  OcctQtRenderThread::FrameRequest aRequest;
+  aRequest.Size             = viewSize();
+  aRequest.DevicePixelRatio = devicePixelRatioF();
+  aRequest.PresentTime      = myFrameScheduler.NextPresentationTime();
+  aRequest.NativeWindow     = (Aspect_Drawable)winId();
+  myRenderThread.RequestFrame(aRequest);
+}
+
+// ================================================================
+// Function : handleFramePresented
+// ================================================================
+void OcctQWidgetViewer::handleFramePresented()
+{
+  myFrameScheduler.FramePresented();
+}
+
+// ================================================================
+// Function : RenderFrame
+// ================================================================
+void OcctQWidgetViewer::RenderFrame(const OcctQtRenderThread::FrameRequest& theRequest)
+{
+  if (theRequest.Size.x() <= 0
+   || theRequest.Size.y() <= 0)
+  {
+    // frame scheduler waits for presentation of the requested frame before requesting another one
+    QMetaObject::invokeMethod(this, "handleFramePresented", Qt::QueuedConnection);
+    return;
+  }
+
+  myFramePresentTime = theRequest.PresentTime;
+  myFrameTimings.BeginFrame();
+
+  prepareWindow(theRequest.Size, theRequest.DevicePixelRatio, theRequest.NativeWindow);
+  if (myToFetchGlInfo.exchange(false))
+    myGlInfo.UpdateComplete(myView);
+
+  redrawView();
+  myFrameTimings.EndFrame();
+
+  // buffers have been swapped by OCCT - blocking this thread (not GUI one) on vsync
+  myFrameTimings.FramePresented();
+
+  // the next frame is requested only after this one - all flushed input events are reflected by it
+  myInputLatency.FramePresented();
+  QMetaObject::invokeMethod(this, "handleFramePresented", Qt::QueuedConnection);
+}
+
+// ================================================================
+// Function : ReleaseGl
+// ================================================================
+void OcctQWidgetViewer::ReleaseGl()
+{
+  // hold on X11 display connection till releasing OpenGL context
+  Handle(Aspect_DisplayConnection) aDisp = myViewer->Driver()->GetDisplayConnection();
+
+  // release OCCT view within the thread owning its OpenGL context
+  myResolutionScaler.Release(myView);
+  mySharedViewer->RemoveView(myView);
+  myContext.Nullify();
+  myView.Nullify();
+  myViewer.Nullify();
+  mySharedViewer.Nullify();
+  aDisp.Nullify();
+}
+
+// ================================================================
+// Function : flushBuffers
+// ================================================================
+void OcctQWidgetViewer::flushBuffers(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)&               theView)
+{
+  std::lock_guard<std::mutex> anInputLock(myInputMutex);
+  AIS_ViewController::flushBuffers(theCtx, theView);
 }
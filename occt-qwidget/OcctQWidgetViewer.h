@@ -3,8 +3,23 @@
 #ifndef _OcctQWidgetViewer_HeaderFile
 #define _OcctQWidgetViewer_HeaderFile
 
+#include "../occt-qt-tools/OcctFrameTimings.h"
+#include "../occt-qt-tools/OcctGlInfo.h"
+#include "../occt-qt-tools/OcctHoverThrottle.h"
+#include "../occt-qt-tools/OcctInputLatency.h"
+#include "../occt-qt-tools/OcctInputPredictor.h"
+#include "../occt-qt-tools/OcctInteractionLod.h"
+#include "../occt-qt-tools/OcctQtFrameScheduler.h"
+#include "../occt-qt-tools/OcctQtInputAccumulator.h"
+#include "../occt-qt-tools/OcctQtModelLoader.h"
+#include "../occt-qt-tools/OcctQtRenderThread.h"
+#include "../occt-qt-tools/OcctResolutionScaler.h"
+#include "../occt-qt-tools/OcctSharedViewer.h"
+#include "../occt-qt-tools/OcctViewCommandQueue.h"
+
 #include <Standard_WarningsDisable.hxx>
 #include <QWidget>
+#include <QTimer>
 #include <Standard_WarningsRestore.hxx>
 
 #include <AIS_InteractiveContext.hxx>
@@ -12,6 +27,9 @@
 #include <V3d_View.hxx>
 #include <Standard_Version.hxx>
 
+#include <atomic>
+#include <mutex>
+
 class AIS_ViewCube;
 
 //! OpenGL Qt widget holding OCCT 3D View.
@@ -22,13 +40,25 @@ class AIS_ViewCube;
 //! Inheritance from AIS_ViewController is used to translate
 //! user input events (mouse, keyboard, window resize, etc.)
 //! to 3D Viewer (panning, rotation, zooming, etc.).
-class OcctQWidgetViewer : public QWidget, public AIS_ViewController
+//!
+//! As Qt is not involved into OpenGL rendering here, OCCT might render on a dedicated thread (SetThreadedRendering()),
+//! which owns OpenGL context, swaps buffers on its own and runs its own frame loop,
+//! while GUI thread only passes input events and view commands (PushViewCommand()) to it once per frame.
+class OcctQWidgetViewer : public QWidget, public AIS_ViewController, private OcctQtRenderThread::Renderer
 {
   Q_OBJECT
 public:
-  //! Main constructor.
+  //! Main constructor creating own viewer.
   OcctQWidgetViewer(QWidget* theParent = nullptr);
 
+  //! Constructor creating a new view of the viewer shared with other widgets.
+  //! @param[in] theSharedViewer  viewer created by CreateSharedViewer() or taken from another widget
+  //! @param[in] theParent        parent widget
+  OcctQWidgetViewer(const Handle(OcctSharedViewer)& theSharedViewer, QWidget* theParent = nullptr);
+
+  //! Create graphic driver and viewer to be shared by several widgets.
+  static Handle(OcctSharedViewer) CreateSharedViewer();
+
   //! Destructor.
   virtual ~OcctQWidgetViewer();
 
@@ -41,8 +71,51 @@ public:
   //! Return AIS context.
   const Handle(AIS_InteractiveContext)& Context() const { return myContext; }
 
-  //! Return OpenGL info.
-  const QString& getGlInfo() const { return myGlInfo; }
+  //! Return viewer shared with other widgets.
+  const Handle(OcctSharedViewer)& SharedViewer() const { return mySharedViewer; }
+
+  //! Return TRUE if OCCT renders on a dedicated thread.
+  bool IsThreadedRendering() const { return myIsThreaded; }
+
+  //! Enable rendering of OCCT on a dedicated thread; should be called before showing the widget.
+  //! Not supported for a viewer shared with other widgets.
+  //! @return FALSE if option cannot be changed
+  bool SetThreadedRendering(bool theToEnable);
+
+  //! Queue command modifying the view or the scene, to be executed right before the next redraw
+  //! (by OCCT thread in threaded mode, or within paintEvent() otherwise).
+  void PushViewCommand(const OcctViewCommandQueue::Command& theCommand);
+
+  //! Return OpenGL info; complete info (including extensions) is fetched on first request.
+  QString getGlInfo();
+
+  //! Return frame scheduler.
+  OcctQtFrameScheduler& FrameScheduler() { return myFrameScheduler; }
+
+  //! Return model loader.
+  OcctQtModelLoader& ModelLoader() { return myModelLoader; }
+
+  //! Return interaction level-of-detail controller.
+  OcctInteractionLod& InteractionLod() { return myInteractionLod; }
+
+  //! Return dynamic highlighting throttle.
+  OcctHoverThrottle& HoverThrottle() { return myHoverThrottle; }
+
+  //! Return dynamic resolution controller.
+  OcctResolutionScaler& ResolutionScaler() { return myResolutionScaler; }
+
+  //! Return per-phase frame timings.
+  const OcctFrameTimings& FrameTimings() const { return myFrameTimings; }
+
+  //! Return input-to-photon latency histogram of mouse and touch events.
+  OcctInputLatency& InputLatency() { return myInputLatency; }
+
+  //! Return predictor extrapolating dragged pointers to expected presentation time.
+  OcctInputPredictor& InputPredictor() { return myInputPredictor; }
+
+  //! Start asynchronous loading of STEP/BREP file replacing displayed shapes;
+  //! parts are displayed progressively as soon as they are meshed.
+  bool OpenModel(const QString& theFilePath);
 
   //! Minimal widget size.
   virtual QSize minimumSizeHint() const override { return QSize(200, 200); }
@@ -57,11 +130,19 @@ public:
                                 const Handle(V3d_View)&,
                                 const Handle(V3d_View)& theNewView) override;
 #endif
+
+  //! Propagate selection change to other views of shared viewer.
+  virtual void OnSelectionChanged(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView) override;
+
 protected: // drawing events
-  //! Initial OpenGL setup.
-  void initializeGL();
+  //! Initial OpenGL setup for native window.
+  void initializeGL(const Graphic3d_Vec2i& theSize, double theDevPixelRatio, Aspect_Drawable theNativeWin);
+
+  //! (Re)initialize OpenGL on window handle or device pixel ratio change, or resize the view.
+  void prepareWindow(const Graphic3d_Vec2i& theSize, double theDevPixelRatio, Aspect_Drawable theNativeWin);
 
-  //! Redraw the widget (3D Viewer).
+  //! Redraw the widget (3D Viewer) or wake up OCCT thread.
   virtual void paintEvent(QPaintEvent* theEvent) override;
 
   //! Resize the widget (3D Viewer).
@@ -79,17 +160,51 @@ protected: // user input events
   virtual void mouseMoveEvent(QMouseEvent* theEvent) override;
   virtual void wheelEvent(QWheelEvent* theEvent) override;
 
+private slots:
+  //! Request the new frame from OCCT thread (GUI thread).
+  void requestOcctFrame();
+
+  //! Handle frame presented by OCCT thread (GUI thread).
+  void handleFramePresented();
+
+private: //! @name OcctQtRenderThread::Renderer interface (OCCT thread)
+  //! Redraw the view and swap buffers.
+  virtual void RenderFrame(const OcctQtRenderThread::FrameRequest& theRequest) override;
+
+  //! Nothing to poll - frame is presented by buffer swap.
+  virtual bool PollFrames() override { return false; }
+
+  //! Release OCCT view.
+  virtual void ReleaseGl() override;
+
 private:
-  //! Dump OpenGL info.
-  void dumpGlInfo(bool theIsBasic, bool theToPrint);
+  //! Fetch and print basic OpenGL info of new OpenGL context.
+  void dumpGlInfo();
 
-  //! Request widget paintGL() event.
+  //! Request widget paintEvent() event (or OCCT frame) through frame scheduler;
+  //! might be called from OCCT thread.
   void updateView();
 
+  //! Return view size in pixels.
+  Graphic3d_Vec2i viewSize() const;
+
+  //! Execute queued commands, display loaded parts, flush input events and redraw the view;
+  //! common part of paintEvent() and OCCT thread frame.
+  void redrawView();
+
+  //! Lock input buffers while they are flushed by OCCT thread.
+  virtual void flushBuffers(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
+
   //! Handle view redraw.
   virtual void handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView) override;
 
+  //! Perform dynamic highlighting unless skipped or postponed by hover throttle.
+  virtual void contextLazyMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theView,
+                                 const Graphic3d_Vec2i& thePnt) override;
+
 private:
+  Handle(OcctSharedViewer)       mySharedViewer;
   Handle(V3d_Viewer)             myViewer;
   Handle(V3d_View)               myView;
   Handle(AIS_InteractiveContext) myContext;
@@ -97,9 +212,27 @@ private:
 
   Handle(V3d_View) myFocusView;
 
-  QString myGlInfo;
-  bool    myIsCoreProfile = true;
-  bool    myHasTouchInput = false;
+  OcctQtInputAccumulator myInputAccum;
+  OcctQtFrameScheduler   myFrameScheduler;
+  OcctQtModelLoader      myModelLoader;
+  OcctInteractionLod     myInteractionLod;
+  OcctHoverThrottle      myHoverThrottle;
+  OcctResolutionScaler   myResolutionScaler;
+  OcctFrameTimings       myFrameTimings;
+  OcctInputLatency       myInputLatency;
+  OcctInputPredictor     myInputPredictor;
+  QTimer                 myLodTimer; //!< timer redrawing the view to restore full quality or to perform postponed highlighting
+  OcctViewCommandQueue   myViewCommands; //!< commands passed from GUI thread to redraw
+  std::mutex             myInputMutex;   //!< lock for AIS_ViewController input buffers
+
+  OcctQtRenderThread myRenderThread;            //!< OCCT thread (threaded mode)
+  double             myFramePresentTime = 0.0;  //!< expected presentation time of frame being rendered (OCCT thread)
+  bool               myIsThreaded       = false;
+
+  OcctGlInfo        myGlInfo;
+  std::atomic<bool> myToFetchGlInfo { false }; //!< complete OpenGL info has been requested by GUI thread (threaded mode)
+  bool              myIsCoreProfile = true;
+  bool              myHasTouchInput = false;
 };
 
 #endif // _OcctQWidgetViewer_HeaderFile